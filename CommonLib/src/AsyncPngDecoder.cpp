@@ -0,0 +1,263 @@
+#include "AsyncPngDecoder.h"
+#include "CommonUtility.h"
+#include <fstream>
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+DecodedImage::DecodedImage(int p_id, const string& p_path)
+{
+	id			= p_id;
+	path		= p_path;
+	data		= NULL;
+	fromCache	= false;
+	width		= 0;
+	height		= 0;
+	error		= 0;
+	decodeTime	= 0;
+}
+
+DecodedImage::~DecodedImage()
+{
+	RawTextureCache::close(&mapping);
+}
+
+AsyncPngDecoder::AsyncPngDecoder(int p_workerCount)
+{
+	m_busyWorkers	= 0;
+	m_stopping		= false;
+
+#ifdef _WIN32
+	InitializeCriticalSection(&m_lock);
+	InitializeConditionVariable(&m_workAvailable);
+	InitializeConditionVariable(&m_workDone);
+	for (int i = 0; i < p_workerCount; i++)
+	{
+		HANDLE thread = CreateThread(NULL, 0, workerMain, this, 0, NULL);
+		if (thread)
+			m_threads.push_back(thread);
+	}
+#else
+	pthread_mutex_init(&m_lock, NULL);
+	pthread_cond_init(&m_workAvailable, NULL);
+	pthread_cond_init(&m_workDone, NULL);
+	for (int i = 0; i < p_workerCount; i++)
+	{
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, workerMain, this) == 0)
+			m_threads.push_back(thread);
+	}
+#endif
+}
+
+AsyncPngDecoder::~AsyncPngDecoder()
+{
+	lock();
+	m_stopping = true;
+	unlock();
+
+#ifdef _WIN32
+	WakeAllConditionVariable(&m_workAvailable);
+	for (unsigned int i = 0; i < m_threads.size(); i++)
+	{
+		WaitForSingleObject(m_threads[i], INFINITE);
+		CloseHandle(m_threads[i]);
+	}
+	DeleteCriticalSection(&m_lock);
+#else
+	pthread_cond_broadcast(&m_workAvailable);
+	for (unsigned int i = 0; i < m_threads.size(); i++)
+		pthread_join(m_threads[i], NULL);
+	pthread_cond_destroy(&m_workDone);
+	pthread_cond_destroy(&m_workAvailable);
+	pthread_mutex_destroy(&m_lock);
+#endif
+
+	for (unsigned int i = 0; i < m_requests.size(); i++)
+		delete m_requests[i];
+	for (unsigned int i = 0; i < m_finished.size(); i++)
+		delete m_finished[i];
+}
+
+void AsyncPngDecoder::lock()
+{
+#ifdef _WIN32
+	EnterCriticalSection(&m_lock);
+#else
+	pthread_mutex_lock(&m_lock);
+#endif
+}
+
+void AsyncPngDecoder::unlock()
+{
+#ifdef _WIN32
+	LeaveCriticalSection(&m_lock);
+#else
+	pthread_mutex_unlock(&m_lock);
+#endif
+}
+
+double AsyncPngDecoder::getTime()
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / frequency.QuadPart;
+#else
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec / 1000000000.0;
+#endif
+}
+
+#ifdef _WIN32
+DWORD WINAPI AsyncPngDecoder::workerMain(LPVOID p_decoder)
+{
+	((AsyncPngDecoder*)p_decoder)->work();
+	return 0;
+}
+#else
+void* AsyncPngDecoder::workerMain(void* p_decoder)
+{
+	((AsyncPngDecoder*)p_decoder)->work();
+	return NULL;
+}
+#endif
+
+void AsyncPngDecoder::work()
+{
+	lock();
+	while (true)
+	{
+		while (m_requests.empty() && !m_stopping)
+		{
+#ifdef _WIN32
+			SleepConditionVariableCS(&m_workAvailable, &m_lock, INFINITE);
+#else
+			pthread_cond_wait(&m_workAvailable, &m_lock);
+#endif
+		}
+		if (m_stopping)
+			break;
+
+		DecodedImage* image = m_requests.front();
+		m_requests.pop_front();
+		m_busyWorkers++;
+		unlock();
+
+		// The file is read and decoded without holding the lock
+		decode(image);
+
+		lock();
+		m_finished.push_back(image);
+		m_busyWorkers--;
+#ifdef _WIN32
+		WakeAllConditionVariable(&m_workDone);
+#else
+		pthread_cond_broadcast(&m_workDone);
+#endif
+	}
+	unlock();
+}
+
+void AsyncPngDecoder::decode(DecodedImage* p_image)
+{
+	double start = getTime();
+	if (RawTextureCache::open(p_image->path, &p_image->mapping) == GAME_OK)
+	{
+		p_image->data		= p_image->mapping.pixels;
+		p_image->width		= p_image->mapping.width;
+		p_image->height		= p_image->mapping.height;
+		p_image->fromCache	= true;
+	}
+	else
+	{
+		vector<unsigned char> rawImage;
+		lodepng::load_file(rawImage, p_image->path);
+		lodepng::State state;
+		p_image->error = lodepng::decode(p_image->pixels, p_image->width,
+			p_image->height, state, rawImage);
+		if (p_image->error == 0)
+		{
+			p_image->data = &p_image->pixels[0];
+			RawTextureCache::store(p_image->path, p_image->data,
+				p_image->width, p_image->height);
+		}
+	}
+	p_image->decodeTime = (float)(getTime() - start);
+}
+
+void AsyncPngDecoder::request(int p_id, const string& p_path)
+{
+	DecodedImage* image = new DecodedImage(p_id, p_path);
+
+	// Decoded right away if no worker could be started
+	if (m_threads.empty())
+	{
+		decode(image);
+		m_finished.push_back(image);
+		return;
+	}
+
+	lock();
+	m_requests.push_back(image);
+	unlock();
+
+#ifdef _WIN32
+	WakeConditionVariable(&m_workAvailable);
+#else
+	pthread_cond_signal(&m_workAvailable);
+#endif
+}
+
+int AsyncPngDecoder::fetchFinished(vector<DecodedImage*>* out_images)
+{
+	lock();
+	int count = (int)m_finished.size();
+	out_images->insert(out_images->end(), m_finished.begin(), m_finished.end());
+	m_finished.clear();
+	unlock();
+	return count;
+}
+
+void AsyncPngDecoder::waitForAll()
+{
+	lock();
+	while (!m_requests.empty() || m_busyWorkers > 0)
+	{
+#ifdef _WIN32
+		SleepConditionVariableCS(&m_workDone, &m_lock, INFINITE);
+#else
+		pthread_cond_wait(&m_workDone, &m_lock);
+#endif
+	}
+	unlock();
+}
+
+int AsyncPngDecoder::getPendingCount()
+{
+	lock();
+	int count = (int)m_requests.size() + m_busyWorkers;
+	unlock();
+	return count;
+}
+
+int AsyncPngDecoder::readSize(const string& p_path, int* out_width,
+	int* out_height)
+{
+	// The size is in the IHDR chunk right after the signature
+	unsigned char header[33];
+	ifstream file(p_path.c_str(), ios::in | ios::binary);
+	if (!file.read((char*)header, sizeof(header)))
+		return GAME_FAIL;
+
+	unsigned int width = 0, height = 0;
+	lodepng::State state;
+	if (lodepng_inspect(&width, &height, &state, header, sizeof(header)) != 0)
+		return GAME_FAIL;
+
+	*out_width	= (int)width;
+	*out_height	= (int)height;
+	return GAME_OK;
+}
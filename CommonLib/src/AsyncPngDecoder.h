@@ -0,0 +1,92 @@
+#ifndef ASYNCPNGDECODER_H
+#define ASYNCPNGDECODER_H
+
+#include "LodePNG.h"
+#include "RawTextureCache.h"
+#include <vector>
+#include <deque>
+#include <string>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace std;
+
+// A PNG decoded to RGBA by the worker threads. The pixels are either
+// mapped from the raw texture cache or decoded into pixels.
+struct DecodedImage
+{
+	int						id;
+	string					path;
+	const unsigned char*	data;		// width * height RGBA pixels
+	vector<unsigned char>	pixels;
+	MappedTexture			mapping;
+	bool					fromCache;
+	unsigned int			width;
+	unsigned int			height;
+	unsigned int			error;		// LodePNG error code, 0 on success
+	float					decodeTime;	// Seconds spent loading and decoding
+
+	DecodedImage(int p_id, const string& p_path);
+	~DecodedImage();
+};
+
+// Loads and decodes PNG files on worker threads. Requests are handled in
+// the order they were made, finished images are collected by the owner,
+// typically once per frame.
+class AsyncPngDecoder
+{
+private:
+	deque<DecodedImage*>	m_requests;
+	vector<DecodedImage*>	m_finished;
+	int						m_busyWorkers;
+	bool					m_stopping;
+
+#ifdef _WIN32
+	vector<HANDLE>			m_threads;
+	CRITICAL_SECTION		m_lock;
+	CONDITION_VARIABLE		m_workAvailable;
+	CONDITION_VARIABLE		m_workDone;
+	static DWORD WINAPI		workerMain(LPVOID p_decoder);
+#else
+	vector<pthread_t>		m_threads;
+	pthread_mutex_t			m_lock;
+	pthread_cond_t			m_workAvailable;
+	pthread_cond_t			m_workDone;
+	static void*			workerMain(void* p_decoder);
+#endif
+
+private:
+	void	lock();
+	void	unlock();
+	void	work();
+
+public:
+			AsyncPngDecoder(int p_workerCount = 2);
+	virtual	~AsyncPngDecoder();
+
+	void	request(int p_id, const string& p_path);
+
+	// Moves the finished images to out_images, the caller takes
+	// ownership. Returns the number of images moved.
+	int		fetchFinished(vector<DecodedImage*>* out_images);
+
+	// Blocks until every request has been decoded
+	void	waitForAll();
+
+	// Requests that are queued or being decoded
+	int		getPendingCount();
+
+	// Reads the size from the PNG header without decoding the image
+	static int	readSize(const string& p_path, int* out_width, int* out_height);
+
+	// Loads the image on the calling thread, from the raw texture cache
+	// if it has a valid entry. Decoded images are added to the cache.
+	static void		decode(DecodedImage* p_image);
+	static double	getTime();
+};
+
+#endif
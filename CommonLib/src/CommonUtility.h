@@ -10,6 +10,16 @@ struct SpriteVertex
 	SpriteVertex(float p_x, float p_y, float p_z, float p_s, float p_t);
 };
 
+// Per-instance data used by batched sprite rendering. The layout matches
+// the per-instance attributes read by the sprite vertex shader.
+struct SpriteInstance
+{
+	float centerPosition[4];
+	float textureRect[4];	// Normalized texture coordinates
+	float colorOverlay[4];
+	float halfScale[2];
+};
+
 
 enum 
 {
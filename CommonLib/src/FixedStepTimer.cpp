@@ -0,0 +1,31 @@
+#include "FixedStepTimer.h"
+
+FixedStepTimer::FixedStepTimer(double p_step): Timer()
+{
+	m_step = p_step;
+}
+void FixedStepTimer::start()
+{
+	mRunning = true;
+}
+void FixedStepTimer::stop()
+{
+	mRunning = false;
+	mElapsedTime = 0;
+}
+void FixedStepTimer::pause()
+{
+	mRunning = false;
+}
+void FixedStepTimer::tick()
+{
+	if (mRunning)
+	{
+		mDeltaTime = m_step;
+		mElapsedTime += mDeltaTime;
+	}
+}
+Timer* FixedStepTimer::newInstance()
+{
+	return new FixedStepTimer(m_step);
+}
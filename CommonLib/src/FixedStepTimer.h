@@ -0,0 +1,21 @@
+#ifndef FIXEDSTEPTIMER_H
+#define FIXEDSTEPTIMER_H
+
+#include "Timer.h"
+
+// Timer that advances by a fixed step on every tick instead of reading a
+// clock. Makes headless runs deterministic however fast they execute.
+class FixedStepTimer: public Timer
+{
+private:
+	double m_step;
+public:
+					FixedStepTimer(double p_step);
+	void			start();
+	void			stop();
+	void			tick();
+	void			pause();
+	Timer*			newInstance();
+};
+
+#endif
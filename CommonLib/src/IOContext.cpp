@@ -12,6 +12,10 @@ IOContext::IOContext( int p_screenWidth, int p_screenHeight, bool p_windowed )
 	m_screenWidth			= p_screenWidth;
 	m_screenHeight			= p_screenHeight;
 	m_windowed				= p_windowed;
+	m_drawCalls				= 0;
+	m_textureBinds			= 0;
+	m_sceneBlackAndWhite	= 0;
+	m_sceneFadeToBlack		= 0;
 }
 IOContext::~IOContext()
 {
@@ -26,6 +30,71 @@ void IOContext::setRunning(bool p_running)
 	m_running = p_running;
 }
 
+int IOContext::getDrawCallCount() const
+{
+	return m_drawCalls;
+}
+
+int IOContext::getTextureBindCount() const
+{
+	return m_textureBinds;
+}
+
+void IOContext::setSceneBlackAndWhite(float p_fraction)
+{
+	m_sceneBlackAndWhite = p_fraction;
+}
+void IOContext::setSceneFadeToBlack(float p_fraction)
+{
+	m_sceneFadeToBlack = p_fraction;
+}
+float IOContext::getSceneBlackAndWhite() const
+{
+	return m_sceneBlackAndWhite;
+}
+float IOContext::getSceneFadeToBlack() const
+{
+	return m_sceneFadeToBlack;
+}
+bool IOContext::hasSceneEffects() const
+{
+	return m_sceneBlackAndWhite > 0 || m_sceneFadeToBlack > 0;
+}
+
+int IOContext::drawInstances(SpriteInfo* p_spriteInfo)
+{
+	TransformInfo transform = p_spriteInfo->transformInfo;
+	for (int i = 0; i < p_spriteInfo->instanceCount; i++)
+	{
+		p_spriteInfo->transformInfo = p_spriteInfo->instances[i];
+		drawSprite(p_spriteInfo);
+	}
+	p_spriteInfo->transformInfo = transform;
+	return GAME_OK;
+}
+
+int IOContext::buildStaticLayer(const vector<SpriteInfo*>& p_spriteInfos)
+{
+	m_staticSpriteInfos = p_spriteInfos;
+	return GAME_OK;
+}
+int IOContext::drawStaticLayer()
+{
+	for (unsigned int i = 0; i < m_staticSpriteInfos.size(); i++)
+		drawSprite(m_staticSpriteInfos[i]);
+	return GAME_OK;
+}
+
+int IOContext::getTextureSortId(SpriteInfo* p_spriteInfo)
+{
+	return p_spriteInfo->textureIndex;
+}
+
+int IOContext::waitForPendingTextures()
+{
+	return GAME_OK;
+}
+
 const InputInfo& IOContext::getInput()
 {
 	return m_input;
@@ -4,17 +4,25 @@
 #include "CommonUtility.h"
 #include "InputInfo.h"
 #include "SpriteInfo.h"
+#include <vector>
+
+using namespace std;
 
 class IOContext
 {
 private:
-	bool m_running;	
+	bool				m_running;	
+	vector<SpriteInfo*>	m_staticSpriteInfos;
+	float				m_sceneBlackAndWhite;
+	float				m_sceneFadeToBlack;
 protected:
 	InputInfo	m_input;
 	int			m_screenWidth;
 	int			m_screenHeight;
 	bool		m_windowed;
 	bool		m_initialized;
+	int			m_drawCalls;	// Reset by beginDraw, counted by the backend
+	int			m_textureBinds;
 public:
 					IOContext( int p_screenWidth, int p_screenHeight, bool p_windowed );
 	virtual			~IOContext();
@@ -29,12 +37,42 @@ public:
 	virtual int		drawSprite(SpriteInfo* p_spriteInfo) = 0;
 	virtual int		endDraw() = 0;
 
+	// Draws a sprite at each of its instance transforms. The default
+	// implementation draws them one by one.
+	virtual int		drawInstances(SpriteInfo* p_spriteInfo);
+
+	// Sprites that rarely change, like the tile layer, can be handed over
+	// once and are drawn before the other sprites until the layer is built
+	// again. The default implementation draws them one by one.
+	virtual int		buildStaticLayer(const vector<SpriteInfo*>& p_spriteInfos);
+	virtual int		drawStaticLayer();
+
+	// Identifies what the sprite will be drawn with, so that sprites
+	// sharing it can be drawn next to each other. Defaults to the texture
+	// index.
+	virtual int		getTextureSortId(SpriteInfo* p_spriteInfo);
+
+	// Contexts that load textures in the background block here until all
+	// requested textures are ready, e.g. behind a loading screen.
+	virtual int		waitForPendingTextures();
+
 	virtual int		getScreenWidth() const = 0;
 	virtual int		getScreenHeight() const = 0;
 	
 	bool			isRunning();
 	void			setRunning(bool p_running);
 
+	int				getDrawCallCount() const;
+	int				getTextureBindCount() const;
+
+	// Scene-wide effects, applied to the whole frame once the sprites
+	// have been drawn.
+	void			setSceneBlackAndWhite(float p_fraction);
+	void			setSceneFadeToBlack(float p_fraction);
+	float			getSceneBlackAndWhite() const;
+	float			getSceneFadeToBlack() const;
+	bool			hasSceneEffects() const;
+
 	const			InputInfo& getInput();
 	virtual void	setWindowText(string p_text) = 0;
 };
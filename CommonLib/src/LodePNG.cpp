@@ -4037,6 +4037,638 @@ static unsigned postProcessScanlines(unsigned char* out, unsigned char* in,
   return 0;
 }
 
+#ifdef LODEPNG_COMPILE_ZLIB
+
+/* ////////////////////////////////////////////////////////////////////////// */
+/* / Fast path for 8-bit RGBA non-interlaced images                         / */
+/* ////////////////////////////////////////////////////////////////////////// */
+
+/*
+Not part of upstream LodePNG. The common case of 8-bit RGBA without interlacing
+is decoded with a table driven inflate and SIMD unfilter kernels. Anything else,
+and any error on the way, is left to the regular decoder so results and error
+codes are unchanged. Turn it off with LodePNGDecoderSettings::fast_decode.
+*/
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LODEPNG_FAST_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER) && _MSC_VER >= 1700
+#define LODEPNG_FAST_AVX2
+#define LODEPNG_TARGET_AVX2
+#include <immintrin.h>
+#include <intrin.h>
+#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#define LODEPNG_FAST_AVX2
+#define LODEPNG_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#endif
+
+/*first level of the lookup tables, longer codes continue in a second level table*/
+#define FAST_LL_BITS 10
+#define FAST_D_BITS 8
+#define FAST_CL_BITS 7
+#define FAST_LL_SIZE ((1 << FAST_LL_BITS) + NUM_DEFLATE_CODE_SYMBOLS * (1 << (15 - FAST_LL_BITS)))
+#define FAST_D_SIZE ((1 << FAST_D_BITS) + NUM_DISTANCE_SYMBOLS * (1 << (15 - FAST_D_BITS)))
+/*table entries: bits 0-3 code length, bits 4-19 symbol. With FAST_LINK set the entry
+points to a second level table instead: bits 0-3 its index bits, bits 4-19 its offset*/
+#define FAST_LINK 0x80000000u
+
+typedef struct FastBits
+{
+  const unsigned char* in;
+  size_t insize;
+  size_t pos; /*next byte to load into buf, may run past insize (reads as zero)*/
+  unsigned long long buf;
+  unsigned count; /*bits available in buf*/
+} FastBits;
+
+static void fastBitsRefill(FastBits* bits)
+{
+  if(bits->pos + 8 <= bits->insize)
+  {
+    /*load 8 bytes at once and keep as many whole bytes as fit*/
+    const unsigned char* p = &bits->in[bits->pos];
+    unsigned long long word = (unsigned long long)p[0] | ((unsigned long long)p[1] << 8)
+                            | ((unsigned long long)p[2] << 16) | ((unsigned long long)p[3] << 24)
+                            | ((unsigned long long)p[4] << 32) | ((unsigned long long)p[5] << 40)
+                            | ((unsigned long long)p[6] << 48) | ((unsigned long long)p[7] << 56);
+    bits->buf |= word << bits->count;
+    bits->pos += (63 - bits->count) >> 3;
+    bits->count |= 56;
+  }
+  else
+  {
+    while(bits->count <= 56)
+    {
+      unsigned long long byte = bits->pos < bits->insize ? bits->in[bits->pos] : 0;
+      bits->buf |= byte << bits->count;
+      bits->pos++;
+      bits->count += 8;
+    }
+  }
+}
+
+static unsigned fastBitsPeek(const FastBits* bits, unsigned n)
+{
+  return (unsigned)(bits->buf & ((1ull << n) - 1));
+}
+
+static void fastBitsConsume(FastBits* bits, unsigned n)
+{
+  bits->buf >>= n;
+  bits->count -= n;
+}
+
+/*whether more bits were used than the input has*/
+static int fastBitsOverrun(const FastBits* bits)
+{
+  return bits->pos * 8 - bits->count > bits->insize * 8;
+}
+
+/*returns 0 on success, 1 if the code lengths don't form a valid code*/
+static unsigned fastHuffmanBuild(unsigned* table, size_t tablesize, unsigned rootbits,
+                                 const unsigned* lengths, unsigned numcodes)
+{
+  unsigned count[16], next[16], maxsub[1 << FAST_LL_BITS];
+  unsigned i, bits, code = 0;
+  int left = 1;
+  size_t offset = (size_t)1 << rootbits;
+
+  for(i = 0; i < 16; i++) count[i] = 0;
+  for(i = 0; i < numcodes; i++)
+  {
+    if(lengths[i] > 15) return 1;
+    count[lengths[i]]++;
+  }
+  count[0] = 0;
+  for(bits = 1; bits < 16; bits++)
+  {
+    left = (left << 1) - (int)count[bits];
+    if(left < 0) return 1; /*over-subscribed, incomplete codes are allowed*/
+  }
+  next[0] = 0;
+  for(bits = 1; bits < 16; bits++)
+  {
+    code = (code + count[bits - 1]) << 1;
+    next[bits] = code;
+  }
+
+  for(i = 0; i < ((unsigned)1 << rootbits); i++)
+  {
+    table[i] = 0;
+    maxsub[i] = 0;
+  }
+
+  /*the codes are stored msb first but read lsb first, so the tables are indexed by
+  the reversed code. First pass: find how many bits each second level table needs*/
+  {
+    unsigned nextcopy[16];
+    for(bits = 0; bits < 16; bits++) nextcopy[bits] = next[bits];
+    for(i = 0; i < numcodes; i++)
+    {
+      unsigned len = lengths[i], c, rev = 0, b, prefix;
+      if(len == 0) continue;
+      c = nextcopy[len]++;
+      if(len <= rootbits) continue;
+      for(b = 0; b < len; b++) rev |= ((c >> b) & 1) << (len - 1 - b);
+      prefix = rev & ((1u << rootbits) - 1);
+      if(len - rootbits > maxsub[prefix]) maxsub[prefix] = len - rootbits;
+    }
+  }
+  for(i = 0; i < ((unsigned)1 << rootbits); i++)
+  {
+    size_t j, subsize;
+    if(!maxsub[i]) continue;
+    subsize = (size_t)1 << maxsub[i];
+    if(offset + subsize > tablesize) return 1;
+    table[i] = FAST_LINK | ((unsigned)offset << 4) | maxsub[i];
+    for(j = 0; j < subsize; j++) table[offset + j] = 0;
+    offset += subsize;
+  }
+
+  /*second pass: fill in the symbols*/
+  for(i = 0; i < numcodes; i++)
+  {
+    unsigned len = lengths[i], c, rev = 0, b, entry;
+    if(len == 0) continue;
+    c = next[len]++;
+    for(b = 0; b < len; b++) rev |= ((c >> b) & 1) << (len - 1 - b);
+    entry = (i << 4) | len;
+    if(len <= rootbits)
+    {
+      for(b = rev; b < ((unsigned)1 << rootbits); b += 1u << len) table[b] = entry;
+    }
+    else
+    {
+      unsigned link = table[rev & ((1u << rootbits) - 1)];
+      unsigned subbits = link & 15;
+      unsigned* sub = &table[(link >> 4) & 0xffff];
+      for(b = rev >> rootbits; b < (1u << subbits); b += 1u << (len - rootbits)) sub[b] = entry;
+    }
+  }
+  return 0;
+}
+
+/*returns the symbol, or (unsigned)(-1) for a code that isn't in the table*/
+static unsigned fastDecodeSymbol(FastBits* bits, const unsigned* table, unsigned rootbits)
+{
+  unsigned entry = table[bits->buf & ((1u << rootbits) - 1)];
+  if(entry & FAST_LINK)
+  {
+    unsigned sub = (unsigned)(bits->buf >> rootbits) & ((1u << (entry & 15)) - 1);
+    entry = table[((entry >> 4) & 0xffff) + sub];
+  }
+  if(!(entry & 15)) return (unsigned)(-1);
+  fastBitsConsume(bits, entry & 15);
+  return (entry >> 4) & 0xffff;
+}
+
+static unsigned fastReadDynamicTrees(FastBits* bits, unsigned* table_ll, unsigned* table_d)
+{
+  unsigned lengths_cl[NUM_CODE_LENGTH_CODES];
+  unsigned lengths[NUM_DEFLATE_CODE_SYMBOLS + NUM_DISTANCE_SYMBOLS];
+  unsigned table_cl[1 << FAST_CL_BITS];
+  unsigned HLIT, HDIST, HCLEN, i = 0;
+
+  fastBitsRefill(bits);
+  HLIT = fastBitsPeek(bits, 5) + 257; fastBitsConsume(bits, 5);
+  HDIST = fastBitsPeek(bits, 5) + 1; fastBitsConsume(bits, 5);
+  HCLEN = fastBitsPeek(bits, 4) + 4; fastBitsConsume(bits, 4);
+  if(HLIT > 286) return 1;
+
+  for(i = 0; i < NUM_CODE_LENGTH_CODES; i++) lengths_cl[i] = 0;
+  for(i = 0; i < HCLEN; i++)
+  {
+    fastBitsRefill(bits);
+    lengths_cl[CLCL_ORDER[i]] = fastBitsPeek(bits, 3);
+    fastBitsConsume(bits, 3);
+  }
+  if(fastHuffmanBuild(table_cl, 1 << FAST_CL_BITS, FAST_CL_BITS, lengths_cl, NUM_CODE_LENGTH_CODES)) return 1;
+
+  i = 0;
+  while(i < HLIT + HDIST)
+  {
+    unsigned code, repeat, value = 0;
+    fastBitsRefill(bits);
+    code = fastDecodeSymbol(bits, table_cl, FAST_CL_BITS);
+    if(code < 16)
+    {
+      lengths[i++] = code;
+      continue;
+    }
+    else if(code == 16)
+    {
+      if(i == 0) return 1; /*nothing to repeat*/
+      value = lengths[i - 1];
+      repeat = 3 + fastBitsPeek(bits, 2); fastBitsConsume(bits, 2);
+    }
+    else if(code == 17)
+    {
+      repeat = 3 + fastBitsPeek(bits, 3); fastBitsConsume(bits, 3);
+    }
+    else if(code == 18)
+    {
+      repeat = 11 + fastBitsPeek(bits, 7); fastBitsConsume(bits, 7);
+    }
+    else return 1;
+    if(i + repeat > HLIT + HDIST) return 1;
+    while(repeat--) lengths[i++] = value;
+  }
+  if(lengths[256] == 0) return 1; /*no end code*/
+
+  if(fastHuffmanBuild(table_ll, FAST_LL_SIZE, FAST_LL_BITS, lengths, HLIT)) return 1;
+  return fastHuffmanBuild(table_d, FAST_D_SIZE, FAST_D_BITS, &lengths[HLIT], HDIST);
+}
+
+static void fastFixedTrees(unsigned* table_ll, unsigned* table_d)
+{
+  unsigned lengths[NUM_DEFLATE_CODE_SYMBOLS], i;
+  for(i = 0; i <= 143; i++) lengths[i] = 8;
+  for(i = 144; i <= 255; i++) lengths[i] = 9;
+  for(i = 256; i <= 279; i++) lengths[i] = 7;
+  for(i = 280; i <= 287; i++) lengths[i] = 8;
+  fastHuffmanBuild(table_ll, FAST_LL_SIZE, FAST_LL_BITS, lengths, NUM_DEFLATE_CODE_SYMBOLS);
+  for(i = 0; i < NUM_DISTANCE_SYMBOLS; i++) lengths[i] = 5;
+  fastHuffmanBuild(table_d, FAST_D_SIZE, FAST_D_BITS, lengths, NUM_DISTANCE_SYMBOLS);
+}
+
+static unsigned fastInflateHuffmanBlock(FastBits* bits, unsigned char* out, size_t outsize, size_t* pos,
+                                        const unsigned* table_ll, const unsigned* table_d)
+{
+  size_t p = *pos;
+  for(;;)
+  {
+    unsigned code_ll;
+    fastBitsRefill(bits);
+    code_ll = fastDecodeSymbol(bits, table_ll, FAST_LL_BITS);
+    if(code_ll < 256)
+    {
+      if(p >= outsize) return 1;
+      out[p++] = (unsigned char)code_ll;
+    }
+    else if(code_ll == 256) break;
+    else if(code_ll <= LAST_LENGTH_CODE_INDEX)
+    {
+      /*at most 5 + 15 + 13 bits after the length code, the refill left at least 41*/
+      unsigned index = code_ll - FIRST_LENGTH_CODE_INDEX, code_d;
+      size_t length, distance;
+      unsigned char* dst;
+      const unsigned char* src;
+
+      length = LENGTHBASE[index] + fastBitsPeek(bits, LENGTHEXTRA[index]);
+      fastBitsConsume(bits, LENGTHEXTRA[index]);
+      code_d = fastDecodeSymbol(bits, table_d, FAST_D_BITS);
+      if(code_d > 29) return 1;
+      distance = DISTANCEBASE[code_d] + fastBitsPeek(bits, DISTANCEEXTRA[code_d]);
+      fastBitsConsume(bits, DISTANCEEXTRA[code_d]);
+      if(distance > p || length > outsize - p) return 1;
+
+      dst = &out[p];
+      src = dst - distance;
+      if(distance >= 8 && outsize - p >= length + 8)
+      {
+        /*8 byte chunks never overlap their source; may write up to 7 bytes past the
+        match, which later output overwrites*/
+        unsigned char* end = dst + length;
+        do
+        {
+          memcpy(dst, src, 8);
+          dst += 8;
+          src += 8;
+        }
+        while(dst < end);
+      }
+      else if(distance == 1) memset(dst, src[0], length);
+      else
+      {
+        size_t i;
+        for(i = 0; i < length; i++) dst[i] = src[i];
+      }
+      p += length;
+    }
+    else return 1;
+  }
+  *pos = p;
+  return 0;
+}
+
+/*inflates into a buffer of known size, returns 0 on success*/
+static unsigned fastInflate(unsigned char* out, size_t outsize, size_t* outpos,
+                            const unsigned char* in, size_t insize)
+{
+  FastBits bits;
+  unsigned BFINAL = 0, error = 0;
+  size_t pos = 0;
+  unsigned* table_ll = (unsigned*)mymalloc((FAST_LL_SIZE + FAST_D_SIZE) * sizeof(unsigned));
+  unsigned* table_d = table_ll + FAST_LL_SIZE;
+  if(!table_ll) return 1;
+
+  bits.in = in;
+  bits.insize = insize;
+  bits.pos = 0;
+  bits.buf = 0;
+  bits.count = 0;
+
+  while(!BFINAL && !error)
+  {
+    unsigned BTYPE;
+    fastBitsRefill(&bits);
+    if(fastBitsOverrun(&bits)) { error = 1; break; }
+    BFINAL = fastBitsPeek(&bits, 1);
+    BTYPE = (unsigned)(bits.buf >> 1) & 3;
+    fastBitsConsume(&bits, 3);
+
+    if(BTYPE == 0)
+    {
+      /*stored block: drop to the byte boundary and give the buffered bytes back*/
+      size_t p;
+      unsigned LEN, NLEN;
+      fastBitsConsume(&bits, bits.count & 7);
+      p = bits.pos - bits.count / 8;
+      bits.buf = 0;
+      bits.count = 0;
+      if(p + 4 > insize) { error = 1; break; }
+      LEN = in[p] + 256u * in[p + 1];
+      NLEN = in[p + 2] + 256u * in[p + 3];
+      p += 4;
+      if(LEN + NLEN != 65535 || p + LEN > insize || LEN > outsize - pos) { error = 1; break; }
+      memcpy(&out[pos], &in[p], LEN);
+      pos += LEN;
+      bits.pos = p + LEN;
+    }
+    else if(BTYPE == 3) error = 1;
+    else
+    {
+      if(BTYPE == 1) fastFixedTrees(table_ll, table_d);
+      else error = fastReadDynamicTrees(&bits, table_ll, table_d);
+      if(!error) error = fastInflateHuffmanBlock(&bits, out, outsize, &pos, table_ll, table_d);
+      if(!error && fastBitsOverrun(&bits)) error = 1;
+    }
+  }
+
+  myfree(table_ll);
+  *outpos = pos;
+  return error;
+}
+
+/*unfilter kernels for 4 bytes per pixel, used for all scanlines except the first*/
+typedef void (*FastUnfilterKernel)(unsigned char* recon, const unsigned char* scanline,
+                                   const unsigned char* precon, size_t length);
+
+typedef struct FastUnfilterKernels
+{
+  FastUnfilterKernel sub, up, average, paeth;
+} FastUnfilterKernels;
+
+static void fastUnfilterSubScalar(unsigned char* recon, const unsigned char* scanline,
+                                  const unsigned char* precon, size_t length)
+{
+  unfilterScanline(recon, scanline, precon, 4, 1, length);
+}
+
+static void fastUnfilterUpScalar(unsigned char* recon, const unsigned char* scanline,
+                                 const unsigned char* precon, size_t length)
+{
+  unfilterScanline(recon, scanline, precon, 4, 2, length);
+}
+
+static void fastUnfilterAverageScalar(unsigned char* recon, const unsigned char* scanline,
+                                      const unsigned char* precon, size_t length)
+{
+  unfilterScanline(recon, scanline, precon, 4, 3, length);
+}
+
+static void fastUnfilterPaethScalar(unsigned char* recon, const unsigned char* scanline,
+                                    const unsigned char* precon, size_t length)
+{
+  unfilterScanline(recon, scanline, precon, 4, 4, length);
+}
+
+#ifdef LODEPNG_FAST_SSE2
+static __m128i fastLoad4(const unsigned char* p)
+{
+  int value;
+  memcpy(&value, p, 4);
+  return _mm_cvtsi32_si128(value);
+}
+
+static void fastStore4(unsigned char* p, __m128i v)
+{
+  int value = _mm_cvtsi128_si32(v);
+  memcpy(p, &value, 4);
+}
+
+static void fastUnfilterSubSSE2(unsigned char* recon, const unsigned char* scanline,
+                                const unsigned char* precon, size_t length)
+{
+  /*prefix sum over the 4 pixels of a register, plus the last pixel of the previous one*/
+  __m128i last = _mm_setzero_si128();
+  size_t i = 0;
+  (void)precon;
+  for(; i + 16 <= length; i += 16)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i*)&scanline[i]);
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi8(x, last);
+    _mm_storeu_si128((__m128i*)&recon[i], x);
+    last = _mm_shuffle_epi32(x, 0xff);
+  }
+  for(; i < length; i += 4)
+  {
+    last = _mm_add_epi8(last, fastLoad4(&scanline[i]));
+    fastStore4(&recon[i], last);
+  }
+}
+
+static void fastUnfilterUpSSE2(unsigned char* recon, const unsigned char* scanline,
+                               const unsigned char* precon, size_t length)
+{
+  size_t i = 0;
+  for(; i + 16 <= length; i += 16)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i*)&scanline[i]);
+    __m128i b = _mm_loadu_si128((const __m128i*)&precon[i]);
+    _mm_storeu_si128((__m128i*)&recon[i], _mm_add_epi8(x, b));
+  }
+  for(; i < length; i++) recon[i] = scanline[i] + precon[i];
+}
+
+static void fastUnfilterAverageSSE2(unsigned char* recon, const unsigned char* scanline,
+                                    const unsigned char* precon, size_t length)
+{
+  /*_mm_avg_epu8 rounds up, subtract the lost low bit to round down*/
+  const __m128i one = _mm_set1_epi8(1);
+  __m128i a = _mm_setzero_si128();
+  size_t i;
+  for(i = 0; i < length; i += 4)
+  {
+    __m128i b = fastLoad4(&precon[i]);
+    __m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+    a = _mm_add_epi8(average, fastLoad4(&scanline[i]));
+    fastStore4(&recon[i], a);
+  }
+}
+
+static __m128i fastAbs16(__m128i x)
+{
+  return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+static __m128i fastSelect(__m128i mask, __m128i a, __m128i b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static void fastUnfilterPaethSSE2(unsigned char* recon, const unsigned char* scanline,
+                                  const unsigned char* precon, size_t length)
+{
+  /*same predictor as paethPredictor, on 16 bit lanes*/
+  const __m128i zero = _mm_setzero_si128();
+  __m128i a = zero, c = zero;
+  size_t i;
+  for(i = 0; i < length; i += 4)
+  {
+    __m128i b = _mm_unpacklo_epi8(fastLoad4(&precon[i]), zero);
+    __m128i x = _mm_unpacklo_epi8(fastLoad4(&scanline[i]), zero);
+    __m128i pa = _mm_sub_epi16(b, c);
+    __m128i pb = _mm_sub_epi16(a, c);
+    __m128i pc = fastAbs16(_mm_add_epi16(pa, pb));
+    __m128i smallest, predictor;
+    pa = fastAbs16(pa);
+    pb = fastAbs16(pb);
+    smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+    predictor = fastSelect(_mm_cmpeq_epi16(smallest, pa), a,
+                           fastSelect(_mm_cmpeq_epi16(smallest, pb), b, c));
+    a = _mm_and_si128(_mm_add_epi16(predictor, x), _mm_set1_epi16(0xff));
+    fastStore4(&recon[i], _mm_packus_epi16(a, a));
+    c = b;
+  }
+}
+#endif /*LODEPNG_FAST_SSE2*/
+
+#ifdef LODEPNG_FAST_AVX2
+/*the other filters depend on the previous pixel, only up gains from wider registers*/
+LODEPNG_TARGET_AVX2 static void fastUnfilterUpAVX2(unsigned char* recon, const unsigned char* scanline,
+                                                   const unsigned char* precon, size_t length)
+{
+  size_t i = 0;
+  for(; i + 32 <= length; i += 32)
+  {
+    __m256i x = _mm256_loadu_si256((const __m256i*)&scanline[i]);
+    __m256i b = _mm256_loadu_si256((const __m256i*)&precon[i]);
+    _mm256_storeu_si256((__m256i*)&recon[i], _mm256_add_epi8(x, b));
+  }
+  for(; i < length; i++) recon[i] = scanline[i] + precon[i];
+}
+
+static int fastHasAVX2(void)
+{
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 0);
+  if(info[0] < 7) return 0;
+  __cpuid(info, 1);
+  /*the OS has to save the ymm registers too*/
+  if(!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)) || (_xgetbv(0) & 6) != 6) return 0;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif /*LODEPNG_FAST_AVX2*/
+
+static void fastGetUnfilterKernels(FastUnfilterKernels* kernels)
+{
+  kernels->sub = fastUnfilterSubScalar;
+  kernels->up = fastUnfilterUpScalar;
+  kernels->average = fastUnfilterAverageScalar;
+  kernels->paeth = fastUnfilterPaethScalar;
+#ifdef LODEPNG_FAST_SSE2
+  kernels->sub = fastUnfilterSubSSE2;
+  kernels->up = fastUnfilterUpSSE2;
+  kernels->average = fastUnfilterAverageSSE2;
+  kernels->paeth = fastUnfilterPaethSSE2;
+#endif /*LODEPNG_FAST_SSE2*/
+#ifdef LODEPNG_FAST_AVX2
+  if(fastHasAVX2()) kernels->up = fastUnfilterUpAVX2;
+#endif /*LODEPNG_FAST_AVX2*/
+}
+
+static unsigned fastUnfilter(unsigned char* out, const unsigned char* in, unsigned w, unsigned h)
+{
+  FastUnfilterKernels kernels;
+  size_t linebytes = (size_t)w * 4;
+  unsigned y;
+  fastGetUnfilterKernels(&kernels);
+
+  for(y = 0; y < h; y++)
+  {
+    unsigned char* recon = &out[linebytes * y];
+    const unsigned char* scanline = &in[(linebytes + 1) * y + 1];
+    const unsigned char* precon = y > 0 ? recon - linebytes : 0;
+    unsigned char filterType = scanline[-1];
+
+    if(!precon || filterType == 0 || filterType > 4)
+    {
+      CERROR_TRY_RETURN(unfilterScanline(recon, scanline, precon, 4, filterType, linebytes));
+    }
+    else if(filterType == 1) kernels.sub(recon, scanline, precon, linebytes);
+    else if(filterType == 2) kernels.up(recon, scanline, precon, linebytes);
+    else if(filterType == 3) kernels.average(recon, scanline, precon, linebytes);
+    else kernels.paeth(recon, scanline, precon, linebytes);
+  }
+  return 0;
+}
+
+/*decodes the IDAT data of an 8-bit RGBA non-interlaced image, returns 0 if the regular
+decoder has to be used instead*/
+static unsigned decodeFast(unsigned char** out, unsigned w, unsigned h, LodePNGState* state,
+                           const unsigned char* in, size_t insize)
+{
+  const LodePNGInfo* info = &state->info_png;
+  const LodePNGDecompressSettings* settings = &state->decoder.zlibsettings;
+  size_t linebytes = (size_t)w * 4, size, inflated = 0;
+  unsigned char* scanlines;
+  unsigned char* image;
+  unsigned error;
+
+  if(info->color.colortype != LCT_RGBA || info->color.bitdepth != 8 || info->interlace_method != 0) return 0;
+  if(settings->custom_zlib || settings->custom_inflate) return 0;
+  if(w == 0 || h == 0 || linebytes / 4 != w) return 0;
+  size = (linebytes + 1) * h;
+  if(size / h != linebytes + 1) return 0;
+
+  /*zlib header, the same checks as lodepng_zlib_decompress*/
+  if(insize < 6 || (in[0] * 256 + in[1]) % 31 != 0) return 0;
+  if((in[0] & 15) != 8 || ((in[0] >> 4) & 15) > 7 || ((in[1] >> 5) & 1) != 0) return 0;
+
+  scanlines = (unsigned char*)mymalloc(size);
+  image = (unsigned char*)mymalloc(linebytes * h);
+  error = !scanlines || !image;
+  if(!error) error = fastInflate(scanlines, size, &inflated, in + 2, insize - 2);
+  if(!error && inflated != size) error = 1;
+  if(!error && !settings->ignore_adler32)
+  {
+    error = adler32(scanlines, (unsigned)size) != lodepng_read32bitInt(&in[insize - 4]);
+  }
+  if(!error) error = fastUnfilter(image, scanlines, w, h);
+  myfree(scanlines);
+  if(error)
+  {
+    myfree(image);
+    return 0;
+  }
+  *out = image;
+  return 1;
+}
+
+#endif /*LODEPNG_COMPILE_ZLIB*/
+
 /*read a PNG, the result will be in the same color type as the PNG (hence "generic")*/
 static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
                           LodePNGState* state,
@@ -4408,6 +5040,14 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
     if(!IEND) chunk = lodepng_chunk_next_const(chunk);
   }
 
+#ifdef LODEPNG_COMPILE_ZLIB
+  if(!state->error && state->decoder.fast_decode && decodeFast(out, *w, *h, state, idat.data, idat.size))
+  {
+    ucvector_cleanup(&idat);
+    return;
+  }
+#endif /*LODEPNG_COMPILE_ZLIB*/
+
   if(!state->error)
   {
     ucvector scanlines;
@@ -4539,6 +5179,7 @@ void lodepng_decoder_settings_init(LodePNGDecoderSettings* settings)
   settings->remember_unknown_chunks = 0;
 #endif /*LODEPNG_COMPILE_ANCILLARY_CHUNKS*/
   settings->ignore_crc = 0;
+  settings->fast_decode = 1;
   lodepng_decompress_settings_init(&settings->zlibsettings);
 }
 
@@ -503,6 +503,8 @@ typedef struct LodePNGDecoderSettings
 
   unsigned ignore_crc; /*ignore CRC checksums*/
   unsigned color_convert; /*whether to convert the PNG to the color type you want. Default: yes*/
+  /*decode 8-bit RGBA non-interlaced images with the table driven inflate and SIMD unfilter. Default: yes*/
+  unsigned fast_decode;
 
 #ifdef LODEPNG_COMPILE_ANCILLARY_CHUNKS
   unsigned read_text_chunks; /*if false but remember_unknown_chunks is true, they're stored in the unknown chunks*/
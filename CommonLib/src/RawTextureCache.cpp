@@ -0,0 +1,200 @@
+#include "RawTextureCache.h"
+#include "CommonUtility.h"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <direct.h>
+#else
+#include <pthread.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+string RawTextureCache::s_directory = "../TextureCache";
+
+MappedTexture::MappedTexture()
+{
+	pixels		= NULL;
+	width		= 0;
+	height		= 0;
+	view		= NULL;
+	viewSize	= 0;
+#ifdef _WIN32
+	file		= NULL;
+	mapping		= NULL;
+#endif
+}
+
+void RawTextureCache::setDirectory(const string& p_directory)
+{
+	s_directory = p_directory;
+}
+
+string RawTextureCache::getCachePath(const string& p_sourcePath)
+{
+	// The whole source path is kept in the name so textures with the same
+	// file name in different directories don't collide.
+	string name = p_sourcePath;
+	for (unsigned int i = 0; i < name.size(); i++)
+	{
+		if (name[i] == '/' || name[i] == '\\' || name[i] == '.' || name[i] == ':')
+			name[i] = '_';
+	}
+	return s_directory + "/" + name + ".raw";
+}
+
+int RawTextureCache::readSourceInfo(const string& p_sourcePath,
+	long long* out_time, long long* out_size)
+{
+	struct stat info;
+	if (stat(p_sourcePath.c_str(), &info) != 0)
+		return GAME_FAIL;
+	*out_time = (long long)info.st_mtime;
+	*out_size = (long long)info.st_size;
+	return GAME_OK;
+}
+
+int RawTextureCache::open(const string& p_sourcePath, MappedTexture* out_texture)
+{
+	long long sourceTime = 0, sourceSize = 0;
+	if (readSourceInfo(p_sourcePath, &sourceTime, &sourceSize) != GAME_OK)
+		return GAME_FAIL;
+
+	string cachePath = getCachePath(p_sourcePath);
+	RawTextureHeader header;
+	{
+		ifstream file(cachePath.c_str(), ios::in | ios::binary);
+		if (!file.read((char*)&header, sizeof(header)))
+			return GAME_FAIL;
+	}
+	// A stale entry is left for store to replace, never written here
+	if (memcmp(header.magic, "DLOT", 4) != 0 || header.version != VERSION ||
+		header.sourceSize != sourceSize || header.sourceTime != sourceTime)
+	{
+		return GAME_FAIL;
+	}
+
+	size_t size = sizeof(header) + (size_t)header.width * header.height * 4;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(cachePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return GAME_FAIL;
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || (size_t)fileSize.QuadPart < size)
+	{
+		CloseHandle(file);
+		return GAME_FAIL;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size) : NULL;
+	if (!view)
+	{
+		if (mapping)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		return GAME_FAIL;
+	}
+	out_texture->file		= file;
+	out_texture->mapping	= mapping;
+#else
+	int file = ::open(cachePath.c_str(), O_RDONLY);
+	if (file < 0)
+		return GAME_FAIL;
+	struct stat info;
+	if (fstat(file, &info) != 0 || (size_t)info.st_size < size)
+	{
+		::close(file);
+		return GAME_FAIL;
+	}
+	void* view = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file);
+	if (view == MAP_FAILED)
+		return GAME_FAIL;
+#endif
+
+	out_texture->view		= view;
+	out_texture->viewSize	= size;
+	out_texture->pixels		= (const unsigned char*)view + sizeof(header);
+	out_texture->width		= header.width;
+	out_texture->height		= header.height;
+	return GAME_OK;
+}
+
+void RawTextureCache::close(MappedTexture* p_texture)
+{
+	if (!p_texture->view)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(p_texture->view);
+	CloseHandle(p_texture->mapping);
+	CloseHandle(p_texture->file);
+	p_texture->file		= NULL;
+	p_texture->mapping	= NULL;
+#else
+	munmap(p_texture->view, p_texture->viewSize);
+#endif
+	p_texture->view		= NULL;
+	p_texture->viewSize	= 0;
+	p_texture->pixels	= NULL;
+}
+
+int RawTextureCache::store(const string& p_sourcePath,
+	const unsigned char* p_pixels, unsigned int p_width, unsigned int p_height)
+{
+	RawTextureHeader header;
+	memcpy(header.magic, "DLOT", 4);
+	header.version	= VERSION;
+	header.width	= p_width;
+	header.height	= p_height;
+	if (readSourceInfo(p_sourcePath, &header.sourceTime, &header.sourceSize) != GAME_OK)
+		return GAME_FAIL;
+
+#ifdef _WIN32
+	_mkdir(s_directory.c_str());
+#else
+	mkdir(s_directory.c_str(), 0755);
+#endif
+
+	// Written to a temporary file of this thread first so a reader never
+	// sees half an entry and two threads storing the same one don't mix
+	string cachePath = getCachePath(p_sourcePath);
+	stringstream tempName;
+#ifdef _WIN32
+	tempName << cachePath << "." << GetCurrentThreadId() << ".tmp";
+#else
+	tempName << cachePath << "." << getpid() << "." << (unsigned long)pthread_self() << ".tmp";
+#endif
+	string tempPath = tempName.str();
+	{
+		ofstream file(tempPath.c_str(), ios::out | ios::binary | ios::trunc);
+		if (!file)
+			return GAME_FAIL;
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)p_pixels, (streamsize)p_width * p_height * 4);
+		if (!file)
+		{
+			file.close();
+			remove(tempPath.c_str());
+			return GAME_FAIL;
+		}
+	}
+	// Replaced in one step, only Windows can't rename over an existing file
+#ifdef _WIN32
+	remove(cachePath.c_str());
+#endif
+	if (rename(tempPath.c_str(), cachePath.c_str()) != 0)
+	{
+		remove(tempPath.c_str());
+		return GAME_FAIL;
+	}
+	return GAME_OK;
+}
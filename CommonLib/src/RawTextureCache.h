@@ -0,0 +1,63 @@
+#ifndef RAWTEXTURECACHE_H
+#define RAWTEXTURECACHE_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+// Header of a cached texture, followed by width * height RGBA pixels
+struct RawTextureHeader
+{
+	char				magic[4];
+	unsigned int		version;
+	unsigned int		width;
+	unsigned int		height;
+	long long			sourceTime;		// Modification time of the PNG
+	long long			sourceSize;
+};
+
+// A cached texture mapped into memory
+struct MappedTexture
+{
+	const unsigned char*	pixels;
+	unsigned int			width;
+	unsigned int			height;
+	void*					view;
+	size_t					viewSize;
+#ifdef _WIN32
+	void*					file;
+	void*					mapping;
+#endif
+
+	MappedTexture();
+};
+
+// Keeps decoded PNGs as raw RGBA files so later runs can map them instead
+// of decoding. An entry is used if the PNG's size and modification time
+// match the header, otherwise it is stale and replaced by the next store.
+// Entries are only ever written whole by store, so any number of threads
+// may open and store at once.
+class RawTextureCache
+{
+private:
+	static const unsigned int VERSION = 2;
+	static string s_directory;
+
+private:
+	static string	getCachePath(const string& p_sourcePath);
+	static int		readSourceInfo(const string& p_sourcePath,
+						long long* out_time, long long* out_size);
+
+public:
+	static void		setDirectory(const string& p_directory);
+
+	// Maps the cached pixels of the PNG. Fails if there is no valid entry.
+	static int		open(const string& p_sourcePath, MappedTexture* out_texture);
+	static void		close(MappedTexture* p_texture);
+
+	static int		store(const string& p_sourcePath, const unsigned char* p_pixels,
+						unsigned int p_width, unsigned int p_height);
+};
+
+#endif
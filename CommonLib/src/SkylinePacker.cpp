@@ -0,0 +1,130 @@
+#include "SkylinePacker.h"
+
+SkylinePacker::SkylinePacker(int p_width, int p_height)
+{
+	m_width		= p_width;
+	m_height	= p_height;
+	m_usedArea	= 0;
+
+	SkylineNode bottom;
+	bottom.x		= 0;
+	bottom.y		= 0;
+	bottom.width	= p_width;
+	m_skyline.push_back(bottom);
+}
+
+int SkylinePacker::fit(int p_index, int p_width, int p_height) const
+{
+	// Returns the lowest y a rectangle placed at the start of the node can
+	// have, or -1 if it doesn't fit there.
+	int x = m_skyline[p_index].x;
+	if (x + p_width > m_width)
+		return -1;
+
+	int y = m_skyline[p_index].y;
+	int widthLeft = p_width;
+	for (unsigned int i = p_index; widthLeft > 0; i++)
+	{
+		if (m_skyline[i].y > y)
+			y = m_skyline[i].y;
+		if (y + p_height > m_height)
+			return -1;
+		widthLeft -= m_skyline[i].width;
+	}
+	return y;
+}
+
+int SkylinePacker::insert(int p_width, int p_height, int* out_x, int* out_y)
+{
+	if (p_width <= 0 || p_height <= 0)
+		return GAME_FAIL;
+
+	int bestIndex	= -1;
+	int bestBottom	= m_height + 1;
+	int bestWidth	= m_width + 1;
+	int bestY		= 0;
+
+	for (unsigned int i = 0; i < m_skyline.size(); i++)
+	{
+		int y = fit(i, p_width, p_height);
+		if (y < 0)
+			continue;
+
+		int bottom = y + p_height;
+		if (bottom < bestBottom ||
+			(bottom == bestBottom && m_skyline[i].width < bestWidth))
+		{
+			bestIndex	= i;
+			bestBottom	= bottom;
+			bestWidth	= m_skyline[i].width;
+			bestY		= y;
+		}
+	}
+
+	if (bestIndex < 0)
+		return GAME_FAIL;
+
+	*out_x = m_skyline[bestIndex].x;
+	*out_y = bestY;
+	addLevel(bestIndex, *out_x, bestY, p_width, p_height);
+	m_usedArea += p_width * p_height;
+	return GAME_OK;
+}
+
+void SkylinePacker::addLevel(int p_index, int p_x, int p_y, int p_width,
+	int p_height)
+{
+	SkylineNode node;
+	node.x		= p_x;
+	node.y		= p_y + p_height;
+	node.width	= p_width;
+	m_skyline.insert(m_skyline.begin() + p_index, node);
+
+	// Shrink or remove the nodes now covered by the new one
+	for (unsigned int i = p_index + 1; i < m_skyline.size();)
+	{
+		SkylineNode& prev = m_skyline[i - 1];
+		int overlap = prev.x + prev.width - m_skyline[i].x;
+		if (overlap <= 0)
+			break;
+
+		m_skyline[i].x		+= overlap;
+		m_skyline[i].width	-= overlap;
+		if (m_skyline[i].width > 0)
+			break;
+
+		m_skyline.erase(m_skyline.begin() + i);
+	}
+	mergeLevels();
+}
+
+void SkylinePacker::mergeLevels()
+{
+	for (unsigned int i = 0; i + 1 < m_skyline.size();)
+	{
+		if (m_skyline[i].y == m_skyline[i + 1].y)
+		{
+			m_skyline[i].width += m_skyline[i + 1].width;
+			m_skyline.erase(m_skyline.begin() + i + 1);
+		}
+		else
+			i++;
+	}
+}
+
+int SkylinePacker::getWidth() const
+{
+	return m_width;
+}
+int SkylinePacker::getHeight() const
+{
+	return m_height;
+}
+int SkylinePacker::getUsedArea() const
+{
+	return m_usedArea;
+}
+float SkylinePacker::getOccupancy() const
+{
+	return (float)m_usedArea / (m_width * m_height);
+}
@@ -0,0 +1,43 @@
+#ifndef SKYLINEPACKER_H
+#define SKYLINEPACKER_H
+
+#include "CommonUtility.h"
+#include <vector>
+
+using namespace std;
+
+// Packs rectangles into a fixed size area using the skyline bottom-left
+// heuristic. Used to place textures in atlas pages.
+class SkylinePacker
+{
+private:
+	struct SkylineNode
+	{
+		int x, y;
+		int width;
+	};
+
+	vector<SkylineNode>	m_skyline;
+	int					m_width;
+	int					m_height;
+	int					m_usedArea;
+
+private:
+	int		fit(int p_index, int p_width, int p_height) const;
+	void	addLevel(int p_index, int p_x, int p_y, int p_width, int p_height);
+	void	mergeLevels();
+
+public:
+			SkylinePacker(int p_width, int p_height);
+
+	// Finds room for a p_width x p_height rectangle. Returns GAME_FAIL if
+	// it doesn't fit anywhere.
+	int		insert(int p_width, int p_height, int* out_x, int* out_y);
+
+	int		getWidth() const;
+	int		getHeight() const;
+	int		getUsedArea() const;
+	float	getOccupancy() const;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <string>
 #include "TransformInfo.h"
 #include "Rect.h"
+#include "TexturePaths.h"
 
 using namespace std;
 
@@ -11,13 +12,10 @@ struct SpriteInfo
 {
 public:
 	int				id;
-	string			textureFilePath;
+	int				texturePathId;	// See TexturePaths
 	int				textureIndex;
 	bool			visible;
 	TransformInfo	transformInfo;
-	float			bwFraction;
-	float			sepiaFraction;
-	float			fadeToBlackFraction;
 
 	// The texture rect is specifying x and y-offset,
 	// and width and height in pixels. Defaults to the
@@ -27,10 +25,17 @@ public:
 
 	//Color Overlay
 	float	overlay[4];
+
+	// When set, the sprite is drawn once at each of the instanceCount
+	// transforms instead of at its own. The array is owned by whoever set
+	// it and has to outlive the sprite or be unset first.
+	const TransformInfo*	instances;
+	int						instanceCount;
 	
 	SpriteInfo()
 	{
-		textureFilePath = "";
+		id = -1;
+		texturePathId = 0;
 		textureIndex = -1;
 		visible = true;
 		transformInfo.rotation[0] = 0.0f;
@@ -44,16 +49,24 @@ public:
 		transformInfo.scale[2] = 0.0f;
 		textureRect.width = 0;
 		textureRect.height = 0;
-		bwFraction = 0;
-		sepiaFraction = 0;
-		fadeToBlackFraction = 0;
 		overlay[0] = overlay[1] = overlay[2] = overlay[3] = 0;
+		instances = NULL;
+		instanceCount = 0;
 	}
 
 	SpriteInfo( string p_textureFilePath )
 	{
-		SpriteInfo();
-		textureFilePath = p_textureFilePath;
+		*this = SpriteInfo();
+		setTexturePath(p_textureFilePath);
+	}
+
+	void setTexturePath(const string& p_textureFilePath)
+	{
+		texturePathId = TexturePaths::intern(p_textureFilePath);
+	}
+	const string& getTexturePath() const
+	{
+		return TexturePaths::getPath(texturePathId);
 	}
 
 };
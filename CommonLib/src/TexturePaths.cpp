@@ -0,0 +1,31 @@
+#include "TexturePaths.h"
+
+vector<string> TexturePaths::s_paths(1, "");
+map<string, int> TexturePaths::s_ids;
+
+int TexturePaths::intern(const string& p_path)
+{
+	if (p_path == "")
+		return 0;
+
+	map<string, int>::iterator it = s_ids.find(p_path);
+	if (it != s_ids.end())
+		return it->second;
+
+	int id = (int)s_paths.size();
+	s_paths.push_back(p_path);
+	s_ids[p_path] = id;
+	return id;
+}
+
+const string& TexturePaths::getPath(int p_id)
+{
+	if (p_id < 0 || p_id >= (int)s_paths.size())
+		return s_paths[0];
+	return s_paths[p_id];
+}
+
+int TexturePaths::getCount()
+{
+	return (int)s_paths.size();
+}
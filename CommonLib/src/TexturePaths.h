@@ -0,0 +1,24 @@
+#ifndef TEXTUREPATHS_H
+#define TEXTUREPATHS_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+// Interns texture paths so that sprites only carry an integer id. Id 0 is
+// the empty path, meaning the default texture.
+class TexturePaths
+{
+private:
+	static vector<string>	s_paths;
+	static map<string, int>	s_ids;
+
+public:
+	static int				intern(const string& p_path);
+	static const string&	getPath(int p_id);
+	static int				getCount();
+};
+
+#endif
@@ -58,50 +58,11 @@ bool AI::shouldChaseTarget()
 }
 void AI::chaseTarget()
 {
-	Tile* goal = m_avatar->getCurrentTile();
-	m_master->FindPath(m_master->getCurrentTile(),goal);
+	m_master->ChaseTile(m_avatar->getCurrentTile());
 }
 void AI::fleeFromTarget()
 {
-	TilePosition fleeFromTile = m_avatar->getCurrentTile()->getTilePosition();
-	TilePosition currentTile = m_master->getCurrentTile()->getTilePosition();
-
-	int xDistance = abs(currentTile.x-fleeFromTile.x);
-	int yDistance = abs(currentTile.y-fleeFromTile.y);
-
-	xDistance = m_tilemap->getWidth() - xDistance;
-	yDistance = m_tilemap->getWidth() - yDistance;
-	
-	int fleeDirX;
-	int fleeDirY;
-
-	if(randBool())
-		fleeDirX = 1;
-	else
-		fleeDirX = -1;
-
-	if(randBool())
-		fleeDirY = 1;
-	else
-		fleeDirY = -1;
-
-	xDistance = xDistance*fleeDirX;
-	yDistance = yDistance*fleeDirY;
-
-	if(xDistance < 0)
-		xDistance = 0;
-	else if(xDistance >= m_tilemap->getWidth())
-		xDistance = m_tilemap->getWidth()-1;
-
-	if(yDistance < 0)
-		yDistance = 0;
-	else if(yDistance >= m_tilemap->getHeight())
-		yDistance = m_tilemap->getHeight()-1;
-
-	TilePosition goalTP = TilePosition(xDistance,yDistance);
-	Tile* goalT = m_tilemap->getTile(goalTP);
-
-	m_master->FindPath(m_master->getCurrentTile(), goalT);
+	m_master->FleeFromTile(m_avatar->getCurrentTile());
 }
 bool AI::randBool()
 {
@@ -109,23 +70,9 @@ bool AI::randBool()
 }
 bool AI::seesTarget()
 {
-	TilePosition pos = m_master->getCurrentTile()->getTilePosition();
-	TilePosition avpos = m_avatar->getCurrentTile()->getTilePosition();
-	TilePosition diff = avpos - pos;
-	if (abs(diff.x) == 0 || abs(diff.y) == 0)
-	{
-		//If the monster and the avatar are in the same column or row
-		diff.x /= max(1, abs(diff.x));
-		diff.y /= max(1, abs(diff.y));
-		while (!(pos == avpos))
-		{
-			if (!m_tilemap->getTile(pos)->isFree())
-				return false;
-			pos = pos + diff;
-		}
-		return true;
-	}
-	return false;
+	//If the monster and the avatar are in the same column or row with
+	//nothing in between
+	return m_tilemap->isLineFree(m_master->getCurrentTile(), m_avatar->getCurrentTile());
 }
 Tile* AI::findRushTile()
 {
@@ -133,15 +80,9 @@ Tile* AI::findRushTile()
 	TilePosition avpos = m_avatar->getCurrentTile()->getTilePosition();
 	TilePosition diff = avpos - pos;
 
-	//If the monster and the avatar are in the same column or row
-	diff.x /= max(1, abs(diff.x));
-	diff.y /= max(1, abs(diff.y));
-
-	Tile* t = m_tilemap->getTile(pos);
-	while (t && t->isFree())
-	{
-		pos = pos + diff;
-		t = m_tilemap->getTile(pos);
-	}
-	return m_tilemap->getTile(pos - diff);
+	//Only rush along a column or row, standing on the avatar's tile
+	//gives no direction
+	if ((diff.x != 0) == (diff.y != 0))
+		return m_master->getCurrentTile();
+	return m_tilemap->farthestFreeTile(m_master->getCurrentTile(), diff);
 }
\ No newline at end of file
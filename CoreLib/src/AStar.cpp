@@ -0,0 +1,115 @@
+#include "AStar.h"
+#include <algorithm>
+#include <cstdlib>
+
+AStar::AStar(int p_width, int p_height, Tile** p_tiles)
+{
+	m_tiles			= p_tiles;
+	m_width			= p_width;
+	m_height		= p_height;
+	m_costs.resize(p_width * p_height, 0);
+	m_parents.resize(p_width * p_height, -1);
+	m_states.resize(p_width * p_height, 0);
+	m_generation	= 0;
+	m_expanded		= 0;
+}
+
+void AStar::beginQuery()
+{
+	m_generation += 2;
+	if (m_generation >= 0xfffffffe)
+	{
+		// Old states could be mistaken for new ones after the wrap
+		fill(m_states.begin(), m_states.end(), 0);
+		m_generation = 2;
+	}
+	m_open.clear();
+	m_expanded = 0;
+}
+
+int AStar::estimate(int p_index, int p_goal)
+{
+	return abs(p_index % m_width - p_goal % m_width) +
+		abs(p_index / m_width - p_goal / m_width);
+}
+
+bool AStar::findPath(Tile* p_start, Tile* p_goal, vector<Tile*>* out_path)
+{
+	TilePosition startPosition = p_start->getTilePosition();
+	TilePosition goalPosition = p_goal->getTilePosition();
+	int start = startPosition.y * m_width + startPosition.x;
+	int goal = goalPosition.y * m_width + goalPosition.x;
+
+	beginQuery();
+	m_costs[start]		= 0;
+	m_parents[start]	= -1;
+	m_states[start]		= m_generation;
+	OpenItem first;
+	first.estimate	= estimate(start, goal);
+	first.total		= first.estimate;
+	first.index		= start;
+	m_open.push_back(first);
+
+	static const int offsetX[] = {0, 0, 1, -1};
+	static const int offsetY[] = {1, -1, 0, 0};
+
+	bool found = false;
+	while (!m_open.empty())
+	{
+		pop_heap(m_open.begin(), m_open.end());
+		int current = m_open.back().index;
+		m_open.pop_back();
+
+		// Tiles are pushed again when a cheaper way is found, the
+		// older entries are skipped here
+		if (m_states[current] == m_generation + 1)
+			continue;
+		if (current == goal)
+		{
+			found = true;
+			break;
+		}
+		m_states[current] = m_generation + 1;
+		m_expanded++;
+
+		int x = current % m_width;
+		int y = current / m_width;
+		int cost = m_costs[current] + 1;
+		for (int i = 0; i < 4; i++)
+		{
+			int nx = x + offsetX[i];
+			int ny = y + offsetY[i];
+			if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height)
+				continue;
+
+			int next = ny * m_width + nx;
+			if (m_states[next] == m_generation + 1 || !m_tiles[next]->isFree())
+				continue;
+			if (m_states[next] == m_generation && m_costs[next] <= cost)
+				continue;
+
+			m_states[next]	= m_generation;
+			m_costs[next]	= cost;
+			m_parents[next]	= current;
+			OpenItem item;
+			item.estimate	= estimate(next, goal);
+			item.total		= cost + item.estimate;
+			item.index		= next;
+			m_open.push_back(item);
+			push_heap(m_open.begin(), m_open.end());
+		}
+	}
+
+	if (!found)
+		return false;
+
+	out_path->clear();
+	for (int index = goal; index != -1; index = m_parents[index])
+		out_path->push_back(m_tiles[index]);
+	return true;
+}
+
+int AStar::getExpandedCount()
+{
+	return m_expanded;
+}
@@ -0,0 +1,61 @@
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include "Tile.h"
+#include <vector>
+
+using namespace std;
+
+// A* search over the tiles of a map, moving in four directions through
+// free tiles. The open list is a binary heap and the cost, parent and
+// state of each tile live in flat arrays indexed by y * width + x. The
+// arrays are kept between queries: a tile's entries only count if its
+// state belongs to the current query's generation, so starting a query
+// doesn't clear or allocate anything.
+class AStar
+{
+private:
+	struct OpenItem
+	{
+		int total;		// Cost from the start plus estimate to the goal
+		int estimate;
+		int index;
+
+		// Heap order, lowest total first and closest to the goal on ties
+		bool operator<(const OpenItem& p_other) const
+		{
+			if (total != p_other.total)
+				return total > p_other.total;
+			return estimate > p_other.estimate;
+		}
+	};
+
+	Tile**					m_tiles;
+	int						m_width;
+	int						m_height;
+
+	vector<int>				m_costs;
+	vector<int>				m_parents;
+	// m_generation while open, m_generation + 1 once closed, anything
+	// lower if the tile hasn't been reached in this query
+	vector<unsigned int>	m_states;
+	unsigned int			m_generation;
+	vector<OpenItem>		m_open;
+	int						m_expanded;
+
+private:
+	void	beginQuery();
+	int		estimate(int p_index, int p_goal);
+
+public:
+	AStar(int p_width, int p_height, Tile** p_tiles);
+
+	// Fills out_path with the tiles from the goal back to the start.
+	// Returns false and leaves out_path untouched if there is no path.
+	bool	findPath(Tile* p_start, Tile* p_goal, vector<Tile*>* out_path);
+
+	// Tiles expanded by the last query
+	int		getExpandedCount();
+};
+
+#endif
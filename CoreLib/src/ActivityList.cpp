@@ -0,0 +1,92 @@
+#include "ActivityList.h"
+#include <algorithm>
+
+ActivityList::ActivityList()
+{
+	m_time = 0;
+}
+
+int ActivityList::add(bool p_awake)
+{
+	int id = m_awakeIndices.size();
+	m_awakeIndices.push_back(-1);
+	m_alarmTimes.push_back(-1);
+	if (p_awake)
+		wake(id);
+	return id;
+}
+
+void ActivityList::clear()
+{
+	m_awake.clear();
+	m_awakeIndices.clear();
+	m_alarmTimes.clear();
+	m_alarms.clear();
+}
+
+void ActivityList::update(float p_deltaTime)
+{
+	m_time += p_deltaTime;
+	while (!m_alarms.empty() && m_alarms.front().time <= m_time)
+	{
+		Alarm alarm = m_alarms.front();
+		pop_heap(m_alarms.begin(), m_alarms.end());
+		m_alarms.pop_back();
+		if (m_alarmTimes[alarm.id] == alarm.time)
+			wake(alarm.id);
+	}
+}
+
+void ActivityList::wake(int p_id)
+{
+	m_alarmTimes[p_id] = -1;
+	if (m_awakeIndices[p_id] >= 0)
+		return;
+	m_awakeIndices[p_id] = m_awake.size();
+	m_awake.push_back(p_id);
+}
+
+void ActivityList::sleep(int p_id)
+{
+	m_alarmTimes[p_id] = -1;
+	int index = m_awakeIndices[p_id];
+	if (index < 0)
+		return;
+
+	int last = m_awake.back();
+	m_awake[index] = last;
+	m_awakeIndices[last] = index;
+	m_awake.pop_back();
+	m_awakeIndices[p_id] = -1;
+}
+
+void ActivityList::sleepFor(int p_id, float p_seconds)
+{
+	sleep(p_id);
+	Alarm alarm;
+	alarm.time	= m_time + p_seconds;
+	alarm.id	= p_id;
+	m_alarmTimes[p_id] = alarm.time;
+	m_alarms.push_back(alarm);
+	push_heap(m_alarms.begin(), m_alarms.end());
+}
+
+bool ActivityList::isAwake(int p_id)
+{
+	return m_awakeIndices[p_id] >= 0;
+}
+
+int ActivityList::getAwakeCount()
+{
+	return m_awake.size();
+}
+
+int ActivityList::getAwake(int p_index)
+{
+	return m_awake[p_index];
+}
+
+int ActivityList::getCount()
+{
+	return m_awakeIndices.size();
+}
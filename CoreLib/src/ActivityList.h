@@ -0,0 +1,52 @@
+#ifndef ACTIVITYLIST_H
+#define ACTIVITYLIST_H
+
+#include <vector>
+
+using namespace std;
+
+// Tracks which of a set of objects are awake, so only those are updated.
+// A sleeping id wakes when it is woken directly or when a timer it set
+// runs out. The awake ids are kept packed; go through them from the back, then an id can be put to
+// sleep during the pass without skipping any other.
+class ActivityList
+{
+private:
+	struct Alarm
+	{
+		float	time;
+		int		id;
+		bool operator<(const Alarm& p_other) const
+		{
+			// Earliest on top of the heap
+			return time > p_other.time;
+		}
+	};
+
+	float			m_time;
+	vector<int>		m_awake;
+	vector<int>		m_awakeIndices;	// Per id, position in m_awake or -1
+	vector<float>	m_alarmTimes;	// Per id, when it wakes or -1
+	vector<Alarm>	m_alarms;		// Heap, stale alarms are skipped
+
+public:
+	ActivityList();
+
+	// Ids are handed out in order from 0
+	int		add(bool p_awake);
+	void	clear();
+	// Moves the clock and wakes the ids whose timers have run out
+	void	update(float p_deltaTime);
+
+	void	wake(int p_id);
+	// Sleeps until woken
+	void	sleep(int p_id);
+	void	sleepFor(int p_id, float p_seconds);
+
+	bool	isAwake(int p_id);
+	int		getAwakeCount();
+	int		getAwake(int p_index);
+	int		getCount();
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "AnimationClip.h"
+
+vector<AnimationClip> AnimationClips::s_clips;
+vector<int> AnimationClips::s_sheets;
+
+AnimationClip::AnimationClip(fVector2 p_start, float p_frameWidth, float p_frameHeight,
+	unsigned int p_frameCount, float p_delay, bool p_loop)
+{
+	start		= p_start;
+	frameWidth	= p_frameWidth;
+	frameHeight	= p_frameHeight;
+	frameCount	= p_frameCount;
+	delay		= p_delay;
+	loop		= p_loop;
+}
+
+Rect AnimationClip::getFrame(unsigned int p_frame) const
+{
+	Rect r;
+	r.x = (int)( start.x + frameWidth*p_frame );
+	r.y = (int)( start.y );
+	r.width = (int)( frameWidth );
+	r.height = (int)( frameHeight );
+	return r;
+}
+
+bool AnimationClip::operator==(const AnimationClip& p_other) const
+{
+	return start.x == p_other.start.x && start.y == p_other.start.y &&
+		frameWidth == p_other.frameWidth && frameHeight == p_other.frameHeight &&
+		frameCount == p_other.frameCount && delay == p_other.delay &&
+		loop == p_other.loop;
+}
+
+int AnimationClips::add(int p_sheet, const AnimationClip& p_clip)
+{
+	// Only a handful of clips exist, so a search is enough
+	for (unsigned int i = 0; i < s_clips.size(); i++)
+	{
+		if (s_sheets[i] == p_sheet && s_clips[i] == p_clip)
+			return i;
+	}
+	s_clips.push_back(p_clip);
+	s_sheets.push_back(p_sheet);
+	return s_clips.size() - 1;
+}
+
+const AnimationClip& AnimationClips::get(int p_id)
+{
+	return s_clips[p_id];
+}
+
+int AnimationClips::getCount()
+{
+	return s_clips.size();
+}
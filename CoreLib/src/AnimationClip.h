@@ -0,0 +1,42 @@
+#ifndef ANIMATIONCLIP_H
+#define ANIMATIONCLIP_H
+
+#include <fVector2.h>
+#include <Rect.h>
+#include <vector>
+
+using namespace std;
+
+// The frames of one animation on a spritesheet, stepping horizontally
+// from p_start. A clip never changes once registered, the playback state
+// is kept by an AnimationPlayer.
+struct AnimationClip
+{
+	fVector2		start;
+	float			frameWidth;
+	float			frameHeight;
+	unsigned int	frameCount;
+	float			delay;
+	bool			loop;
+
+	AnimationClip(fVector2 p_start, float p_frameWidth, float p_frameHeight,
+		unsigned int p_frameCount, float p_delay, bool p_loop = false);
+	Rect getFrame(unsigned int p_frame) const;
+	bool operator==(const AnimationClip& p_other) const;
+};
+
+// Clips shared by every instance animated with them. Registering the
+// same clip for the same sheet again gives back the id it already has.
+class AnimationClips
+{
+private:
+	static vector<AnimationClip>	s_clips;
+	static vector<int>				s_sheets;	// Texture path id per clip
+
+public:
+	static int					add(int p_sheet, const AnimationClip& p_clip);
+	static const AnimationClip&	get(int p_id);
+	static int					getCount();
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "AnimationPlayer.h"
+
+AnimationPlayer::AnimationPlayer()
+{
+}
+
+int AnimationPlayer::add(int p_clip, SpriteInfo* p_spriteInfo)
+{
+	m_clips.push_back(p_clip);
+	m_frames.push_back(0);
+	m_times.push_back(0);
+	m_rates.push_back(1);
+	m_sprites.push_back(p_spriteInfo);
+
+	int id = m_clips.size() - 1;
+	showFrame(id);
+	return id;
+}
+
+void AnimationPlayer::clear()
+{
+	m_clips.clear();
+	m_frames.clear();
+	m_times.clear();
+	m_rates.clear();
+	m_sprites.clear();
+}
+
+void AnimationPlayer::update(float p_deltaTime)
+{
+	for (unsigned int i = 0; i < m_clips.size(); i++)
+	{
+		if (m_rates[i] == 0)
+			continue;
+
+		const AnimationClip& clip = AnimationClips::get(m_clips[i]);
+		m_times[i] += p_deltaTime * m_rates[i];
+		if (m_times[i] > clip.delay)
+		{
+			m_times[i] -= clip.delay;
+			if (m_frames[i] < clip.frameCount)
+				m_frames[i]++;
+			if (clip.loop && m_frames[i] >= clip.frameCount)
+				m_frames[i] = 0;
+			if (m_sprites[i])
+				m_sprites[i]->textureRect = clip.getFrame(m_frames[i]);
+		}
+	}
+}
+
+void AnimationPlayer::showFrame(int p_id)
+{
+	if (m_sprites[p_id])
+		m_sprites[p_id]->textureRect = getFrame(p_id);
+}
+
+void AnimationPlayer::play(int p_id, int p_clip)
+{
+	if (m_clips[p_id] == p_clip)
+		return;
+	m_clips[p_id] = p_clip;
+
+	// A finished clip before this one must not leave it past its end
+	const AnimationClip& clip = AnimationClips::get(p_clip);
+	if (m_frames[p_id] >= clip.frameCount)
+		m_frames[p_id] = 0;
+	showFrame(p_id);
+}
+
+void AnimationPlayer::restart(int p_id)
+{
+	m_frames[p_id]	= 0;
+	m_times[p_id]	= 0;
+	showFrame(p_id);
+}
+
+void AnimationPlayer::setRate(int p_id, float p_rate)
+{
+	m_rates[p_id] = p_rate;
+}
+
+int AnimationPlayer::getClip(int p_id)
+{
+	return m_clips[p_id];
+}
+
+Rect AnimationPlayer::getFrame(int p_id)
+{
+	return AnimationClips::get(m_clips[p_id]).getFrame(m_frames[p_id]);
+}
+
+bool AnimationPlayer::hasFinished(int p_id)
+{
+	return m_frames[p_id] >= AnimationClips::get(m_clips[p_id]).frameCount;
+}
+
+int AnimationPlayer::getCount()
+{
+	return m_clips.size();
+}
@@ -0,0 +1,46 @@
+#ifndef ANIMATIONPLAYER_H
+#define ANIMATIONPLAYER_H
+
+#include "AnimationClip.h"
+#include "SpriteInfo.h"
+#include <vector>
+
+using namespace std;
+
+// Plays shared AnimationClips for many instances. An instance only keeps
+// which clip it plays, its frame, the time into the frame and how fast it
+// plays, each in its own array, so the whole set advances in one pass.
+// A sprite's texture rect is only written when its frame changes.
+class AnimationPlayer
+{
+private:
+	vector<int>				m_clips;
+	vector<unsigned int>	m_frames;
+	vector<float>			m_times;
+	vector<float>			m_rates;	// 0 holds the current frame
+	vector<SpriteInfo*>		m_sprites;
+
+private:
+	void	showFrame(int p_id);
+
+public:
+	AnimationPlayer();
+
+	// Ids are handed out in order from 0. The sprite may be NULL.
+	int		add(int p_clip, SpriteInfo* p_spriteInfo);
+	void	clear();
+	void	update(float p_deltaTime);
+
+	// Switching between clips of the same length, like the directions of
+	// a walk, carries on from the same frame
+	void	play(int p_id, int p_clip);
+	void	restart(int p_id);
+	void	setRate(int p_id, float p_rate);
+
+	int		getClip(int p_id);
+	Rect	getFrame(int p_id);
+	bool	hasFinished(int p_id);
+	int		getCount();
+};
+
+#endif
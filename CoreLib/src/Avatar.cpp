@@ -4,9 +4,14 @@
 #include "AvatarWalking.h"
 
 Avatar::Avatar(SpriteInfo* p_spriteInfo, SpriteInfo* p_shadow, Tilemap* p_map, Tile* p_startTile, 
-	GameStats* p_stats, SoundInfo* p_avatarKilledSound, SoundInfo* p_jumpSound)
+	GameStats* p_stats, SoundInfo* p_avatarKilledSound, SoundInfo* p_jumpSound,
+	AnimationPlayer* p_animations)
 	: GameObject(p_spriteInfo, p_stats)
 {
+	m_ownsAnimations = p_animations == NULL;
+	m_animations = m_ownsAnimations ? new AnimationPlayer() : p_animations;
+	m_animation = -1;
+
 	m_navigationData = new NavigationData();
 	m_navigationData->m_direction = Direction::NONE;
 	m_navigationData->m_desired = Direction::NONE;
@@ -59,6 +64,8 @@ Avatar::~Avatar()
 		delete m_walking;
 	if (m_navigationData)
 		delete m_navigationData;
+	if (m_ownsAnimations)
+		delete m_animations;
 }
 
 void Avatar::update(float p_deltaTime, InputInfo p_inputInfo)
@@ -79,24 +86,31 @@ void Avatar::update(float p_deltaTime, InputInfo p_inputInfo)
 			switchState(m_walking);
 		}
 
-		if (m_currentAnimation)
+		if (m_animation >= 0)
 		{
 			if (m_navigationData->m_direction != Direction::NONE || m_currentState == m_avatarKilledState)
 			{
+				// The killed state advances the death animation as well
 				if (m_gameStats->isSpeeded() && m_currentState == m_walking)
-					m_currentAnimation->update(p_deltaTime*2);
+					m_animations->setRate(m_animation, 2);
+				else if (m_currentState == m_avatarKilledState)
+					m_animations->setRate(m_animation, 2);
 				else
-					m_currentAnimation->update(p_deltaTime);
+					m_animations->setRate(m_animation, 1);
 			}
 			else
 			{
-				m_currentAnimation->restart();
+				m_animations->restart(m_animation);
+				m_animations->setRate(m_animation, 0);
 			}
-		
-			if (m_spriteInfo)
-				m_spriteInfo->textureRect = m_currentAnimation->getCurrentFrame();
 		}
 	}
+	else if (m_animation >= 0)
+	{
+		m_animations->setRate(m_animation, 0);
+	}
+	if (m_ownsAnimations)
+		m_animations->update(p_deltaTime);
 
 	if (m_spriteInfo)
 	{
@@ -269,7 +283,7 @@ void Avatar::revive(Tile* p_newPosition)
 	//Added by Anton
 	m_timeSinceSpawn = 0;
 	m_spriteInfo->transformInfo.translation[TransformInfo::Y] += (SPAWNTIME - m_timeSinceSpawn) / SPAWNTIME * 2000;
-	m_spriteInfo->textureRect = m_currentAnimation->getCurrentFrame();
+	m_spriteInfo->textureRect = m_animations->getFrame(m_animation);
 	m_spriteInfo->visible = true;
 
 	//Added to handle super mode
@@ -281,9 +295,21 @@ void Avatar::revive(Tile* p_newPosition)
 		m_spriteInfo->transformInfo.scale[TransformInfo::Y] = m_size.y;
 	m_offset = 16 * m_spriteInfo->transformInfo.scale[TransformInfo::Y] / 64;
 }
-void Avatar::setCurrentAnimation(Animation* p_animation)
+void Avatar::setCurrentAnimation(int p_clip)
+{
+	// The first state entered decides the clip to start with
+	if (m_animation < 0)
+		m_animation = m_animations->add(p_clip, m_spriteInfo);
+	else
+		m_animations->play(m_animation, p_clip);
+}
+void Avatar::restartAnimation()
+{
+	m_animations->restart(m_animation);
+}
+bool Avatar::hasAnimationFinished()
 {
-	m_currentAnimation = p_animation;
+	return m_animations->hasFinished(m_animation);
 }
 fVector2 Avatar::getPostion()
 {
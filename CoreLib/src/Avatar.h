@@ -2,7 +2,7 @@
 #define AVATAR_H
 
 #include "Tilemap.h"
-#include "Animation.h"
+#include "AnimationPlayer.h"
 #include <deque>
 
 class AvatarKilled;
@@ -58,7 +58,10 @@ private:
 	AvatarJumping* m_avatarJumpingState;
 	AvatarWalking*	m_walking;
 
-	Animation* m_currentAnimation;
+	// Without a player of the map, the avatar plays its own
+	AnimationPlayer*	m_animations;
+	bool				m_ownsAnimations;
+	int					m_animation;
 
 	float m_avatarOriginalRadius;
 	fVector2 m_size;
@@ -78,7 +81,7 @@ private:
 public:
 	Avatar(	SpriteInfo* p_spriteInfo, SpriteInfo* p_shadow, Tilemap* p_map, 
 			Tile* p_startTile, GameStats* p_stats, SoundInfo* p_avatarKilledSound, 
-			SoundInfo* p_jumpSound);
+			SoundInfo* p_jumpSound, AnimationPlayer* p_animations = NULL);
 	virtual ~Avatar();
 	void		update(float p_deltaTime, InputInfo p_inputInfo);
 	Tile*		getCurrentTile();
@@ -90,7 +93,10 @@ public:
 	bool		inAir();
 	bool		isDead();
 	void		revive(Tile* p_newPosition);
-	void		setCurrentAnimation(Animation* p_animation);
+	// The states pick the clip, the avatar plays it
+	void		setCurrentAnimation(int p_clip);
+	void		restartAnimation();
+	bool		hasAnimationFinished();
 	fVector2	getPostion();
 	float		getRadius();
 	void		reset();
@@ -15,10 +15,13 @@ AvatarJumping::AvatarJumping(GameObject* p_gameObject, NavigationData* p_navigat
 	m_airTime = 0.5f;
 	int frames = 8;
 	float frac = m_airTime / frames;
-	m_right = new Animation(fVector2(0, 256), 64, 64, frames, frac, true);
-	m_left = new Animation(fVector2(0, 320), 64, 64, frames, frac, true);
-	m_down = new Animation(fVector2(0, 384), 64, 64, frames, frac, true);
-	m_up = new Animation(fVector2(0, 448), 64, 64, frames, frac, true);
+	int sheet = 0;
+	if (p_gameObject && p_gameObject->getSpriteInfo())
+		sheet = p_gameObject->getSpriteInfo()->texturePathId;
+	m_right = AnimationClips::add(sheet, AnimationClip(fVector2(0, 256), 64, 64, frames, frac, true));
+	m_left = AnimationClips::add(sheet, AnimationClip(fVector2(0, 320), 64, 64, frames, frac, true));
+	m_down = AnimationClips::add(sheet, AnimationClip(fVector2(0, 384), 64, 64, frames, frac, true));
+	m_up = AnimationClips::add(sheet, AnimationClip(fVector2(0, 448), 64, 64, frames, frac, true));
 }
 
 void AvatarJumping::checkInput(InputInfo p_inputInfo)
@@ -59,11 +62,6 @@ AvatarJumping::~AvatarJumping()
 {
 	if (m_jumpSound)
 		m_jumpSound->deleted = true;
-
-	delete m_right;
-	delete m_left; 
-	delete m_down; 
-	delete m_up;
 }
 
 int AvatarJumping::onEnter()
@@ -98,8 +96,10 @@ int AvatarJumping::update(float p_dt, InputInfo p_inputInfo)
 			m_navigationData->m_currentTile = m_navigationData->m_nextTile;
 			m_navigationData->m_nextTile = m_navigationData->m_queuedTile;
 
-			m_navigationData->m_queuedTile = m_navigationData->m_map->getTile(m_navigationData->m_nextTile->getTilePosition() + Directions[av->getDirection()]);
-			if (!m_navigationData->m_queuedTile || !m_navigationData->m_queuedTile->isFree())
+			TilePosition queued = m_navigationData->m_nextTile->getTilePosition() + Directions[av->getDirection()];
+			if (m_navigationData->m_map->isFree(queued))
+				m_navigationData->m_queuedTile = m_navigationData->m_map->getTile(queued);
+			else
 				m_navigationData->m_queuedTile = m_navigationData->m_nextTile;
 
 			m_navigationData->m_currentTile->removePill();
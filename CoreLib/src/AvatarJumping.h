@@ -18,10 +18,11 @@ private:
 	//Temp - To visualize jumping
 	fVector2 originalSize;
 
-	Animation* m_left;
-	Animation* m_right;
-	Animation* m_up;
-	Animation* m_down;
+	// Shared clips of the avatar's sheet
+	int m_left;
+	int m_right;
+	int m_up;
+	int m_down;
 
 	float m_airTime;
 
@@ -4,21 +4,24 @@ AvatarKilled::AvatarKilled(GameObject* p_gameObject, SoundInfo* p_avatarKilledSo
 {
 	m_avatarKilledSound = p_avatarKilledSound;
 	m_navigationData = p_navigationData;
-	m_deathAnim = new Animation(fVector2(0, 512), 64, 64, 8, 0.25f);
+	int sheet = 0;
+	if (p_gameObject && p_gameObject->getSpriteInfo())
+		sheet = p_gameObject->getSpriteInfo()->texturePathId;
+	m_deathClip = AnimationClips::add(sheet, AnimationClip(fVector2(0, 512), 64, 64, 8, 0.25f));
 }
 
 AvatarKilled::~AvatarKilled()
 {
 	if(m_avatarKilledSound)
 		m_avatarKilledSound->deleted = true;
-	delete m_deathAnim;
 }
 
 int AvatarKilled::onEnter()
 {
 	Avatar* avatar = (Avatar*)m_gameObject;
 	m_avatarKilledSound->play = true;
-	m_deathAnim->restart();
+	avatar->setCurrentAnimation(m_deathClip);
+	avatar->restartAnimation();
 
 	return GAME_OK;
 }
@@ -32,14 +35,14 @@ int AvatarKilled::onExit()
 	return GAME_OK;
 }
 
-int AvatarKilled::update(float p_dt, InputInfo p_inputInfo)
+// The avatar's animation player advances the death clip
+int AvatarKilled::update(float, InputInfo p_inputInfo)
 {
 	Avatar* av = (Avatar*)m_gameObject;
-	av->setCurrentAnimation(m_deathAnim);
-	m_deathAnim->update(p_dt);
+	av->setCurrentAnimation(m_deathClip);
 	return GAME_OK;
 }
 bool AvatarKilled::hasDied()
 {
-	return m_deathAnim->hasFinished();
+	return ((Avatar*)m_gameObject)->hasAnimationFinished();
 }
\ No newline at end of file
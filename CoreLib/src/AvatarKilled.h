@@ -10,7 +10,7 @@ private:
 	SoundInfo* m_avatarKilledSound;
 	NavigationData* m_navigationData;
 
-	Animation* m_deathAnim;
+	int m_deathClip;
 public:
 	AvatarKilled(GameObject* p_gameObject, SoundInfo* p_avatarKilledSound, NavigationData* p_navigationData);
 	virtual ~AvatarKilled();
@@ -7,18 +7,17 @@ GOState(p_gameObject)
 	m_navigationData = p_navigationData;
 	m_gameStats = p_stats;
 
-	m_right = new Animation(fVector2(0, 0), 64, 64, 8, 0.06f, true);
-	m_left = new Animation(fVector2(0, 64), 64, 64, 8, 0.06f, true);
-	m_down = new Animation(fVector2(0, 128), 64, 64, 8, 0.06f, true);
-	m_up = new Animation(fVector2(0, 192), 64, 64, 8, 0.06f, true);
+	int sheet = 0;
+	if (p_gameObject && p_gameObject->getSpriteInfo())
+		sheet = p_gameObject->getSpriteInfo()->texturePathId;
+	m_right = AnimationClips::add(sheet, AnimationClip(fVector2(0, 0), 64, 64, 8, 0.06f, true));
+	m_left = AnimationClips::add(sheet, AnimationClip(fVector2(0, 64), 64, 64, 8, 0.06f, true));
+	m_down = AnimationClips::add(sheet, AnimationClip(fVector2(0, 128), 64, 64, 8, 0.06f, true));
+	m_up = AnimationClips::add(sheet, AnimationClip(fVector2(0, 192), 64, 64, 8, 0.06f, true));
 }
 
 AvatarWalking::~AvatarWalking()
 {
-	delete m_right;
-	delete m_left; 
-	delete m_down; 
-	delete m_up;
 }
 
 int AvatarWalking::onEnter()
@@ -96,25 +95,23 @@ int AvatarWalking::update(float p_dt, InputInfo p_inputInfo)
 	{
 		if (check180())
 		{
-			Tile* destination = m_navigationData->m_map->getTile(
-				m_navigationData->m_currentTile->getTilePosition() +
-				Directions[m_navigationData->m_desired]);
+			TilePosition destination = m_navigationData->m_currentTile->getTilePosition() +
+				Directions[m_navigationData->m_desired];
 			Tile* temp = m_navigationData->m_currentTile;
 			m_navigationData->m_currentTile = m_navigationData->m_nextTile;
 			m_navigationData->m_nextTile = m_navigationData->m_queuedTile = temp;
-			if (destination && destination->isFree())
-				m_navigationData->m_queuedTile = destination;
+			if (m_navigationData->m_map->isFree(destination))
+				m_navigationData->m_queuedTile = m_navigationData->m_map->getTile(destination);
 			m_navigationData->m_direction = m_navigationData->m_desired;
 			m_navigationData->dt = 1 - m_navigationData->dt;
 		}
 		else
 		{
-			Tile* destination = m_navigationData->m_map->getTile(
-				m_navigationData->m_nextTile->getTilePosition() +
-				Directions[m_navigationData->m_desired]);
-			if (destination && destination->isFree())
+			TilePosition destination = m_navigationData->m_nextTile->getTilePosition() +
+				Directions[m_navigationData->m_desired];
+			if (m_navigationData->m_map->isFree(destination))
 			{
-				m_navigationData->m_queuedTile = destination;
+				m_navigationData->m_queuedTile = m_navigationData->m_map->getTile(destination);
 				m_navigationData->m_direction = m_navigationData->m_desired;
 			}
 		}
@@ -133,11 +130,11 @@ int AvatarWalking::update(float p_dt, InputInfo p_inputInfo)
 			m_navigationData->m_currentTile = m_navigationData->m_nextTile;
 			m_navigationData->m_nextTile = m_navigationData->m_queuedTile;
 
-			m_navigationData->m_queuedTile = m_navigationData->m_map->getTile(
-				m_navigationData->m_nextTile->getTilePosition() +
-				Directions[av->getDirection()]);
-			if (!m_navigationData->m_queuedTile ||
-				!m_navigationData->m_queuedTile->isFree())
+			TilePosition queued = m_navigationData->m_nextTile->getTilePosition() +
+				Directions[av->getDirection()];
+			if (m_navigationData->m_map->isFree(queued))
+				m_navigationData->m_queuedTile = m_navigationData->m_map->getTile(queued);
+			else
 				m_navigationData->m_queuedTile = m_navigationData->m_nextTile;
 
 			m_navigationData->m_currentTile->removePill();
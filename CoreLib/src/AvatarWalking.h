@@ -9,10 +9,11 @@ class AvatarWalking : public GOState
 private:
 	NavigationData* m_navigationData;
 	GameStats* m_gameStats;
-	Animation* m_left;
-	Animation* m_right;
-	Animation* m_up;
-	Animation* m_down;
+	// Shared clips of the avatar's sheet
+	int m_left;
+	int m_right;
+	int m_up;
+	int m_down;
 
 private:
 	void checkInput(InputInfo p_inputInfo);
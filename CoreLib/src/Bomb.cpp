@@ -1,123 +1,184 @@
 #include "Bomb.h"
+#include <algorithm>
 
-Bomb::Bomb(SpriteInfo* p_sprite, vector<pair<Tile*, SpriteInfo*> > p_flames, Tile* p_tile, Tilemap* p_map, SoundInfo* p_tick, SoundInfo* p_blast): GameObject(p_sprite)
+Bomb::Bomb(SpriteInfo* p_sprite, vector<SpriteInfo*> p_flameSprites, Tilemap* p_map, SoundInfo* p_tick, SoundInfo* p_blast):
+	GameObject(p_sprite), m_animation(fVector2(0, 0), 64, 64, 12, 0.12f)
 {
-	m_flameSpawn = p_flames;
 	m_elapsedTime = 0.0f;
 	m_currentDist = 0;
-	m_start = p_tile;
+	m_active = false;
+	m_start = NULL;
+	m_map = p_map;
+	m_nextSpawn = 0;
+
+	// Room for a blast through a whole row and column
+	m_flameSprites = p_flameSprites;
+	m_flameSpawn.reserve(m_flameSprites.size());
+	m_flames.reserve(m_flameSprites.size());
+	for (unsigned int i = 0; i < m_flameSprites.size(); i++)
+	{
+		if (m_flameSprites[i])
+			m_flameSprites[i]->visible = false;
+	}
+	if (m_spriteInfo)
+		m_spriteInfo->visible = false;
 
 	m_countDown = 0;
 	m_tickSound = p_tick;
 	m_tickCounter = 0;
 	m_blastSound = p_blast;
-
-	m_animation = new Animation(fVector2(0, 0), 64, 64, 12, 0.12f);
 }
 Bomb::~Bomb()
 {
-	for ( unsigned int i = 0; i < m_flames.size(); i++ )
-		delete m_flames[i];
-	m_flames.clear();
-	if (m_animation)
-		delete m_animation;
 	if (m_tickSound)
 		m_tickSound->deleted = true;
 	if (m_blastSound)
 		m_blastSound->deleted = true;
 }
+void Bomb::place(SpriteInfo* p_sprite, Tile* p_tile)
+{
+	if (!p_sprite)
+		return;
+	float w = p_tile->getWidth();
+	float h = p_tile->getHeight();
+	TilePosition position = p_tile->getTilePosition();
+	p_sprite->transformInfo.translation[TransformInfo::X] = position.x * w + w * 0.5f;
+	p_sprite->transformInfo.translation[TransformInfo::Y] = position.y * h + h * 0.5f;
+}
+void Bomb::spawn(Tile* p_tile)
+{
+	takeBack();
+	m_active = true;
+	m_start = p_tile;
+	m_elapsedTime = 0;
+	m_currentDist = 0;
+	m_countDown = 0;
+	m_tickCounter = 0;
+	m_animation.restart();
+	place(m_spriteInfo, p_tile);
+	if (m_spriteInfo)
+	{
+		m_spriteInfo->textureRect = m_animation.getCurrentFrame();
+		m_spriteInfo->visible = true;
+	}
+
+	// The bomb's own tile and every free tile in a line from it
+	unsigned int capacity = m_flameSprites.size();
+	if (capacity > 0)
+		m_flameSpawn.push_back(pair<int, Tile*>(0, p_tile));
+	TilePosition dir[] = {TilePosition(1, 0), TilePosition(-1, 0), TilePosition(0, 1), TilePosition(0, -1)};
+	for (int i = 0; i < 4 && m_map; i++)
+	{
+		TilePosition next = p_tile->getTilePosition() + dir[i];
+		int distance = 1;
+		while (m_flameSpawn.size() < capacity && m_map->isFree(next))
+		{
+			m_flameSpawn.push_back(pair<int, Tile*>(distance, m_map->getTile(next)));
+			next = next + dir[i];
+			distance++;
+		}
+	}
+	sort(m_flameSpawn.begin(), m_flameSpawn.end());
+	for (unsigned int i = 0; i < m_flameSpawn.size(); i++)
+		place(m_flameSprites[i], m_flameSpawn[i].second);
+}
 void Bomb::update(float p_deltaTime, InputInfo p_inputInfo)
 {
+	if (!m_active)
+		return;
+
 	if (m_countDown > 1.0f)
 	{
 		if (m_currentDist > 0 && m_countDown > 2.0f)
-			m_spriteInfo->visible = false;
+		{
+			if (m_spriteInfo)
+				m_spriteInfo->visible = false;
+		}
 		else
 		{
-			m_animation->update(p_deltaTime);
-			m_spriteInfo->textureRect = m_animation->getCurrentFrame();
+			m_animation.update(p_deltaTime);
+			if (m_spriteInfo)
+				m_spriteInfo->textureRect = m_animation.getCurrentFrame();
 		}
 		m_elapsedTime += p_deltaTime;
-	
+
 		if (m_elapsedTime > 0.1f)
 		{
 			bool played = false;
-			for ( unsigned int i = 0; i < m_flameSpawn.size(); i++ )
+			while (m_nextSpawn < m_flameSpawn.size() &&
+				m_flameSpawn[m_nextSpawn].first <= m_currentDist)
 			{
-				TilePosition diff = m_flameSpawn[i].first->getTilePosition() - m_start->getTilePosition();
-				int l = abs(diff.x) + abs(diff.y);
-				if (l-m_currentDist <= 0 && l-m_currentDist > -2)
+				// Flames burn out at slightly different times
+				float delay = 0.2f-(rand()%10)*0.005f;
+				m_flames.push_back(Flame(m_flameSprites[m_nextSpawn],
+					m_flameSpawn[m_nextSpawn].second, delay));
+				Flame& flame = m_flames.back();
+				if (m_map)
+					m_map->getHazards()->ignite(flame.getTile()->getTilePosition(), flame.getLifetime());
+				m_nextSpawn++;
+				if (!played)
 				{
-					m_flames.push_back(new Flame(m_flameSpawn[i].second, m_flameSpawn[i].first));
-					m_flameSpawn[i].second->visible = true;
-					m_flameSpawn[i] = m_flameSpawn.back();
-					m_flameSpawn.pop_back();
-					i--;
-					if (!played)
-					{
+					if (m_blastSound)
 						m_blastSound->play = true;
-						played = true;
-					}
+					played = true;
 				}
 			}
 			m_currentDist++;
 			m_elapsedTime -= 0.1f;
 		}
 
+		bool burning = false;
 		for ( unsigned int i = 0; i < m_flames.size(); i++ )
 		{
-			m_flames[i]->update(p_deltaTime);
-			if (m_flames[i]->isDead())
-				m_flames[i]->hide();
+			m_flames[i].update(p_deltaTime);
+			if (m_flames[i].isDead())
+				m_flames[i].hide();
+			else
+				burning = true;
 		}
+
+		// Blast over, the bomb is free to be spawned again
+		if (!burning && m_countDown > 2.0f && m_nextSpawn == m_flameSpawn.size())
+			takeBack();
 	}
 	else
 	{
 		m_tickCounter += p_deltaTime;
-		m_animation->update(p_deltaTime);
+		m_animation.update(p_deltaTime);
 		if(m_spriteInfo != NULL)
-			m_spriteInfo->textureRect = m_animation->getCurrentFrame();
+			m_spriteInfo->textureRect = m_animation.getCurrentFrame();
 		if (m_tickCounter > 0.5f)
 		{
 			m_tickCounter -= 0.5f;
-			m_tickSound->play = true;
+			if (m_tickSound)
+				m_tickSound->play = true;
 		}
 	}
 	m_countDown += p_deltaTime;
 }
-bool Bomb::isColliding(Monster* p_monster)
+bool Bomb::isIdle()
 {
-	for ( unsigned int i = 0; i < m_flames.size(); i++ )
-	{
-		if (!m_flames[i]->isDead())
-		{
-			if (m_flames[i]->getTile() == p_monster->getCurrentTile())
-				return true;
-		}
-	}
-	return false;
-}
-
-bool Bomb::isColliding(Avatar* p_avatar)
-{
-	for ( unsigned int i = 0; i < m_flames.size(); i++ )
-	{
-		if (!m_flames[i]->isDead())
-		{
-			if (m_flames[i]->getTile() == p_avatar->getCurrentTile())
-				return true;
-		}
-	}
-	return false;
+	return !m_active;
 }
 void Bomb::reset()
 {
 	//Kills the bomb
+	for ( unsigned int i = 0; i < m_flames.size() && m_map; i++ )
+		m_map->getHazards()->extinguish(m_flames[i].getTile()->getTilePosition());
+	takeBack();
+}
+void Bomb::takeBack()
+{
 	for ( unsigned int i = 0; i < m_flames.size(); i++ )
-	{
-		m_flames[i]->hide();
-		delete m_flames[i];
-	}
+		m_flames[i].hide();
 	m_flames.clear();
 	m_flameSpawn.clear();
+	m_nextSpawn = 0;
+	m_active = false;
+	if (m_spriteInfo)
+		m_spriteInfo->visible = false;
+}
+int Bomb::getFlameCapacity()
+{
+	return m_flameSprites.size();
 }
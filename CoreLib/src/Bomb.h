@@ -8,72 +8,98 @@
 #include "Avatar.h"
 
 
+// Kept by value in its bomb, so lighting one allocates nothing
 class Flame
 {
 private:
+	static const int FRAMES = 7;
+
 	SpriteInfo* m_spriteInfo;
-	float		m_dt;
-	Animation*	m_animation;
+	float		m_lifetime;
+	Animation	m_animation;
 	Tile*		m_tile;
 public:
-	Flame(SpriteInfo* p_spriteInfo, Tile* p_tile)
+	Flame(SpriteInfo* p_spriteInfo, Tile* p_tile, float p_delay):
+		m_animation(fVector2(0, 0), 64, 64, FRAMES, p_delay)
 	{
 		m_spriteInfo = p_spriteInfo;
-		m_spriteInfo->visible = true;
-		m_dt = 0;
-		m_animation = new Animation(fVector2(0, 0), 64, 64, 7, 0.2f-(rand()%10)*0.005f );
+		if (m_spriteInfo)
+			m_spriteInfo->visible = true;
+		m_lifetime = FRAMES * p_delay;
 		m_tile = p_tile;
 	}
-	virtual ~Flame()
-	{
-		delete m_animation;
-	}
 	void update(float p_elapsedTime)
 	{
-		m_animation->update(p_elapsedTime);
-		m_spriteInfo->textureRect = m_animation->getCurrentFrame();
+		m_animation.update(p_elapsedTime);
+		if (m_spriteInfo)
+			m_spriteInfo->textureRect = m_animation.getCurrentFrame();
 	}
 	bool isDead()
 	{
-		return m_animation->hasFinished();
+		return m_animation.hasFinished();
 	}
 	Tile* getTile()
 	{
 		return m_tile;
 	}
+	// Seconds until the animation has played once
+	float getLifetime()
+	{
+		return m_lifetime;
+	}
 	void hide()
 	{
-		m_spriteInfo->visible = false;
+		if (m_spriteInfo)
+			m_spriteInfo->visible = false;
 	}
 };
 
 //Class that handles a bomb
 //A bomb is an item that can be 
 //placed by the avatar and will explode
+//
+// Bombs are made hidden when the map is loaded, with a flame sprite for
+// every tile their blast can reach, and are placed and taken back again
+// without allocating.
 class Bomb: public GameObject
 {
 private:
-	vector<pair<Tile*, SpriteInfo*> > m_flameSpawn;
-	vector<Flame*> m_flames;
+	// One per tile a blast can reach, lit in the order of m_flameSpawn
+	vector<SpriteInfo*> m_flameSprites;
+	// Tiles and their distance from the bomb, sorted when it is placed so
+	// each step of the blast spawns the next ring
+	vector<pair<int, Tile*> > m_flameSpawn;
+	unsigned int m_nextSpawn;
+	vector<Flame> m_flames;
 	float m_elapsedTime;
 	float m_countDown;
 	float m_tickCounter;
 	int m_currentDist;
+	bool m_active;
 	Tile* m_start;
+	Tilemap* m_map;
 
-	Animation*	m_animation;
+	Animation	m_animation;
 
 	SoundInfo* m_tickSound;
 	SoundInfo* m_blastSound;
+private:
+	void	place(SpriteInfo* p_sprite, Tile* p_tile);
+	// Hides the bomb and frees it, keeping the room for its flames
+	void	takeBack();
 public:
 
-	Bomb(SpriteInfo* p_sprite, vector<pair<Tile*, SpriteInfo*> > p_flames, Tile* p_tile, Tilemap* p_map, SoundInfo* p_tick, SoundInfo* p_blast);
+	Bomb(SpriteInfo* p_sprite, vector<SpriteInfo*> p_flameSprites, Tilemap* p_map, SoundInfo* p_tick, SoundInfo* p_blast);
 
 	virtual ~Bomb();
+	// Puts the bomb on the tile and lights the fuse
+	void	spawn(Tile* p_tile);
 	void	update(float p_deltaTime, InputInfo p_inputInfo);
-	bool	isColliding(Monster* p_monster);
-	bool	isColliding(Avatar* p_avatar);
+	// Takes the bomb back, its flames are put out
 	void	reset();
+	// Until it is spawned and when the blast is over
+	bool	isIdle();
+	int		getFlameCapacity();
 };
 
 #endif
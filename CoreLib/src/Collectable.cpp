@@ -63,6 +63,14 @@ void Collectable::update(float p_deltaTime, InputInfo p_inputInfo)
 			m_container->playOutro(p_deltaTime); // play pick up animation
 	}
 }
+bool Collectable::isIdle()
+{
+	if (!isConsumed())
+		return false;
+	if (m_spriteInfo && m_spriteInfo->visible)
+		return false;
+	return !m_container || m_container->isDone();
+}
 void Collectable::activate()
 {
 
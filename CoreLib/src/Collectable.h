@@ -85,6 +85,11 @@ public:
 
 	}
 
+	bool isDone()
+	{
+		return m_done;
+	}
+
 	void update(float p_dt)
 	{
 		m_elapsedTime+=p_dt;
@@ -115,6 +120,8 @@ public:
 	virtual void consume() = 0;
 	virtual bool isConsumed();
 	virtual void update(float p_deltaTime, InputInfo p_inputInfo);
+	// Once consumed, hidden and the container has played its outro
+	virtual bool isIdle();
 	virtual void activate();
 };
 
@@ -0,0 +1,127 @@
+#include "EntityStore.h"
+
+EntityStore::EntityStore()
+{
+	m_time = 0;
+}
+
+EntityStore::Table& EntityStore::getTable(EntityId p_entity)
+{
+	return m_tables[p_entity >> ROW_BITS];
+}
+
+int EntityStore::getRow(EntityId p_entity)
+{
+	return p_entity & ((1 << ROW_BITS) - 1);
+}
+
+EntityId EntityStore::add(int p_kind, SpriteInfo* p_spriteInfo, TilePosition p_tile)
+{
+	Table& table = m_tables[p_kind];
+	int row = table.sprites.size();
+
+	table.tiles.push_back(p_tile);
+	table.sprites.push_back(p_spriteInfo);
+	table.timers.push_back(0);
+
+	table.activity.add(false);
+	return (p_kind << ROW_BITS) | row;
+}
+
+void EntityStore::clear()
+{
+	for (int kind = 0; kind < EntityKind::COUNT; kind++)
+	{
+		Table& table = m_tables[kind];
+		table.tiles.clear();
+		table.sprites.clear();
+		table.timers.clear();
+		table.activity.clear();
+	}
+}
+
+void EntityStore::update(float p_deltaTime)
+{
+	m_time += p_deltaTime;
+	for (int kind = 0; kind < EntityKind::COUNT; kind++)
+		m_tables[kind].activity.update(p_deltaTime);
+
+	updateSwitches();
+}
+
+float EntityStore::getTime()
+{
+	return m_time;
+}
+
+void EntityStore::updateSwitches()
+{
+	// Woken when pressed or when the cooldown has ended
+	Table& table = m_tables[EntityKind::SWITCH];
+	for (int awake = table.activity.getAwakeCount() - 1; awake >= 0; awake--)
+	{
+		int i = table.activity.getAwake(awake);
+		float cooldown = table.timers[i] - m_time;
+		if (cooldown > 0)
+		{
+			table.sprites[i]->textureRect.x = 64;
+			table.activity.sleepFor(i, cooldown);
+		}
+		else
+		{
+			table.sprites[i]->textureRect.x = 0;
+			table.activity.sleep(i);
+		}
+	}
+}
+
+int EntityStore::getKind(EntityId p_entity)
+{
+	return p_entity >> ROW_BITS;
+}
+
+TilePosition EntityStore::getTile(EntityId p_entity)
+{
+	return getTable(p_entity).tiles[getRow(p_entity)];
+}
+
+SpriteInfo* EntityStore::getSpriteInfo(EntityId p_entity)
+{
+	return getTable(p_entity).sprites[getRow(p_entity)];
+}
+
+float EntityStore::getTimer(EntityId p_entity)
+{
+	return getTable(p_entity).timers[getRow(p_entity)];
+}
+
+void EntityStore::setTimer(EntityId p_entity, float p_time)
+{
+	getTable(p_entity).timers[getRow(p_entity)] = p_time;
+}
+
+void EntityStore::wake(EntityId p_entity)
+{
+	getTable(p_entity).activity.wake(getRow(p_entity));
+}
+
+int EntityStore::getAwakeCount()
+{
+	int count = 0;
+	for (int kind = 0; kind < EntityKind::COUNT; kind++)
+		count += m_tables[kind].activity.getAwakeCount();
+	return count;
+}
+
+int EntityStore::getCount(int p_kind)
+{
+	return m_tables[p_kind].sprites.size();
+}
+
+int EntityStore::getCount()
+{
+	int count = 0;
+	for (int kind = 0; kind < EntityKind::COUNT; kind++)
+		count += getCount(kind);
+	return count;
+}
@@ -0,0 +1,79 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include "Tile.h"
+#include "ActivityList.h"
+#include <vector>
+
+using namespace std;
+
+// Kinds of entity kept in an EntityStore
+namespace EntityKind
+{
+	enum
+	{
+		SWITCH,
+		COUNT
+	};
+}
+
+// Keeps the state of the simple objects on a map in one table per kind,
+// with every component in its own contiguous array. Systems update a whole
+// table in one linear pass instead of a virtual update call per object.
+// Migrated GameObjects stay as adapters that read and write their row
+// through an EntityId. Rows live until the store is cleared with the map.
+//
+// Systems only go through the awake rows of a table. Ready switches sleep
+// until they are pressed or reset, which wakes them directly, and cooling
+// switches until the cooldown ends.
+//
+// Switches are the only kind migrated so far. Traps and wall switches keep
+// no state over time and stay plain objects that sleep, and the plain
+// pills of a map are kept in a PillField.
+class EntityStore
+{
+private:
+	// An id is the kind in the high bits and the row in the low bits
+	static const int ROW_BITS = 24;
+
+	struct Table
+	{
+		vector<TilePosition>	tiles;
+		vector<SpriteInfo*>		sprites;
+		vector<float>			timers;		// End of cooldown
+		ActivityList			activity;
+	};
+
+	Table	m_tables[EntityKind::COUNT];
+	float	m_time;
+
+private:
+	Table&	getTable(EntityId p_entity);
+	int		getRow(EntityId p_entity);
+
+	// Cooldowns are read against the store's clock
+	void	updateSwitches();
+
+public:
+	EntityStore();
+
+	EntityId		add(int p_kind, SpriteInfo* p_spriteInfo, TilePosition p_tile);
+	void			clear();
+	// Runs every system once over the awake rows, replacing the objects'
+	// own update
+	void			update(float p_deltaTime);
+	float			getTime();
+
+	void			wake(EntityId p_entity);
+	int				getAwakeCount();
+
+	int				getKind(EntityId p_entity);
+	TilePosition	getTile(EntityId p_entity);
+	SpriteInfo*		getSpriteInfo(EntityId p_entity);
+	float			getTimer(EntityId p_entity);
+	void			setTimer(EntityId p_entity, float p_time);
+	int				getCount(int p_kind);
+	int				getCount();
+};
+
+#endif
@@ -0,0 +1,217 @@
+#include "FlowField.h"
+#include <algorithm>
+
+FlowField::FlowField(int p_width, int p_height, Tile** p_tiles)
+{
+	m_tiles			= p_tiles;
+	m_width			= p_width;
+	m_height		= p_height;
+	m_target		= NULL;
+	m_chase.resize(p_width * p_height, (int)UNREACHED);
+	m_flee.resize(p_width * p_height, (int)UNREACHED);
+	m_chaseDirty	= false;
+	m_fleeDirty		= false;
+	m_rebuilds		= 0;
+}
+
+int FlowField::indexOf(Tile* p_tile)
+{
+	TilePosition position = p_tile->getTilePosition();
+	return position.y * m_width + position.x;
+}
+
+void FlowField::buildChase()
+{
+	fill(m_chase.begin(), m_chase.end(), (int)UNREACHED);
+	m_chaseDirty = false;
+	m_rebuilds++;
+	if (!m_target)
+		return;
+
+	static const int offsetX[] = {0, 0, 1, -1};
+	static const int offsetY[] = {1, -1, 0, 0};
+
+	m_queue.clear();
+	int start = indexOf(m_target);
+	m_chase[start] = 0;
+	m_queue.push_back(start);
+	for (unsigned int i = 0; i < m_queue.size(); i++)
+	{
+		int current = m_queue[i];
+		int x = current % m_width;
+		int y = current / m_width;
+		for (int j = 0; j < 4; j++)
+		{
+			int nx = x + offsetX[j];
+			int ny = y + offsetY[j];
+			if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height)
+				continue;
+
+			int next = ny * m_width + nx;
+			if (m_chase[next] != UNREACHED || !m_tiles[next]->isFree())
+				continue;
+			m_chase[next] = m_chase[current] + 1;
+			m_queue.push_back(next);
+		}
+	}
+}
+
+void FlowField::buildFlee()
+{
+	if (m_chaseDirty)
+		buildChase();
+	m_fleeDirty = false;
+	m_rebuilds++;
+
+	// Every reached tile is a source, worth more the farther it is from
+	// the target
+	m_open.clear();
+	for (int i = 0; i < m_width * m_height; i++)
+	{
+		if (m_chase[i] == UNREACHED)
+		{
+			m_flee[i] = UNREACHED;
+			continue;
+		}
+		m_flee[i] = -m_chase[i] * FLEE_SCALE;
+		OpenItem item;
+		item.value	= m_flee[i];
+		item.index	= i;
+		m_open.push_back(item);
+	}
+	make_heap(m_open.begin(), m_open.end());
+
+	static const int offsetX[] = {0, 0, 1, -1};
+	static const int offsetY[] = {1, -1, 0, 0};
+
+	while (!m_open.empty())
+	{
+		pop_heap(m_open.begin(), m_open.end());
+		OpenItem item = m_open.back();
+		m_open.pop_back();
+		if (item.value > m_flee[item.index])
+			continue;
+
+		int x = item.index % m_width;
+		int y = item.index / m_width;
+		for (int j = 0; j < 4; j++)
+		{
+			int nx = x + offsetX[j];
+			int ny = y + offsetY[j];
+			if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height)
+				continue;
+
+			int next = ny * m_width + nx;
+			if (m_flee[next] == UNREACHED || m_flee[next] <= item.value + STEP)
+				continue;
+			m_flee[next] = item.value + STEP;
+			OpenItem relaxed;
+			relaxed.value	= m_flee[next];
+			relaxed.index	= next;
+			m_open.push_back(relaxed);
+			push_heap(m_open.begin(), m_open.end());
+		}
+	}
+}
+
+int FlowField::downhill(const vector<int>& p_field, int p_index)
+{
+	static const int offsetX[] = {0, 0, 1, -1};
+	static const int offsetY[] = {1, -1, 0, 0};
+
+	int x = p_index % m_width;
+	int y = p_index / m_width;
+	int best = -1;
+	int bestValue = p_field[p_index];
+	for (int i = 0; i < 4; i++)
+	{
+		int nx = x + offsetX[i];
+		int ny = y + offsetY[i];
+		if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height)
+			continue;
+
+		// The field can be older than the walls, so each step is checked
+		int next = ny * m_width + nx;
+		if (p_field[next] < bestValue && m_tiles[next]->isFree())
+		{
+			best = next;
+			bestValue = p_field[next];
+		}
+	}
+	return best;
+}
+
+void FlowField::setTarget(Tile* p_target)
+{
+	if (p_target == m_target)
+		return;
+	m_target		= p_target;
+	m_chaseDirty	= true;
+	m_fleeDirty		= true;
+}
+
+void FlowField::invalidate()
+{
+	m_chaseDirty	= true;
+	m_fleeDirty		= true;
+}
+
+Tile* FlowField::getChaseStep(Tile* p_from)
+{
+	if (m_chaseDirty)
+		buildChase();
+	int next = downhill(m_chase, indexOf(p_from));
+	return next < 0 ? NULL : m_tiles[next];
+}
+
+Tile* FlowField::getFleeStep(Tile* p_from)
+{
+	if (m_fleeDirty)
+		buildFlee();
+	int next = downhill(m_flee, indexOf(p_from));
+	return next < 0 ? NULL : m_tiles[next];
+}
+
+bool FlowField::getChasePath(Tile* p_from, vector<Tile*>* out_path)
+{
+	if (m_chaseDirty)
+		buildChase();
+	int index = indexOf(p_from);
+	if (m_chase[index] == UNREACHED)
+		return false;
+
+	// Each step lowers the value, so the walk always ends
+	out_path->clear();
+	for (; index >= 0; index = downhill(m_chase, index))
+		out_path->push_back(m_tiles[index]);
+	reverse(out_path->begin(), out_path->end());
+	return true;
+}
+
+bool FlowField::getFleePath(Tile* p_from, vector<Tile*>* out_path)
+{
+	if (m_fleeDirty)
+		buildFlee();
+	int index = indexOf(p_from);
+	if (m_flee[index] == UNREACHED)
+		return false;
+
+	out_path->clear();
+	for (; index >= 0; index = downhill(m_flee, index))
+		out_path->push_back(m_tiles[index]);
+	reverse(out_path->begin(), out_path->end());
+	return true;
+}
+
+int FlowField::getDistance(Tile* p_tile)
+{
+	if (m_chaseDirty)
+		buildChase();
+	int distance = m_chase[indexOf(p_tile)];
+	return distance == UNREACHED ? -1 : distance;
+}
+
+int FlowField::getRebuildCount()
+{
+	return m_rebuilds;
+}
@@ -0,0 +1,81 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "Tile.h"
+#include <vector>
+
+using namespace std;
+
+// Distance fields over the free tiles of a map, shared by every monster
+// that chases or flees from the same target. The chase field holds the
+// number of steps to the target, found with one breadth first search.
+// The flee field starts from the chase distances scaled by -FLEE_SCALE and
+// is relaxed with Dijkstra, so walking downhill leads away from the target
+// without running into dead ends next to it. Both are only rebuilt when
+// the target moves to another tile.
+class FlowField
+{
+private:
+	static const int UNREACHED	= 0x7fffffff;
+	static const int STEP		= 10;
+	static const int FLEE_SCALE	= 12;
+
+	struct OpenItem
+	{
+		int value;
+		int index;
+
+		// Heap order, lowest value first
+		bool operator<(const OpenItem& p_other) const
+		{
+			return value > p_other.value;
+		}
+	};
+
+	Tile**				m_tiles;
+	int					m_width;
+	int					m_height;
+	Tile*				m_target;
+
+	vector<int>			m_chase;
+	vector<int>			m_flee;
+	bool				m_chaseDirty;
+	bool				m_fleeDirty;
+	int					m_rebuilds;
+
+	vector<int>			m_queue;
+	vector<OpenItem>	m_open;
+
+private:
+	void	buildChase();
+	void	buildFlee();
+	int		indexOf(Tile* p_tile);
+	int		downhill(const vector<int>& p_field, int p_index);
+
+public:
+	FlowField(int p_width, int p_height, Tile** p_tiles);
+
+	// Only marks the fields as stale if the target is on another tile
+	void	setTarget(Tile* p_target);
+	// Rebuilds on the next query even if the target hasn't moved,
+	// used when the walkable tiles change
+	void	invalidate();
+
+	// The neighbour to step to, NULL if p_from is the target, a local
+	// minimum of the flee field or can't reach the target
+	Tile*	getChaseStep(Tile* p_from);
+	Tile*	getFleeStep(Tile* p_from);
+
+	// Fill out_path with the tiles from the end back to p_from, laid out
+	// like the paths from Tilemap::findPath. Returns false and leaves
+	// out_path untouched if p_from can't reach the target.
+	bool	getChasePath(Tile* p_from, vector<Tile*>* out_path);
+	bool	getFleePath(Tile* p_from, vector<Tile*>* out_path);
+
+	// Steps from p_tile to the target, -1 if it can't be reached
+	int		getDistance(Tile* p_tile);
+	// Times a field has been built since creation
+	int		getRebuildCount();
+};
+
+#endif
@@ -0,0 +1,141 @@
+#include "FreeTileIndex.h"
+#include <algorithm>
+#include <cstdlib>
+
+FreeTileIndex::FreeTileIndex(int p_width, int p_height, Tile** p_tiles)
+{
+	m_tiles		= p_tiles;
+	m_width		= p_width;
+	m_height	= p_height;
+	m_slots.resize(p_width * p_height, -1);
+	m_nearest.resize(p_width * p_height, -1);
+	m_distances.resize(p_width * p_height, (int)FAR);
+
+	for (int i = 0; i < p_width * p_height; i++)
+	{
+		if (!m_tiles[i]->isFree())
+			continue;
+		m_slots[i] = m_freeTiles.size();
+		m_freeTiles.push_back(i);
+		m_nearest[i] = i;
+		m_distances[i] = 0;
+		m_queue.push_back(i);
+	}
+	spread();
+}
+
+int FreeTileIndex::distance(int p_from, int p_to)
+{
+	int dx = abs(p_from % m_width - p_to % m_width);
+	int dy = abs(p_from / m_width - p_to / m_width);
+	return dx > dy ? dx : dy;
+}
+
+void FreeTileIndex::spread()
+{
+	// A tile's closest walkable tile is also the closest one for the next
+	// tile towards it, so offering it to the eight neighbours reaches
+	// every tile it should win
+	for (unsigned int i = 0; i < m_queue.size(); i++)
+	{
+		int current = m_queue[i];
+		int nearest = m_nearest[current];
+		int x = current % m_width;
+		int y = current / m_width;
+		for (int ny = max(y - 1, 0); ny <= min(y + 1, m_height - 1); ny++)
+		{
+			for (int nx = max(x - 1, 0); nx <= min(x + 1, m_width - 1); nx++)
+			{
+				int next = ny * m_width + nx;
+				int d = distance(next, nearest);
+				if (d < m_distances[next] || (d == m_distances[next] && nearest < m_nearest[next]))
+				{
+					m_distances[next] = d;
+					m_nearest[next] = nearest;
+					m_queue.push_back(next);
+				}
+			}
+		}
+	}
+	m_queue.clear();
+}
+
+void FreeTileIndex::tileChanged(int p_index)
+{
+	bool free = m_tiles[p_index]->isFree();
+	if (free == (m_slots[p_index] >= 0))
+		return;
+
+	if (free)
+	{
+		m_slots[p_index] = m_freeTiles.size();
+		m_freeTiles.push_back(p_index);
+
+		m_nearest[p_index] = p_index;
+		m_distances[p_index] = 0;
+		m_queue.push_back(p_index);
+		spread();
+		return;
+	}
+
+	// Move the last walkable tile into the slot
+	int last = m_freeTiles.back();
+	m_freeTiles[m_slots[p_index]] = last;
+	m_slots[last] = m_slots[p_index];
+	m_freeTiles.pop_back();
+	m_slots[p_index] = -1;
+
+	// The tiles that had this one as closest form a connected area around
+	// it. Forget them, then let the tiles around the area spread into it.
+	vector<int> area(1, p_index);
+	m_nearest[p_index] = -1;
+	m_distances[p_index] = FAR;
+	for (unsigned int i = 0; i < area.size(); i++)
+	{
+		int x = area[i] % m_width;
+		int y = area[i] / m_width;
+		for (int ny = max(y - 1, 0); ny <= min(y + 1, m_height - 1); ny++)
+		{
+			for (int nx = max(x - 1, 0); nx <= min(x + 1, m_width - 1); nx++)
+			{
+				int next = ny * m_width + nx;
+				if (m_nearest[next] == p_index)
+				{
+					m_nearest[next] = -1;
+					m_distances[next] = FAR;
+					area.push_back(next);
+				}
+			}
+		}
+	}
+	for (unsigned int i = 0; i < area.size(); i++)
+	{
+		int x = area[i] % m_width;
+		int y = area[i] / m_width;
+		for (int ny = max(y - 1, 0); ny <= min(y + 1, m_height - 1); ny++)
+		{
+			for (int nx = max(x - 1, 0); nx <= min(x + 1, m_width - 1); nx++)
+			{
+				int next = ny * m_width + nx;
+				if (m_nearest[next] >= 0)
+					m_queue.push_back(next);
+			}
+		}
+	}
+	spread();
+}
+
+int FreeTileIndex::getFreeCount()
+{
+	return m_freeTiles.size();
+}
+
+int FreeTileIndex::getFreeTile(int p_slot)
+{
+	return m_freeTiles[p_slot];
+}
+
+int FreeTileIndex::getNearest(int p_index)
+{
+	return m_nearest[p_index];
+}
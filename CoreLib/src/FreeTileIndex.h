@@ -0,0 +1,50 @@
+#ifndef FREETILEINDEX_H
+#define FREETILEINDEX_H
+
+#include "Tile.h"
+#include <vector>
+
+using namespace std;
+
+// Keeps the walkable tiles of a map in a packed list so a random one can
+// be picked in constant time, and for every tile the closest walkable one.
+// Closeness is counted in square rings around the tile, the larger of the
+// x and y distances, with the lowest tile index winning ties. Both are
+// updated when a single tile changes, without rebuilding the whole map.
+class FreeTileIndex
+{
+private:
+	static const int FAR = 0x7fffffff;
+
+	Tile**		m_tiles;
+	int			m_width;
+	int			m_height;
+
+	vector<int>	m_freeTiles;
+	// Where each tile is in m_freeTiles, -1 if it is blocked
+	vector<int>	m_slots;
+
+	vector<int>	m_nearest;
+	vector<int>	m_distances;
+	vector<int>	m_queue;
+
+private:
+	int		distance(int p_from, int p_to);
+	// Passes nearest tiles on to the neighbours of the tiles in m_queue
+	void	spread();
+
+public:
+	FreeTileIndex(int p_width, int p_height, Tile** p_tiles);
+
+	// Call when the tile at p_index turns walkable or blocked
+	void	tileChanged(int p_index);
+
+	int		getFreeCount();
+	// Tile index of walkable tile number p_slot, in no particular order
+	int		getFreeTile(int p_slot);
+	// Index of the walkable tile closest to p_index, p_index itself if it
+	// is walkable and -1 if no tile is
+	int		getNearest(int p_index);
+};
+
+#endif
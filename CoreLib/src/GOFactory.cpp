@@ -10,7 +10,8 @@ GOFactory::~GOFactory()
 	delete m_tileMapFactory;
 }
 
-Avatar* GOFactory::CreateAvatar(Tilemap* p_map, Tile* p_startTile, GameStats* p_stats)
+Avatar* GOFactory::CreateAvatar(Tilemap* p_map, Tile* p_startTile, GameStats* p_stats,
+	AnimationPlayer* p_animations)
 {
 	fVector3 pos = GetCenter(p_startTile, 0.5f); 
 	fVector2 size = GetScaledSize(p_startTile, 2.0f);
@@ -24,9 +25,11 @@ Avatar* GOFactory::CreateAvatar(Tilemap* p_map, Tile* p_startTile, GameStats* p_
 		pos, size, &r);
 	SpriteInfo* shadow = CreateSpriteInfo("../Textures/playerShadow.png",
 		pos, size, &r);
-	return new Avatar(spriteInfo, shadow, p_map, p_startTile, p_stats, CreateSoundInfo("../Sounds/avatar_killed.wav",100), CreateSoundInfo("../Sounds/jump.wav",50));
+	return new Avatar(spriteInfo, shadow, p_map, p_startTile, p_stats, CreateSoundInfo("../Sounds/avatar_killed.wav",100), CreateSoundInfo("../Sounds/jump.wav",50),
+		p_animations);
 }
-Monster* GOFactory::CreateMonster(Tile* p_tile, Tilemap* p_map, GameStats* p_stats, int p_type)
+Monster* GOFactory::CreateMonster(Tile* p_tile, Tilemap* p_map, GameStats* p_stats, int p_type,
+	AnimationPlayer* p_animations)
 {
 	int type = p_type - (TileTypes::ENEMIESPAWN-30);
 	fVector3 pos = GetCenter(p_tile, 0.2f); 
@@ -45,9 +48,11 @@ Monster* GOFactory::CreateMonster(Tile* p_tile, Tilemap* p_map, GameStats* p_sta
 	SpriteInfo* spriteInfo = CreateSpriteInfo( spriteInfoPath,
 		pos, size, NULL);
 	if(type == 1)
-		return new Rat(p_stats, spriteInfo, p_tile, p_map, CreateSoundInfo("../Sounds/monster_killed_v2.wav",100));
+		return new Rat(p_stats, spriteInfo, p_tile, p_map, CreateSoundInfo("../Sounds/monster_killed_v2.wav",100),
+			p_animations);
 	else if(type == 2)
-		return new InfectedRat(p_stats, spriteInfo, p_tile, p_map, CreateSoundInfo("../Sounds/monster_killed_v2.wav",100));
+		return new InfectedRat(p_stats, spriteInfo, p_tile, p_map, CreateSoundInfo("../Sounds/monster_killed_v2.wav",100),
+			p_animations);
 
 	return NULL;
 }
@@ -112,6 +117,20 @@ Pill* GOFactory::CreatePill(Tile* p_tile, GameStats* p_gameStats)
 	
 	return new Pill(spriteInfo, CreateSoundInfo("../Sounds/new_eat_pill_DRIP.wav",100), p_tile, p_gameStats);
 }
+PillField* GOFactory::CreatePillField(Tilemap* p_map, GameStats* p_gameStats)
+{
+	// One sprite and one sound shared by every pill
+	Tile* tile = p_map->getTile(TilePosition(0, 0));
+	fVector3 pos = GetCenter(tile, 0.1f); 
+	fVector2 size = GetScaledSize(tile, 0.7f);
+
+	SpriteInfo* spriteInfo = CreateSpriteInfo("../Textures/Pill_32.png",
+		pos, size, NULL);
+
+	return new PillField(p_map->getWidth(), p_map->getHeight(), tile->getWidth(),
+		tile->getHeight(), spriteInfo,
+		CreateSoundInfo("../Sounds/new_eat_pill_DRIP.wav",100), p_gameStats);
+}
 BombPill* GOFactory::CreateBombPill(Tile* p_tile, GameStats* p_gameStats)
 {
 	fVector3 pos = GetCenter(p_tile, 0.1f); 
@@ -145,54 +164,38 @@ BombPill* GOFactory::CreateBombPill(Tile* p_tile, GameStats* p_gameStats)
 		CreateSoundInfo("../Sounds/GunCock.wav",100));
 
 }
-Bomb* GOFactory::CreateBomb(Tile* p_tile, Tilemap* p_map)
+Bomb* GOFactory::CreateBomb(Tilemap* p_map)
 {
-	vector<pair<Tile*, SpriteInfo*> > flames;
+	vector<SpriteInfo*> flames;
 
-	fVector3 pos = GetCenter(p_tile, 0.6f); 
-	fVector2 size = GetScaledSize(p_tile, 1.2f);
+	// Sizes are the same on every tile, positions are set when it is placed
+	Tile* tile = p_map->getTile(TilePosition(0, 0));
+	fVector3 pos = GetCenter(tile, 0.6f); 
+	fVector2 size = GetScaledSize(tile, 1.2f);
 	Rect r;
 	r.x = 0;
 	r.y = 0;
 	r.height = 64;
 	r.width = 64;
-	SpriteInfo* spriteInfo = CreateSpriteInfo("../Textures/Explosion_Animation.png",
-		pos, size, &r);
-	flames.push_back(pair<Tile*, SpriteInfo*>(p_tile, spriteInfo));
-
-	TilePosition dir[] = {TilePosition(1, 0), TilePosition(-1, 0), TilePosition(0, 1), TilePosition(0, -1)};
-	for (int i = 0; i < 4; i++)
+	int reach = p_map->getWidth() + p_map->getHeight() - 1;
+	for (int i = 0; i < reach; i++)
 	{
-		Tile* curr = p_map->getTile(p_tile->getTilePosition() + dir[i]);
-		while (curr && curr->isFree())
-		{
-			pos = GetCenter(curr, 0.6f); 
-			size = GetScaledSize(curr, 1.2f);
-
-			r.x = 0;
-			r.y = 0;
-			r.height = 64;
-			r.width = 64;
-			SpriteInfo* spriteInfo = CreateSpriteInfo("../Textures/Explosion_Animation.png",
-				pos, size, &r);
-
-			flames.push_back(pair<Tile*, SpriteInfo*>(curr, spriteInfo));
-			curr = p_map->getTile(curr->getTilePosition() + dir[i]);
-		}
+		flames.push_back(CreateSpriteInfo("../Textures/Explosion_Animation.png",
+			pos, size, &r));
 	}
 
-	pos = GetCenter(p_tile, 0.19f); 
-	size = GetScaledSize(p_tile, 2.0f);
+	pos = GetCenter(tile, 0.19f); 
+	size = GetScaledSize(tile, 2.0f);
 
 	Rect br;
 	br.x = 0;
 	br.y = 0;
 	br.height = 64;
 	br.width = 64;
-	spriteInfo = CreateSpriteInfo("../Textures/bombitem_anim.png",
+	SpriteInfo* spriteInfo = CreateSpriteInfo("../Textures/bombitem_anim.png",
 		pos, size, &br);
 
-	return new Bomb(spriteInfo, flames, p_tile, p_map, CreateSoundInfo("../Sounds/Click.wav",100), CreateSoundInfo("../Sounds/blast_2.wav",100));
+	return new Bomb(spriteInfo, flames, p_map, CreateSoundInfo("../Sounds/Click.wav",100), CreateSoundInfo("../Sounds/blast_2.wav",100));
 }
 
 Tilemap* GOFactory::CreateTileMap(int p_theme, int p_width, int p_height, vector<int> p_mapData)
@@ -206,15 +209,15 @@ Tile* GOFactory::CreateTile(bool p_type, TilePosition p_position, float p_width,
 		p_position.y * p_height + p_height * 0.5f, 0.0f);
 	fVector2 size = fVector2(p_width, p_height);
 	SpriteInfo* spriteInfo = CreateSpriteInfo("../Textures/wall.png",
-		pos, size, NULL);
+		pos, size, NULL, true);
 
 	if (spriteInfo)
 		spriteInfo->visible = !p_type;
 
-	return new Tile(p_type, p_position, p_width, p_height, spriteInfo);
+	return new Tile(p_type, p_position, p_width, p_height, spriteInfo, m_io);
 }
 Switch* GOFactory::CreateSwitch(Tile* p_tile, GameStats* p_gameStats, 
-	vector<WallSwitch*> p_targets, int p_type)
+	vector<WallSwitch*> p_targets, int p_type, EntityStore* p_entities)
 {
 	fVector3 pos = GetCenter(p_tile, 0.1f); 
 	fVector2 size = GetScaledSize(p_tile, 1.7f);
@@ -229,7 +232,8 @@ Switch* GOFactory::CreateSwitch(Tile* p_tile, GameStats* p_gameStats,
 
 	SpriteInfo* spriteInfo = CreateSpriteInfo("../Textures/Switch_Tileset.png",
 		pos, size, &r);
-	return new Switch(spriteInfo, p_tile, p_gameStats, p_targets, CreateSoundInfo("../Sounds/switch.wav",100));
+	return new Switch(spriteInfo, p_tile, p_gameStats, p_targets, CreateSoundInfo("../Sounds/switch.wav",100),
+		p_entities);
 }
 
 WallSwitch* GOFactory::CreateWallSwitch(Tile* p_tile, int p_type)
@@ -252,19 +256,19 @@ WallSwitch* GOFactory::CreateWallSwitch(Tile* p_tile, int p_type)
 }
 
 SpriteInfo* GOFactory::CreateSpriteInfo(string p_texture, fVector3 p_position,
-	fVector2 p_size, Rect* p_sourceRect)
+	fVector2 p_size, Rect* p_sourceRect, bool p_static)
 {
 	if (!m_io)
 		return NULL;
-	SpriteInfo* spriteInfo = new SpriteInfo;
+	SpriteInfo* spriteInfo = m_io->createSpriteInfo(p_texture, p_static);
+	if (!spriteInfo)
+		return NULL;
 	spriteInfo->transformInfo.translation[TransformInfo::X] = p_position.x;
 	spriteInfo->transformInfo.translation[TransformInfo::Y] = p_position.y;
 	spriteInfo->transformInfo.translation[TransformInfo::Z] = p_position.z;
 	spriteInfo->transformInfo.scale[TransformInfo::X] = p_size.x;
 	spriteInfo->transformInfo.scale[TransformInfo::Y] = p_size.y;
-	spriteInfo->textureFilePath = p_texture;
 
-	m_io->addSpriteInfo(spriteInfo);
 	if (p_sourceRect)
 	{
 		spriteInfo->textureRect.x		= p_sourceRect->x;
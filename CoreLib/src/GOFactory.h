@@ -7,6 +7,7 @@
 #include "MenuItem.h"
 #include "Rat.h"
 #include "Pill.h"
+#include "PillField.h"
 #include "SpeedPill.h"
 #include "SuperPill.h"
 #include "Switch.h"
@@ -51,22 +52,31 @@ public:
 	// Mattias: Why private?
 	SoundInfo*	CreateSoundInfo(string p_sound, int p_volume);
 
-	Avatar*		CreateAvatar(Tilemap* p_map, Tile* p_startTile, GameStats* p_stats);
-	Monster*	CreateMonster(Tile* p_tile, Tilemap* p_map, GameStats* p_stats, int p_type);
+	// Given a player, the animations are advanced by it instead of by the
+	// objects themselves
+	Avatar*		CreateAvatar(Tilemap* p_map, Tile* p_startTile, GameStats* p_stats,
+				AnimationPlayer* p_animations = NULL);
+	Monster*	CreateMonster(Tile* p_tile, Tilemap* p_map, GameStats* p_stats, int p_type,
+				AnimationPlayer* p_animations = NULL);
 	Trap*		CreateTrap(Tile* p_tile, Tilemap* p_map);
 
 	SuperPill*	CreateSuperPill(Tile* p_tile, GameStats* p_gameStats);
 	SpeedPill*	CreateSpeedPill(Tile* p_tile, GameStats* p_gameStats);
 	BombPill*	CreateBombPill(Tile* p_tile, GameStats* p_gameStats);
-	Bomb*		CreateBomb(Tile* p_tile, Tilemap* p_map);
+	// A hidden bomb with flame sprites for a whole row and column of the
+	// map, placed later with spawn
+	Bomb*		CreateBomb(Tilemap* p_map);
 	Pill*		CreatePill(Tile* p_tile, GameStats* p_gameStats);
+	// Holds the plain pills of the map, added per tile afterwards
+	PillField*	CreatePillField(Tilemap* p_map, GameStats* p_gameStats);
 
 	Tilemap*	CreateTileMap(int p_theme, int p_width, int p_height, vector<int> p_mapData);
 	Tile*		CreateTile(bool p_type, TilePosition p_position, float p_width,
 				float p_height);
 
 	Switch*		CreateSwitch(Tile* p_tile, GameStats* p_gameStats,
-				vector<WallSwitch*> p_targets, int p_type);
+				vector<WallSwitch*> p_targets, int p_type,
+				EntityStore* p_entities = NULL);
 	
 	WallSwitch* CreateWallSwitch(Tile* p_tile, int p_type);
 
@@ -84,7 +94,7 @@ public:
 	GUI*		CreateGUI(GameStats* p_gameStats);
 
 	SpriteInfo*	CreateSpriteInfo(string p_texture, fVector3 p_position,
-				fVector2 p_size, Rect* p_sourceRect);
+				fVector2 p_size, Rect* p_sourceRect, bool p_static = false);
 
 };
 
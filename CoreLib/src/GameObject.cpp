@@ -8,6 +8,7 @@ GameObject::GameObject()
 	m_gameStats			= NULL;
 	m_basicIdleState	= new BasicIdle(this);
 	m_currentState		= m_basicIdleState;
+	m_entity			= INVALID_ENTITY;
 }
 
 GameObject::GameObject(SpriteInfo* p_spriteInfo)
@@ -16,6 +17,7 @@ GameObject::GameObject(SpriteInfo* p_spriteInfo)
 	m_gameStats			= NULL;
 	m_basicIdleState	= new BasicIdle(this);
 	m_currentState		= m_basicIdleState;
+	m_entity			= INVALID_ENTITY;
 }
 
 GameObject::GameObject(SpriteInfo* p_spriteInfo, GameStats* p_gameStats)
@@ -24,6 +26,7 @@ GameObject::GameObject(SpriteInfo* p_spriteInfo, GameStats* p_gameStats)
 	m_gameStats			= p_gameStats;
 	m_basicIdleState	= new BasicIdle(this);
 	m_currentState		= m_basicIdleState;
+	m_entity			= INVALID_ENTITY;
 }
 
 GameObject::~GameObject()
@@ -60,6 +63,11 @@ void GameObject::reset()
 	// when the Avatar dies. (i.e. reset states etc.)
 }
 
+bool GameObject::isIdle()
+{
+	return false;
+}
+
 //getPosition and getRadius must be updated.
 //they cannot depend on spriteinformation
 fVector2 GameObject::getPostion() 
@@ -84,4 +92,8 @@ float GameObject::getRadius()
 SpriteInfo* GameObject::getSpriteInfo()
 {
 	return m_spriteInfo;
+}
+EntityId GameObject::getEntity()
+{
+	return m_entity;
 }
\ No newline at end of file
@@ -11,6 +11,11 @@
 class GOState;
 class BasicIdle;
 
+// Row of an object kept in an EntityStore. Objects that are not in a store
+// have INVALID_ENTITY and update themselves.
+typedef int EntityId;
+const EntityId INVALID_ENTITY = -1;
+
 class GameObject
 {
 protected:
@@ -19,6 +24,7 @@ protected:
 
 	GOState*	m_currentState;
 	BasicIdle*	m_basicIdleState;
+	EntityId	m_entity;
 
 protected:
 	int switchState(GOState* p_newState, bool p_forceSwitchToSame = false);
@@ -30,9 +36,13 @@ public:
 	virtual			~GameObject();
 	virtual void	update(float p_deltaTime, InputInfo p_inputInfo);
 	virtual void	reset();
+	// True when updating would change nothing until something else happens
+	// to the object, so it can be put to sleep
+	virtual bool	isIdle();
 	virtual fVector2	getPostion();
 	virtual float			getRadius();
 	SpriteInfo*		getSpriteInfo();
+	EntityId		getEntity();
 };
 
 #endif
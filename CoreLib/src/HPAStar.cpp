@@ -0,0 +1,428 @@
+#include "HPAStar.h"
+#include <algorithm>
+#include <cstdlib>
+
+// Openings at least this wide get an entrance at each end
+static const int WIDE_ENTRANCE = 6;
+
+HPAStar::HPAStar(int p_width, int p_height, Tile** p_tiles, int p_clusterSize)
+{
+	m_tiles				= p_tiles;
+	m_width				= p_width;
+	m_height			= p_height;
+	m_clusterSize		= p_clusterSize;
+	m_clustersX			= (p_width + p_clusterSize - 1) / p_clusterSize;
+	m_clustersY			= (p_height + p_clusterSize - 1) / p_clusterSize;
+	m_anyDirty			= false;
+	m_rebuiltClusters	= 0;
+	m_visitId			= 0;
+	m_generation		= 0;
+	m_expanded			= 0;
+
+	int clusters = m_clustersX * m_clustersY;
+	m_clusterNodes.resize(clusters);
+	m_borderNodes.resize(clusters * 2);
+	m_dirty.resize(clusters, false);
+	m_distances.resize(p_width * p_height, 0);
+	m_visited.resize(p_width * p_height, 0);
+
+	for (int i = 0; i < clusters * 2; i++)
+		buildBorder(i);
+	for (int i = 0; i < clusters; i++)
+		buildEdges(i);
+}
+
+int HPAStar::clusterOf(int p_tile)
+{
+	int x = p_tile % m_width;
+	int y = p_tile / m_width;
+	return (y / m_clusterSize) * m_clustersX + x / m_clusterSize;
+}
+
+int HPAStar::addNode(int p_tile, int p_cluster)
+{
+	int index;
+	if (m_freeNodes.empty())
+	{
+		index = m_nodes.size();
+		m_nodes.push_back(Node());
+	}
+	else
+	{
+		index = m_freeNodes.back();
+		m_freeNodes.pop_back();
+	}
+	Node& node		= m_nodes[index];
+	node.tile		= p_tile;
+	node.cluster	= p_cluster;
+	node.twin		= -1;
+	node.edges.clear();
+	m_clusterNodes[p_cluster].push_back(index);
+	return index;
+}
+
+void HPAStar::removeNode(int p_node)
+{
+	Node& node = m_nodes[p_node];
+	vector<int>& nodes = m_clusterNodes[node.cluster];
+	nodes.erase(find(nodes.begin(), nodes.end(), p_node));
+	node.edges.clear();
+	m_freeNodes.push_back(p_node);
+}
+
+void HPAStar::clearBorder(int p_border)
+{
+	for (unsigned int i = 0; i < m_borderNodes[p_border].size(); i++)
+		removeNode(m_borderNodes[p_border][i]);
+	m_borderNodes[p_border].clear();
+}
+
+void HPAStar::buildBorder(int p_border)
+{
+	int cluster = p_border / 2;
+	int cx = cluster % m_clustersX;
+	int cy = cluster / m_clustersX;
+
+	// Tile i along the border is first + i * step, its neighbour in the
+	// other cluster is across more tiles further on
+	int first, step, across, length, other;
+	if (p_border % 2 == 0)
+	{
+		if (cx + 1 >= m_clustersX)
+			return;
+		int y = cy * m_clusterSize;
+		first	= y * m_width + (cx + 1) * m_clusterSize - 1;
+		step	= m_width;
+		across	= 1;
+		length	= min(m_clusterSize, m_height - y);
+		other	= cluster + 1;
+	}
+	else
+	{
+		if (cy + 1 >= m_clustersY)
+			return;
+		int x = cx * m_clusterSize;
+		first	= ((cy + 1) * m_clusterSize - 1) * m_width + x;
+		step	= 1;
+		across	= m_width;
+		length	= min(m_clusterSize, m_width - x);
+		other	= cluster + m_clustersX;
+	}
+
+	vector<int> transitions;
+	int begin = -1;
+	for (int i = 0; i <= length; i++)
+	{
+		int tile = first + i * step;
+		bool open = i < length && m_tiles[tile]->isFree() && m_tiles[tile + across]->isFree();
+		if (open && begin < 0)
+		{
+			begin = i;
+		}
+		else if (!open && begin >= 0)
+		{
+			int end = i - 1;
+			if (end - begin + 1 >= WIDE_ENTRANCE)
+			{
+				transitions.push_back(begin);
+				transitions.push_back(end);
+			}
+			else
+			{
+				transitions.push_back((begin + end) / 2);
+			}
+			begin = -1;
+		}
+	}
+
+	for (unsigned int i = 0; i < transitions.size(); i++)
+	{
+		int tile = first + transitions[i] * step;
+		int inside = addNode(tile, cluster);
+		int outside = addNode(tile + across, other);
+		m_nodes[inside].twin = outside;
+		m_nodes[outside].twin = inside;
+		m_borderNodes[p_border].push_back(inside);
+		m_borderNodes[p_border].push_back(outside);
+	}
+}
+
+void HPAStar::buildEdges(int p_cluster)
+{
+	vector<int>& nodes = m_clusterNodes[p_cluster];
+	for (unsigned int i = 0; i < nodes.size(); i++)
+	{
+		Node& node = m_nodes[nodes[i]];
+		node.edges.clear();
+		searchCluster(node.tile, p_cluster);
+		for (unsigned int j = 0; j < nodes.size(); j++)
+		{
+			int tile = m_nodes[nodes[j]].tile;
+			if (i == j || m_visited[tile] != m_visitId)
+				continue;
+			Edge edge;
+			edge.node = nodes[j];
+			edge.cost = m_distances[tile];
+			node.edges.push_back(edge);
+		}
+	}
+	m_rebuiltClusters++;
+}
+
+void HPAStar::searchCluster(int p_from, int p_cluster)
+{
+	if (++m_visitId == 0)
+	{
+		fill(m_visited.begin(), m_visited.end(), 0);
+		m_visitId = 1;
+	}
+
+	int left	= (p_cluster % m_clustersX) * m_clusterSize;
+	int bottom	= (p_cluster / m_clustersX) * m_clusterSize;
+	int right	= min(left + m_clusterSize, m_width);
+	int top		= min(bottom + m_clusterSize, m_height);
+
+	static const int offsetX[] = {0, 0, 1, -1};
+	static const int offsetY[] = {1, -1, 0, 0};
+
+	m_queue.clear();
+	m_queue.push_back(p_from);
+	m_visited[p_from] = m_visitId;
+	m_distances[p_from] = 0;
+	for (unsigned int i = 0; i < m_queue.size(); i++)
+	{
+		int current = m_queue[i];
+		int x = current % m_width;
+		int y = current / m_width;
+		for (int j = 0; j < 4; j++)
+		{
+			int nx = x + offsetX[j];
+			int ny = y + offsetY[j];
+			if (nx < left || nx >= right || ny < bottom || ny >= top)
+				continue;
+
+			int next = ny * m_width + nx;
+			if (m_visited[next] == m_visitId || !m_tiles[next]->isFree())
+				continue;
+			m_visited[next] = m_visitId;
+			m_distances[next] = m_distances[current] + 1;
+			m_queue.push_back(next);
+		}
+	}
+}
+
+void HPAStar::update()
+{
+	int clusters = m_clustersX * m_clustersY;
+	vector<bool> affected(clusters, false);
+	for (int i = 0; i < clusters; i++)
+	{
+		if (!m_dirty[i])
+			continue;
+		m_dirty[i] = false;
+
+		int cx = i % m_clustersX;
+		int cy = i / m_clustersX;
+		int borders[] = {2 * i, 2 * i + 1, cx > 0 ? 2 * (i - 1) : -1,
+			cy > 0 ? 2 * (i - m_clustersX) + 1 : -1};
+		for (int j = 0; j < 4; j++)
+		{
+			if (borders[j] < 0)
+				continue;
+			clearBorder(borders[j]);
+			buildBorder(borders[j]);
+		}
+
+		// The entrances of the clusters around it may have moved too
+		affected[i] = true;
+		if (cx > 0)
+			affected[i - 1] = true;
+		if (cx + 1 < m_clustersX)
+			affected[i + 1] = true;
+		if (cy > 0)
+			affected[i - m_clustersX] = true;
+		if (cy + 1 < m_clustersY)
+			affected[i + m_clustersX] = true;
+	}
+	for (int i = 0; i < clusters; i++)
+	{
+		if (affected[i])
+			buildEdges(i);
+	}
+	m_anyDirty = false;
+}
+
+int HPAStar::estimate(int p_tile, int p_goal)
+{
+	return abs(p_tile % m_width - p_goal % m_width) +
+		abs(p_tile / m_width - p_goal / m_width);
+}
+
+bool HPAStar::findRoute(Tile* p_start, Tile* p_goal, vector<Tile*>* out_route)
+{
+	if (m_anyDirty)
+		update();
+
+	TilePosition startPosition = p_start->getTilePosition();
+	TilePosition goalPosition = p_goal->getTilePosition();
+	int start = startPosition.y * m_width + startPosition.x;
+	int goal = goalPosition.y * m_width + goalPosition.x;
+	int startCluster = clusterOf(start);
+	int goalCluster = clusterOf(goal);
+	m_expanded = 0;
+
+	if (start == goal)
+	{
+		out_route->clear();
+		out_route->push_back(p_start);
+		return true;
+	}
+	if (startCluster == goalCluster)
+	{
+		searchCluster(start, startCluster);
+		if (m_visited[goal] == m_visitId)
+		{
+			out_route->clear();
+			out_route->push_back(p_goal);
+			out_route->push_back(p_start);
+			return true;
+		}
+	}
+
+	// The goal is node count, reached from the nodes of its cluster
+	int goalNode = m_nodes.size();
+	m_costs.resize(goalNode + 1, 0);
+	m_parents.resize(goalNode + 1, -1);
+	m_states.resize(goalNode + 1, 0);
+	m_goalCosts.resize(goalNode + 1, -1);
+	m_generation += 2;
+	if (m_generation >= 0xfffffffe)
+	{
+		fill(m_states.begin(), m_states.end(), 0);
+		m_generation = 2;
+	}
+	m_open.clear();
+
+	vector<int>& goalNodes = m_clusterNodes[goalCluster];
+	searchCluster(goal, goalCluster);
+	for (unsigned int i = 0; i < goalNodes.size(); i++)
+	{
+		int tile = m_nodes[goalNodes[i]].tile;
+		if (m_visited[tile] == m_visitId)
+			m_goalCosts[goalNodes[i]] = m_distances[tile];
+	}
+
+	vector<int>& startNodes = m_clusterNodes[startCluster];
+	searchCluster(start, startCluster);
+	for (unsigned int i = 0; i < startNodes.size(); i++)
+	{
+		int node = startNodes[i];
+		int tile = m_nodes[node].tile;
+		if (m_visited[tile] != m_visitId)
+			continue;
+		m_costs[node]	= m_distances[tile];
+		m_parents[node]	= -1;
+		m_states[node]	= m_generation;
+		OpenItem item;
+		item.total	= m_costs[node] + estimate(tile, goal);
+		item.node	= node;
+		m_open.push_back(item);
+	}
+	make_heap(m_open.begin(), m_open.end());
+
+	bool found = false;
+	while (!m_open.empty())
+	{
+		pop_heap(m_open.begin(), m_open.end());
+		int current = m_open.back().node;
+		m_open.pop_back();
+		if (current == goalNode)
+		{
+			found = true;
+			break;
+		}
+		if (m_states[current] == m_generation + 1)
+			continue;
+		m_states[current] = m_generation + 1;
+		m_expanded++;
+
+		// The way out of the cluster, then the ways across it and to the goal
+		Node& node = m_nodes[current];
+		int count = node.edges.size();
+		for (int i = -1; i <= count; i++)
+		{
+			int next, cost;
+			if (i < 0)
+			{
+				next = node.twin;
+				cost = 1;
+			}
+			else if (i < count)
+			{
+				next = node.edges[i].node;
+				cost = node.edges[i].cost;
+			}
+			else
+			{
+				if (m_goalCosts[current] < 0)
+					continue;
+				next = goalNode;
+				cost = m_goalCosts[current];
+			}
+			cost += m_costs[current];
+
+			if (m_states[next] == m_generation + 1)
+				continue;
+			if (m_states[next] == m_generation && m_costs[next] <= cost)
+				continue;
+			m_states[next]	= m_generation;
+			m_costs[next]	= cost;
+			m_parents[next]	= current;
+			OpenItem item;
+			item.total	= cost + (next == goalNode ? 0 : estimate(m_nodes[next].tile, goal));
+			item.node	= next;
+			m_open.push_back(item);
+			push_heap(m_open.begin(), m_open.end());
+		}
+	}
+
+	for (unsigned int i = 0; i < goalNodes.size(); i++)
+		m_goalCosts[goalNodes[i]] = -1;
+	if (!found)
+		return false;
+
+	// Nodes in a corner of a cluster can share a tile, it's only added once
+	out_route->clear();
+	out_route->push_back(p_goal);
+	for (int node = m_parents[goalNode]; node != -1; node = m_parents[node])
+	{
+		Tile* tile = m_tiles[m_nodes[node].tile];
+		if (tile != out_route->back())
+			out_route->push_back(tile);
+	}
+	if (p_start != out_route->back())
+		out_route->push_back(p_start);
+	return true;
+}
+
+void HPAStar::tileChanged(Tile* p_tile)
+{
+	TilePosition position = p_tile->getTilePosition();
+	m_dirty[clusterOf(position.y * m_width + position.x)] = true;
+	m_anyDirty = true;
+}
+
+int HPAStar::getNodeCount()
+{
+	return m_nodes.size() - m_freeNodes.size();
+}
+
+int HPAStar::getExpandedCount()
+{
+	return m_expanded;
+}
+
+int HPAStar::getRebuiltClusterCount()
+{
+	return m_rebuiltClusters;
+}
@@ -0,0 +1,110 @@
+#ifndef HPASTAR_H
+#define HPASTAR_H
+
+#include "Tile.h"
+#include <vector>
+
+using namespace std;
+
+// Hierarchical path search for large maps. The map is split into square
+// clusters. Where free tiles meet across a cluster border an entrance is
+// made, one in the middle of short openings and one at each end of long
+// ones, with a node on each side. Nodes in the same cluster are linked
+// with the walking distance between them inside the cluster, so a search
+// only visits entrances and the result is a route of waypoints that can
+// be walked one short segment at a time.
+//
+// When a tile changes its cluster is marked dirty. Before the next search
+// the borders of dirty clusters are scanned again and the links of the
+// clusters around them are measured again, the rest of the graph is kept.
+class HPAStar
+{
+private:
+	struct Edge
+	{
+		int node;
+		int cost;
+	};
+	struct Node
+	{
+		int				tile;
+		int				cluster;
+		int				twin;		// The node on the other side of the border
+		vector<Edge>	edges;
+	};
+	struct OpenItem
+	{
+		int total;
+		int node;
+
+		// Heap order, lowest total first
+		bool operator<(const OpenItem& p_other) const
+		{
+			return total > p_other.total;
+		}
+	};
+
+	Tile**					m_tiles;
+	int						m_width;
+	int						m_height;
+	int						m_clusterSize;
+	int						m_clustersX;
+	int						m_clustersY;
+
+	vector<Node>			m_nodes;
+	vector<int>				m_freeNodes;
+	vector<vector<int> >	m_clusterNodes;
+	// Border 2 * cluster is to the right of the cluster, 2 * cluster + 1
+	// is the one towards higher y
+	vector<vector<int> >	m_borderNodes;
+	vector<bool>			m_dirty;
+	bool					m_anyDirty;
+	int						m_rebuiltClusters;
+
+	// Walking distances inside one cluster, valid where m_visited is
+	// m_visitId
+	vector<int>				m_distances;
+	vector<unsigned int>	m_visited;
+	unsigned int			m_visitId;
+	vector<int>				m_queue;
+
+	// Graph search state per node, valid where m_states is m_generation
+	// (open) or m_generation + 1 (closed)
+	vector<int>				m_costs;
+	vector<int>				m_parents;
+	vector<int>				m_goalCosts;
+	vector<unsigned int>	m_states;
+	unsigned int			m_generation;
+	vector<OpenItem>		m_open;
+	int						m_expanded;
+
+private:
+	int		clusterOf(int p_tile);
+	int		addNode(int p_tile, int p_cluster);
+	void	removeNode(int p_node);
+	void	clearBorder(int p_border);
+	void	buildBorder(int p_border);
+	void	buildEdges(int p_cluster);
+	void	searchCluster(int p_from, int p_cluster);
+	void	update();
+	int		estimate(int p_tile, int p_goal);
+
+public:
+	HPAStar(int p_width, int p_height, Tile** p_tiles, int p_clusterSize);
+
+	// Fills out_route with waypoints from the goal back to the start. Each
+	// waypoint can be reached from the next one without leaving their
+	// cluster, or is its neighbour across a border. Returns false and
+	// leaves out_route untouched if there is no route.
+	bool	findRoute(Tile* p_start, Tile* p_goal, vector<Tile*>* out_route);
+	// Call when a tile turns walkable or blocked
+	void	tileChanged(Tile* p_tile);
+
+	int		getNodeCount();
+	// Nodes expanded by the last search
+	int		getExpandedCount();
+	// Clusters measured again since creation, including the first build
+	int		getRebuiltClusterCount();
+};
+
+#endif
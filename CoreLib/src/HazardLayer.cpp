@@ -0,0 +1,35 @@
+#include "HazardLayer.h"
+
+HazardLayer::HazardLayer(int p_width, int p_height)
+{
+	m_width		= p_width;
+	m_expiry.resize(p_width * p_height, 0);
+	m_time		= 0;
+}
+
+void HazardLayer::update(float p_deltaTime)
+{
+	m_time += p_deltaTime;
+}
+
+void HazardLayer::ignite(TilePosition p_position, float p_duration)
+{
+	float& expiry = m_expiry[p_position.y * m_width + p_position.x];
+	if (expiry < m_time + p_duration)
+		expiry = m_time + p_duration;
+}
+
+void HazardLayer::extinguish(TilePosition p_position)
+{
+	m_expiry[p_position.y * m_width + p_position.x] = m_time;
+}
+
+bool HazardLayer::isBurning(TilePosition p_position)
+{
+	return m_expiry[p_position.y * m_width + p_position.x] > m_time;
+}
+
+float HazardLayer::getTime()
+{
+	return m_time;
+}
@@ -0,0 +1,33 @@
+#ifndef HAZARDLAYER_H
+#define HAZARDLAYER_H
+
+#include "Tile.h"
+#include <vector>
+
+using namespace std;
+
+// The tiles of a map that hurt whatever stands on them. Every tile has the
+// time its hazard ends on the layer's own clock, so checking a tile is a
+// single lookup however many bombs have gone off, and nothing has to be
+// cleaned up when a hazard runs out. Where hazards overlap the one that
+// lasts longest is kept.
+class HazardLayer
+{
+private:
+	int				m_width;
+	vector<float>	m_expiry;
+	float			m_time;
+
+public:
+	HazardLayer(int p_width, int p_height);
+
+	// Moves the clock, call once a frame before the objects update
+	void	update(float p_deltaTime);
+	void	ignite(TilePosition p_position, float p_duration);
+	// Ends the hazard on a tile at once
+	void	extinguish(TilePosition p_position);
+	bool	isBurning(TilePosition p_position);
+	float	getTime();
+};
+
+#endif
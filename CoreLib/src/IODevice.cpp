@@ -2,23 +2,21 @@
 #include <algorithm>
 
 IODevice::IODevice()
+	: m_staticSpritePool(1)
 {
 	m_context=NULL;
+	m_staticLayerDirty = true;
 }
 
 IODevice::~IODevice()
 {	
-	while (!m_spriteInfos.empty())
-	{
-		SpriteInfo* info = m_spriteInfos.back();
-		delete info;
-		m_spriteInfos.pop_back();
-	}
 }
 
 IODevice::IODevice(IOContext* p_context)
+	: m_staticSpritePool(1)
 {
 	m_context = p_context;
+	m_staticLayerDirty = true;
 }
 
 InputInfo IODevice::fetchInput()
@@ -38,11 +36,36 @@ int	IODevice::draw(float p_dt)
 
 	if(m_context)
 	{
+		if (m_staticLayerDirty)
+		{
+			vector<SpriteInfo*> staticSpriteInfos;
+			for (int i = 0; i < m_staticSpritePool.getCount(); i++)
+				staticSpriteInfos.push_back(m_staticSpritePool.getSpriteInfo(i));
+			m_context->buildStaticLayer(staticSpriteInfos);
+			m_staticLayerDirty = false;
+		}
+
 		m_context->beginDraw();
 
-		for(unsigned int spriteIndex = 0; spriteIndex < m_spriteInfos.size(); spriteIndex++)
+		m_context->drawStaticLayer();
+
+		// Sprites are drawn back to front and grouped per texture
+		m_renderQueue.clear();
+		for(int spriteIndex = 0; spriteIndex < m_spritePool.getCount(); spriteIndex++)
 		{
-			m_context->drawSprite(m_spriteInfos[spriteIndex]);
+			SpriteInfo* spriteInfo = m_spritePool.getSpriteInfo(spriteIndex);
+			int texture = spriteInfo->visible ? m_context->getTextureSortId(spriteInfo) : 0;
+			m_renderQueue.add(spriteInfo, texture);
+		}
+		m_renderQueue.sort();
+
+		for(int queueIndex = 0; queueIndex < m_renderQueue.getCount(); queueIndex++)
+		{
+			SpriteInfo* spriteInfo = m_renderQueue.getSpriteInfo(queueIndex);
+			if (spriteInfo->instances)
+				m_context->drawInstances(spriteInfo);
+			else
+				m_context->drawSprite(spriteInfo);
 		}
 
 		m_context->endDraw();
@@ -60,28 +83,60 @@ int IODevice::update(float p_dt)
 	return 0;
 }
 
-void IODevice::addSpriteInfo( SpriteInfo* p_spriteInfo )
+SpriteInfo* IODevice::createSpriteInfo(string p_texture, bool p_static)
 {
-	m_spriteInfos.push_back( p_spriteInfo );
-	m_context->addSprite( p_spriteInfo );
+	SpriteInfo* spriteInfo = NULL;
+	if (p_static)
+	{
+		spriteInfo = m_staticSpritePool.add();
+		m_staticLayerDirty = true;
+	}
+	else
+	{
+		spriteInfo = m_spritePool.add();
+	}
+
+	if (spriteInfo)
+	{
+		spriteInfo->setTexturePath(p_texture);
+		m_context->addSprite( spriteInfo );
+	}
+	return spriteInfo;
 }
 void IODevice::removeSpriteInfo(SpriteInfo* p_spriteInfo)
 {
-	for (unsigned int i = 0; i < m_spriteInfos.size(); i++)
+	// The id is the handle, so no search is needed
+	if (m_spritePool.get(p_spriteInfo->id) == p_spriteInfo)
 	{
-		if (m_spriteInfos[i] == p_spriteInfo)
-		{
-			delete m_spriteInfos[i];
-			m_spriteInfos[i] = m_spriteInfos.back();
-			m_spriteInfos.pop_back();
-		}
+		m_spritePool.remove(p_spriteInfo->id);
+	}
+	else if (m_staticSpritePool.get(p_spriteInfo->id) == p_spriteInfo)
+	{
+		m_staticSpritePool.remove(p_spriteInfo->id);
+		m_staticLayerDirty = true;
 	}
 }
+SpriteInfo* IODevice::getSpriteInfo(SpriteHandle p_handle)
+{
+	SpriteInfo* spriteInfo = m_spritePool.get(p_handle);
+	if (!spriteInfo)
+		spriteInfo = m_staticSpritePool.get(p_handle);
+	return spriteInfo;
+}
 void IODevice::clearSpriteInfos()
 {
-	for (unsigned int i = 0; i < m_spriteInfos.size(); i++)
-		delete m_spriteInfos[i];
-	m_spriteInfos.clear();
+	m_spritePool.clear();
+	m_staticSpritePool.clear();
+	m_staticLayerDirty = true;
+
+	// Scene effects belonged to the cleared sprites
+	toneSceneBlackAndWhite(0);
+	fadeSceneToBlack(0);
+}
+
+void IODevice::invalidateStaticLayer()
+{
+	m_staticLayerDirty = true;
 }
 
 void IODevice::updateSpriteInfo( SpriteInfo* p_spriteInfo )
@@ -120,18 +175,31 @@ void IODevice::setWindowText(string p_text)
 {
 	m_context->setWindowText(p_text);
 }
+int IODevice::getDrawCallCount()
+{
+	if(m_context != NULL)
+		return m_context->getDrawCallCount();
+	else
+		return 0;
+}
+const RenderQueueStats& IODevice::getRenderQueueStats()
+{
+	return m_renderQueue.getStats();
+}
+int IODevice::getTextureBindCount()
+{
+	if(m_context != NULL)
+		return m_context->getTextureBindCount();
+	else
+		return 0;
+}
 void IODevice::toneSceneBlackAndWhite(float p_fraction)
 {
-	for (unsigned int i = 0; i < m_spriteInfos.size(); i++)
-	{
-		m_spriteInfos[i]->bwFraction = p_fraction;
-		//m_spriteInfos[i]->fadeToBlackFraction = p_fraction;
-	}
+	if(m_context != NULL)
+		m_context->setSceneBlackAndWhite(p_fraction);
 }
 void IODevice::fadeSceneToBlack(float p_fraction)
 {
-	for (unsigned int i = 0; i < m_spriteInfos.size(); i++)
-	{
-		m_spriteInfos[i]->fadeToBlackFraction = p_fraction;
-	}
+	if(m_context != NULL)
+		m_context->setSceneFadeToBlack(p_fraction);
 }
@@ -5,6 +5,8 @@
 #include "IOContext.h"
 #include "InputInfo.h"
 #include "SpriteInfo.h"
+#include "RenderQueue.h"
+#include "SpritePool.h"
 #include <SoundManager.h>
 
 
@@ -17,7 +19,10 @@ class IODevice
 private:
 	IOContext*			m_context;
 	SoundManager		m_soundManager;
-	vector<SpriteInfo*>	m_spriteInfos;
+	SpritePool			m_spritePool;
+	SpritePool			m_staticSpritePool;
+	bool				m_staticLayerDirty;
+	RenderQueue			m_renderQueue;
 
 public:
 				IODevice();
@@ -30,17 +35,28 @@ public:
 	int			update(float p_dt);
 	bool		isRunning();
 
-	void		addSpriteInfo( SpriteInfo* p_spriteInfo );
+	// Sprites are owned by the device and live until they are removed or
+	// cleared. A sprite's id is its handle, which getSpriteInfo resolves
+	// to NULL once the sprite is gone.
+	SpriteInfo*	createSpriteInfo(string p_texture, bool p_static = false);
 	void		removeSpriteInfo(SpriteInfo* p_spriteInfo);
+	SpriteInfo*	getSpriteInfo(SpriteHandle p_handle);
 	void		updateSpriteInfo( SpriteInfo* p_spriteInfo );
 	void		clearSpriteInfos();
 
+	// Static sprites are baked into a layer by the context. Call
+	// invalidateStaticLayer when one of them changes.
+	void		invalidateStaticLayer();
+
 	void		addSound(SoundInfo* p_soundInfo);
 	void		addSong(SoundInfo* p_song);
 
 	int			getScreenWidth();
 	int			getScreenHeight();
 	void		setWindowText(string p_text);
+	int			getDrawCallCount();
+	int			getTextureBindCount();
+	const RenderQueueStats& getRenderQueueStats();
 
 	void		toneSceneBlackAndWhite(float p_fraction);
 	void		fadeSceneToBlack(float p_fraction);
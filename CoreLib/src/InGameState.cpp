@@ -20,6 +20,12 @@ InGameState::InGameState(StateManager* p_parent, IODevice* p_io, vector<MapData>
 	m_clock = NULL;
 	m_defeat = NULL;
 	m_victory = NULL;
+	m_monsterGrid = NULL;
+	m_trapGrid = NULL;
+	m_entities = NULL;
+	m_pills = NULL;
+	m_animations = NULL;
+	m_collisionPairs = 0;
 }
 InGameState::~InGameState()
 {
@@ -58,8 +64,17 @@ bool InGameState::onExit()
 				delete m_gameObjects.at(i);
 			}
 			m_gameObjects.clear();
+			m_tickedObjects.clear();
+			m_activity.clear();
+			delete m_entities;
+			m_entities = NULL;
+			delete m_pills;
+			m_pills = NULL;
+			delete m_animations;
+			m_animations = NULL;
 			if (m_tileMap)
 				delete m_tileMap;
+			deleteCollisionGrids();
 			if (m_stats)
 				delete m_stats;
 			if (m_gui)
@@ -142,10 +157,18 @@ void InGameState::update(float p_dt)
 		}
 		else
 		{
-			for (unsigned int index = 0; index < m_gameObjects.size(); index++)
+			m_tileMap->getHazards()->update(p_dt);
+			m_entities->update(p_dt);
+			m_pills->update(p_dt);
+			m_activity.update(p_dt);
+			for (int index = m_activity.getAwakeCount() - 1; index >= 0; index--)
 			{
-				m_gameObjects[index]->update(p_dt, input);
+				int id = m_activity.getAwake(index);
+				m_tickedObjects[id]->update(p_dt, input);
+				if (m_tickedObjects[id]->isIdle())
+					m_activity.sleep(id);
 			};
+			m_animations->update(p_dt);
 
 			checkAndResolveDynamicCollision();
 
@@ -156,9 +179,15 @@ void InGameState::update(float p_dt)
 				m_stats->update(p_dt, input);
 				if (m_stats->getActivatedItem() == 0)
 				{
-					Bomb* b = m_factory->CreateBomb(m_avatar->getClosestTile(), m_tileMap); 
-					m_bombs.push_back(b);
-					m_gameObjects.push_back(b);
+					for (unsigned int i = 0; i < m_bombs.size(); i++)
+					{
+						if (m_bombs[i]->isIdle())
+						{
+							m_bombs[i]->spawn(m_avatar->getClosestTile());
+							m_activity.wake(m_bombIds[i]);
+							break;
+						}
+					}
 				}
 				if (m_stats->getGameTimer()->getElapsedTime() < 2)
 				{
@@ -184,7 +213,17 @@ void InGameState::update(float p_dt)
 
 			ss << elapsed;
 
-			string text = "Elapsed Game Time: " + ss.str() + " seconds. FPS: " + toString(1.0f / p_dt);
+			string text = "Elapsed Game Time: " + ss.str() + " seconds. FPS: " + toString(1.0f / p_dt) +
+				" Draw calls: " + toString(m_io->getDrawCallCount()) +
+				" Texture binds: " + toString(m_io->getTextureBindCount()) +
+				" Sprites: " + toString(m_io->getRenderQueueStats().queued) +
+				" (" + toString(m_io->getRenderQueueStats().culled) + " hidden)" +
+				" Path cache: " + toString(m_tileMap->getPathCache()->getHits()) + " hits, " +
+				toString(m_tileMap->getPathCache()->getMisses()) + " misses, " +
+				toString(m_tileMap->getUnreachableCount()) + " unreachable" +
+				" Collision pairs: " + toString(m_collisionPairs) +
+				" Awake: " + toString(m_activity.getAwakeCount() + m_entities->getAwakeCount()) +
+				"/" + toString(m_activity.getCount() + m_entities->getCount());
 
 			m_io->setWindowText(text);
 
@@ -197,6 +236,8 @@ void InGameState::update(float p_dt)
 					{
 						m_gameObjects[i]->reset();
 					}
+					for (unsigned int i = 0; i < m_tickedObjects.size(); i++)
+						m_activity.wake(i);
 
 					m_avatar->revive(m_startTile);
 				}
@@ -238,52 +279,94 @@ void InGameState::draw(float p_dt)
 {
 }
 
+void InGameState::createCollisionGrids()
+{
+	if (!m_tileMap)
+		return;
+	Tile* tile = m_tileMap->getTile(TilePosition(0, 0));
+	int width = m_tileMap->getWidth();
+	int height = m_tileMap->getHeight();
+	m_monsterGrid = new SpatialGrid(width, height, tile->getWidth(), tile->getHeight());
+	m_trapGrid = new SpatialGrid(width, height, tile->getWidth(), tile->getHeight());
+
+	m_trapReach = 0;
+	for (unsigned int index = 0; index < m_traps.size(); index++)
+	{
+		m_trapGrid->add(m_traps[index]->getPostion(), index);
+		m_trapReach = max(m_trapReach, m_traps[index]->getRadius() / 8);
+	}
+}
+
+void InGameState::deleteCollisionGrids()
+{
+	delete m_monsterGrid;
+	delete m_trapGrid;
+	m_monsterGrid = NULL;
+	m_trapGrid = NULL;
+}
+
 void InGameState::checkAndResolveDynamicCollision()
 {
 	Circle avatarBC(m_avatar->getPostion(), m_avatar->getRadius() / 4);
+	m_collisionPairs = 0;
 
+	// Only objects in the cells within reach of each other are tested
+	float monsterReach = 0;
+	m_monsterGrid->clear();
 	for(unsigned int index = 0; index < m_monsters.size(); index++)
 	{
-		Monster* monster = m_monsters.at(index);
-		if (!monster->isDead())
+		if (!m_monsters[index]->isDead())
 		{
-			Circle monsterBC(monster->getPostion(),monster->getRadius() / 4);
-
-			if(avatarBC.collidesWith(monsterBC))
-			{
-				if (m_stats->isSuperMode())
-				{
-					monster->kill();
-					m_stats->addScore(MONSTER_KILLED);
-				}
-				else
-					m_avatar->kill();
-			}
+			m_monsterGrid->add(m_monsters[index]->getPostion(), index);
+			monsterReach = max(monsterReach, m_monsters[index]->getRadius() / 4);
 		}
-		for (unsigned int bomb = 0; bomb < m_bombs.size(); bomb++)
+	}
+	m_nearby.clear();
+	m_monsterGrid->query(m_avatar->getPostion(), m_avatar->getRadius() / 4 + monsterReach,
+		&m_nearby);
+	for(unsigned int index = 0; index < m_nearby.size(); index++)
+	{
+		Monster* monster = m_monsters.at(m_nearby[index]);
+		Circle monsterBC(monster->getPostion(),monster->getRadius() / 4);
+		m_collisionPairs++;
+
+		if(avatarBC.collidesWith(monsterBC))
 		{
-			if (m_bombs[bomb]->isColliding(monster) && !monster->isDead())
+			if (m_stats->isSuperMode())
 			{
 				monster->kill();
 				m_stats->addScore(MONSTER_KILLED);
 			}
+			else
+				m_avatar->kill();
 		}
 	}
 
-	for (unsigned int bomb = 0; bomb < m_bombs.size(); bomb++)
+	// Flames hit whatever stands on their tile
+	HazardLayer* hazards = m_tileMap->getHazards();
+	for(unsigned int index = 0; index < m_monsters.size(); index++)
 	{
-		if (m_bombs[bomb]->isColliding(m_avatar))
+		Monster* monster = m_monsters.at(index);
+		if (!monster->isDead() && hazards->isBurning(monster->getCurrentTile()->getTilePosition()))
 		{
-			m_avatar->kill();
+			monster->kill();
+			m_stats->addScore(MONSTER_KILLED);
 		}
 	}
 
+	if (hazards->isBurning(m_avatar->getCurrentTile()->getTilePosition()))
+		m_avatar->kill();
+
 	if (!m_avatar->inAir())
 	{
-		for(unsigned int index = 0; index < m_traps.size(); index++)
+		m_nearby.clear();
+		m_trapGrid->query(m_avatar->getPostion(), m_avatar->getRadius() / 4 + m_trapReach,
+			&m_nearby);
+		for(unsigned int index = 0; index < m_nearby.size(); index++)
 		{
-			Trap* trap = m_traps.at(index);
+			Trap* trap = m_traps.at(m_nearby[index]);
 			Circle trapBC(trap->getPostion(),trap->getRadius() / 8);
+			m_collisionPairs++;
 
 			if(avatarBC.collidesWith(trapBC))
 			{
@@ -332,6 +415,18 @@ void InGameState::checkAndResolveStaticCollision()
 				collectableAheadOfAvatar->consume();
 			}
 		}
+		else if( m_pills->hasPill( tilePositionAheadOfAvatar ) )
+		{
+			Circle avatarBC(m_avatar->getPostion(), m_avatar->getRadius() / 4);
+
+			Circle pillBC(m_pills->getPosition(tilePositionAheadOfAvatar),
+				m_pills->getRadius() / 4);
+
+			if( avatarBC.collidesWith( pillBC ) )
+			{
+				tileAheadOfAvatar->removePill();
+			}
+		}
 
 	}
 
@@ -354,13 +449,23 @@ void InGameState::restart()
 			}
 		}
 		m_gameObjects.clear();
+		m_tickedObjects.clear();
+		m_activity.clear();
+		delete m_entities;
+		m_entities = NULL;
+		delete m_pills;
+		m_pills = NULL;
+		delete m_animations;
+		m_animations = NULL;
 		m_monsters.clear();
 		m_bombs.clear();
+		m_bombIds.clear();
 		if (m_tileMap)
 		{
 			delete m_tileMap;
 			m_tileMap = NULL;
 		}
+		deleteCollisionGrids();
 		if (m_gui)
 		{
 			delete m_gui;
@@ -385,11 +490,33 @@ void InGameState::restart()
 
 		m_tileMap = mapParser.getTileMap();
 		m_gameObjects = mapParser.getGameObjects();
+		m_entities = mapParser.getEntities();
+		m_pills = mapParser.getPills();
+		m_animations = mapParser.getAnimations();
+		for (unsigned int i = 0; i < m_gameObjects.size(); i++)
+		{
+			if (m_gameObjects[i]->getEntity() == INVALID_ENTITY)
+			{
+				m_tickedObjects.push_back(m_gameObjects[i]);
+				m_activity.add(true);
+			}
+		}
+		// Bombs start awake so waking them later never grows the list, they
+		// sleep after their first update
+		m_bombs = mapParser.getBombs();
+		for (unsigned int i = 0; i < m_bombs.size(); i++)
+		{
+			m_gameObjects.push_back(m_bombs[i]);
+			m_bombIds.push_back(m_tickedObjects.size());
+			m_tickedObjects.push_back(m_bombs[i]);
+			m_activity.add(true);
+		}
 		m_avatar = mapParser.getAvatar();
 		m_monsters = mapParser.getMonsters();
 		m_traps = mapParser.getTraps();
 		m_gui = mapParser.getGUI();
 		m_paused = false;
+		createCollisionGrids();
 
 		if (m_avatar)
 			m_startTile = m_avatar->getCurrentTile();
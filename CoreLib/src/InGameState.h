@@ -6,16 +6,28 @@
 #include "MapHeader.h"
 #include "TextArea.h"
 #include "HighScore.h"
+#include "SpatialGrid.h"
+#include "EntityStore.h"
+#include "ActivityList.h"
 
 class InGameState: public State
 {
 private:
 	IODevice*				m_io;
 	vector<GameObject*>		m_gameObjects;
+	// Objects that are not in the entity store and update themselves. Only
+	// the awake ones are updated, idle objects sleep until the avatar dies.
+	vector<GameObject*>		m_tickedObjects;
+	ActivityList			m_activity;
+	EntityStore*			m_entities;
+	PillField*				m_pills;
+	AnimationPlayer*		m_animations;
 	Avatar*					m_avatar;
 	vector<Monster*>		m_monsters;
 	vector<Trap*>			m_traps;
+	// Made with the map, a free one is spawned when the item is used
 	vector<Bomb*>			m_bombs;
+	vector<int>				m_bombIds;	// In the activity list
 	GOFactory*				m_factory;
 	GUI*					m_gui;
 
@@ -31,6 +43,15 @@ private:
 
 	bool					m_paused;
 
+	// Buckets for the dynamic collision tests. Monsters are added again
+	// every frame, traps when the map is loaded.
+	SpatialGrid*			m_monsterGrid;
+	SpatialGrid*			m_trapGrid;
+	float					m_trapReach;
+	vector<int>				m_nearby;
+	// Object pairs tested by the last collision check
+	int						m_collisionPairs;
+
 	//Music
 	SoundInfo*				m_backgroundMusic;
 
@@ -43,6 +64,8 @@ private:
 private:
 	void updateOnVictory(float p_dt, InputInfo p_input);
 	void updateOnDefeat(float p_dt, InputInfo p_input);
+	void createCollisionGrids();
+	void deleteCollisionGrids();
 public:
 	InGameState(StateManager* p_parent, IODevice* p_io, vector<MapData> p_maps,
 		bool p_reset = false);
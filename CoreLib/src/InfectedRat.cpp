@@ -1,8 +1,8 @@
 #include "InfectedRat.h"
 
 InfectedRat::InfectedRat(GameStats* p_gameStats, SpriteInfo* p_spriteInfo, Tile* p_tile, Tilemap* p_map,
-					SoundInfo* p_monsterKilledSound)
-	: Monster(p_gameStats, p_spriteInfo)
+					SoundInfo* p_monsterKilledSound, AnimationPlayer* p_animations)
+	: Monster(p_gameStats, p_spriteInfo, p_animations)
 {
 	dt = 0;
 	m_startTile = m_currentTile = m_nextTile = p_tile;
@@ -13,12 +13,7 @@ InfectedRat::InfectedRat(GameStats* p_gameStats, SpriteInfo* p_spriteInfo, Tile*
 
 	m_monsterKilledSound = p_monsterKilledSound;
 
-	m_right = new Animation(fVector2(0, 0), 100, 100, 4, 0.1f, true);
-	m_left = new Animation(fVector2(0, 100), 100, 100, 4, 0.1f, true);
-	m_down = new Animation(fVector2(0, 200), 100, 100, 4, 0.1f, true);
-	m_up = new Animation(fVector2(0, 300), 100, 100, 4, 0.1f, true);
-
-	m_currentAnimation = m_down;
+	initAnimations(100, 4, 0.1f);
 	m_rushing = false;
 	m_rushCooldown = 0;
 
@@ -58,6 +53,7 @@ void InfectedRat::update(float p_deltaTime, InputInfo p_inputInfo)
 			if (m_currentTile)
 			{
 				m_currentTile = m_nextTile;
+				refinePath();
 				if (m_path.size() > 0)
 				{
 					if (m_path.back()->isFree())
@@ -74,15 +70,9 @@ void InfectedRat::update(float p_deltaTime, InputInfo p_inputInfo)
 				{
 					if(m_path.size() == 0)
 					{
-						Tile* t;
-						do
-						{
-							int rndX = rand() % m_map->getWidth();
-							int rndY = rand() % m_map->getHeight();
-							t = m_map->getTile(TilePosition(rndX, rndY));					
-						} while (!t->isFree());
-
-						FindPath(m_currentTile, t);
+						Tile* t = m_map->randomFreeTile();
+						if (t)
+							FindPath(m_currentTile, t);
 						m_rushing = false;
 					}
 				}
@@ -94,12 +84,7 @@ void InfectedRat::update(float p_deltaTime, InputInfo p_inputInfo)
 		determineAnimation();
 		transformSpriteInformation();
 
-		if (m_currentAnimation)
-		{
-			if (m_currentTile != m_nextTile)
-				m_currentAnimation->update(p_deltaTime);
-			m_spriteInfo->textureRect = m_currentAnimation->getCurrentFrame();
-		}
+		updateAnimation(p_deltaTime, m_currentTile != m_nextTile);
 
 		if (m_timeSinceSpawn < SPAWNTIME)
 		{
@@ -108,13 +93,14 @@ void InfectedRat::update(float p_deltaTime, InputInfo p_inputInfo)
 			m_spriteInfo->transformInfo.scale[TransformInfo::Y] = m_size.y * frac;
 		}
 
-		if (m_currentAnimation == m_right)
+		int clip = m_animations->getClip(m_animation);
+		if (clip == m_right)
 			m_offset = fVector2(m_size.x*0.15f, m_size.y*0.1f);
-		else if (m_currentAnimation == m_left)
+		else if (clip == m_left)
 			m_offset = fVector2(-m_size.x*0.15f, m_size.y*0.1f);
-		else if (m_currentAnimation == m_up)
+		else if (clip == m_up)
 			m_offset = fVector2(0, m_size.y*0.15f);
-		else if (m_currentAnimation == m_down)
+		else if (clip == m_down)
 			m_offset = fVector2(0, -m_size.y*0.15f);
 		m_spriteInfo->transformInfo.translation[TransformInfo::X] += m_offset.x;
 		m_spriteInfo->transformInfo.translation[TransformInfo::Y] += m_offset.y;
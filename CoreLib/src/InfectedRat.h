@@ -17,7 +17,7 @@ private:
 	fVector2 m_offset;
 public:
 	InfectedRat(GameStats* p_gameStats, SpriteInfo* p_spriteInfo, Tile* p_tile, Tilemap* p_map,
-			SoundInfo* p_monsterKilled);
+			SoundInfo* p_monsterKilled, AnimationPlayer* p_animations = NULL);
 	virtual ~InfectedRat();
 	void	update(float p_deltaTime, InputInfo p_inputInfo);
 	void	reset();
@@ -0,0 +1,196 @@
+#include "JumpPointSearch.h"
+#include <algorithm>
+#include <cstdlib>
+
+JumpPointSearch::JumpPointSearch(int p_width, int p_height, Tile** p_tiles)
+{
+	m_tiles			= p_tiles;
+	m_width			= p_width;
+	m_height		= p_height;
+	m_goal			= -1;
+	m_costs.resize(p_width * p_height, 0);
+	m_parents.resize(p_width * p_height, -1);
+	m_states.resize(p_width * p_height, 0);
+	m_generation	= 0;
+	m_expanded		= 0;
+}
+
+bool JumpPointSearch::isFree(int p_x, int p_y)
+{
+	if (p_x < 0 || p_x >= m_width || p_y < 0 || p_y >= m_height)
+		return false;
+	return m_tiles[p_y * m_width + p_x]->isFree();
+}
+
+int JumpPointSearch::jumpHorizontal(int p_x, int p_y, int p_dx)
+{
+	while (true)
+	{
+		int previous = p_x;
+		p_x += p_dx;
+		if (!isFree(p_x, p_y))
+			return -1;
+		int index = p_y * m_width + p_x;
+		if (index == m_goal)
+			return index;
+
+		// Turning here is only shorter if it couldn't be done a step earlier
+		if ((isFree(p_x, p_y + 1) && !isFree(previous, p_y + 1)) ||
+			(isFree(p_x, p_y - 1) && !isFree(previous, p_y - 1)))
+		{
+			return index;
+		}
+	}
+}
+
+int JumpPointSearch::jumpVertical(int p_x, int p_y, int p_dy)
+{
+	while (true)
+	{
+		p_y += p_dy;
+		if (!isFree(p_x, p_y))
+			return -1;
+		int index = p_y * m_width + p_x;
+		if (index == m_goal)
+			return index;
+
+		// Vertical moves can always turn, so stop if a turn leads anywhere
+		if (jumpHorizontal(p_x, p_y, 1) >= 0 || jumpHorizontal(p_x, p_y, -1) >= 0)
+			return index;
+	}
+}
+
+int JumpPointSearch::estimate(int p_index)
+{
+	return abs(p_index % m_width - m_goal % m_width) +
+		abs(p_index / m_width - m_goal / m_width);
+}
+
+void JumpPointSearch::addJumpPoint(int p_from, int p_index)
+{
+	if (p_index < 0 || m_states[p_index] == m_generation + 1)
+		return;
+
+	// Jump points are on a straight line from where they were found
+	int cost = m_costs[p_from] + abs(p_index % m_width - p_from % m_width) +
+		abs(p_index / m_width - p_from / m_width);
+	if (m_states[p_index] == m_generation && m_costs[p_index] <= cost)
+		return;
+
+	m_states[p_index]	= m_generation;
+	m_costs[p_index]	= cost;
+	m_parents[p_index]	= p_from;
+	OpenItem item;
+	item.estimate	= estimate(p_index);
+	item.total		= cost + item.estimate;
+	item.index		= p_index;
+	m_open.push_back(item);
+	push_heap(m_open.begin(), m_open.end());
+}
+
+bool JumpPointSearch::findPath(Tile* p_start, Tile* p_goal, vector<Tile*>* out_path)
+{
+	TilePosition startPosition = p_start->getTilePosition();
+	TilePosition goalPosition = p_goal->getTilePosition();
+	int start = startPosition.y * m_width + startPosition.x;
+	m_goal = goalPosition.y * m_width + goalPosition.x;
+
+	m_generation += 2;
+	if (m_generation >= 0xfffffffe)
+	{
+		fill(m_states.begin(), m_states.end(), 0);
+		m_generation = 2;
+	}
+	m_open.clear();
+	m_expanded = 0;
+
+	m_costs[start]		= 0;
+	m_parents[start]	= -1;
+	m_states[start]		= m_generation;
+	OpenItem first;
+	first.estimate	= estimate(start);
+	first.total		= first.estimate;
+	first.index		= start;
+	m_open.push_back(first);
+
+	bool found = false;
+	while (!m_open.empty())
+	{
+		pop_heap(m_open.begin(), m_open.end());
+		int current = m_open.back().index;
+		m_open.pop_back();
+		if (m_states[current] == m_generation + 1)
+			continue;
+		if (current == m_goal)
+		{
+			found = true;
+			break;
+		}
+		m_states[current] = m_generation + 1;
+		m_expanded++;
+
+		int x = current % m_width;
+		int y = current / m_width;
+		int parent = m_parents[current];
+		int dx = 0, dy = 0;
+		if (parent >= 0)
+		{
+			int px = parent % m_width;
+			int py = parent / m_width;
+			dx = (x > px) - (x < px);
+			dy = (y > py) - (y < py);
+		}
+
+		if (parent < 0)
+		{
+			addJumpPoint(current, jumpHorizontal(x, y, 1));
+			addJumpPoint(current, jumpHorizontal(x, y, -1));
+			addJumpPoint(current, jumpVertical(x, y, 1));
+			addJumpPoint(current, jumpVertical(x, y, -1));
+		}
+		else if (dx != 0)
+		{
+			// Arrived along a row, turns are only kept where they are forced
+			addJumpPoint(current, jumpHorizontal(x, y, dx));
+			if (isFree(x, y + 1) && !isFree(x - dx, y + 1))
+				addJumpPoint(current, jumpVertical(x, y, 1));
+			if (isFree(x, y - 1) && !isFree(x - dx, y - 1))
+				addJumpPoint(current, jumpVertical(x, y, -1));
+		}
+		else
+		{
+			addJumpPoint(current, jumpVertical(x, y, dy));
+			addJumpPoint(current, jumpHorizontal(x, y, 1));
+			addJumpPoint(current, jumpHorizontal(x, y, -1));
+		}
+	}
+
+	if (!found)
+		return false;
+
+	// Fill in the straight runs between the jump points
+	out_path->clear();
+	out_path->push_back(m_tiles[m_goal]);
+	for (int index = m_goal; m_parents[index] != -1; index = m_parents[index])
+	{
+		int parent = m_parents[index];
+		int x = index % m_width;
+		int y = index / m_width;
+		int px = parent % m_width;
+		int py = parent / m_width;
+		int sx = (px > x) - (px < x);
+		int sy = (py > y) - (py < y);
+		while (x != px || y != py)
+		{
+			x += sx;
+			y += sy;
+			out_path->push_back(m_tiles[y * m_width + x]);
+		}
+	}
+	return true;
+}
+
+int JumpPointSearch::getExpandedCount()
+{
+	return m_expanded;
+}
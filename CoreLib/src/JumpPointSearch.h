@@ -0,0 +1,64 @@
+#ifndef JUMPPOINTSEARCH_H
+#define JUMPPOINTSEARCH_H
+
+#include "Tile.h"
+#include <vector>
+
+using namespace std;
+
+// Jump point search for four directions on a grid where every step costs
+// the same. Of all equally short paths only the ones that move vertically
+// as early as possible are followed. A horizontal move only turns where the
+// tile above or below the previous one is blocked, so runs along a row are
+// skipped in one jump. A vertical jump stops on rows where a horizontal
+// jump would find something. Only the tiles where a path can turn are put
+// in the open list, the rest of the result matches AStar.
+class JumpPointSearch
+{
+private:
+	struct OpenItem
+	{
+		int total;		// Cost from the start plus estimate to the goal
+		int estimate;
+		int index;
+
+		// Heap order, lowest total first and closest to the goal on ties
+		bool operator<(const OpenItem& p_other) const
+		{
+			if (total != p_other.total)
+				return total > p_other.total;
+			return estimate > p_other.estimate;
+		}
+	};
+
+	Tile**					m_tiles;
+	int						m_width;
+	int						m_height;
+	int						m_goal;
+
+	vector<int>				m_costs;
+	vector<int>				m_parents;
+	// m_generation while open, m_generation + 1 once closed
+	vector<unsigned int>	m_states;
+	unsigned int			m_generation;
+	vector<OpenItem>		m_open;
+	int						m_expanded;
+
+private:
+	bool	isFree(int p_x, int p_y);
+	int		jumpHorizontal(int p_x, int p_y, int p_dx);
+	int		jumpVertical(int p_x, int p_y, int p_dy);
+	void	addJumpPoint(int p_from, int p_index);
+	int		estimate(int p_index);
+
+public:
+	JumpPointSearch(int p_width, int p_height, Tile** p_tiles);
+
+	// Same as AStar::findPath, out_path goes from the goal back to the start
+	bool	findPath(Tile* p_start, Tile* p_goal, vector<Tile*>* out_path);
+
+	// Jump points expanded by the last query
+	int		getExpandedCount();
+};
+
+#endif
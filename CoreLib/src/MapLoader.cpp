@@ -3,6 +3,9 @@
 MapLoader::MapLoader()
 {
 	m_avatar = NULL;
+	m_entities = NULL;
+	m_pills = NULL;
+	m_animations = NULL;
 }
 
 MapLoader::~MapLoader()
@@ -17,7 +20,9 @@ int MapLoader::parseMap(string p_MapPath, IODevice* p_io, GameStats* p_stats,
 	m_avatar	= NULL;
 	m_tileMap	= NULL;
 	m_gui		= NULL;
-
+	m_entities	= NULL;
+	m_pills		= NULL;
+	m_animations = NULL;
 
 	if (!m_factory)
 		return GAME_FAIL;
@@ -48,6 +53,9 @@ int MapLoader::parseMap(string p_MapPath, IODevice* p_io, GameStats* p_stats,
 		}
 
 		m_tileMap = m_factory->CreateTileMap(m_theme, m_width, m_height, map);
+		m_entities = new EntityStore();
+		m_pills = m_factory->CreatePillField(m_tileMap, m_stats);
+		m_animations = new AnimationPlayer();
 		
 		vector<vector<Switch*> > newSwitches(8);
 		for(unsigned int i = 0; i < newSwitches.size(); i++)
@@ -58,6 +66,7 @@ int MapLoader::parseMap(string p_MapPath, IODevice* p_io, GameStats* p_stats,
 			newWallSwitches[i] = vector<WallSwitch*>();
 		
 		//Create the gameobjects from the information recently parsed from the map
+		int bombItems = 0;
 		/**/for (int i = 0; i < m_height; i++)
 		{
 			for (int j = 0; j < m_width; j++)
@@ -65,8 +74,7 @@ int MapLoader::parseMap(string p_MapPath, IODevice* p_io, GameStats* p_stats,
 				int index = i*m_width+j;
 				if (map[index] > TileTypes::WALLS && map[index] <= TileTypes::PATHS)
 				{
-					m_gameObjects.push_back(m_factory->CreatePill(
-											m_tileMap->getTile(TilePosition(j, i)), m_stats));
+					m_pills->add(m_tileMap->getTile(TilePosition(j, i)));
 				}
 				else if (map[index] > TileTypes::ENEMIESPAWN && map[index] <= TileTypes::BUFFS)
 				{
@@ -77,7 +85,7 @@ int MapLoader::parseMap(string p_MapPath, IODevice* p_io, GameStats* p_stats,
 				{
 					Switch* newSwitch = m_factory->CreateSwitch(
 											m_tileMap->getTile(TilePosition(j, i)),
-											m_stats, vector<WallSwitch*>(), map[index]);
+											m_stats, vector<WallSwitch*>(), map[index], m_entities);
 					int switchIndex = map[index] - (TileTypes::PATHS+1);
 					newSwitches[switchIndex].push_back(newSwitch);
 					m_gameObjects.push_back(newSwitch);
@@ -93,20 +101,23 @@ int MapLoader::parseMap(string p_MapPath, IODevice* p_io, GameStats* p_stats,
 				else if (map[index] > TileTypes::CBSPAWN && map[index] <= TileTypes::ENEMIESPAWN )
 				{
 					Monster* monster = m_factory->CreateMonster(
-						m_tileMap->getTile(TilePosition(j, i)), m_tileMap,m_stats, map[index]);
+						m_tileMap->getTile(TilePosition(j, i)), m_tileMap,m_stats, map[index],
+						m_animations);
 					m_monsters.push_back(monster);
 					m_gameObjects.push_back(monster);
 				}
 				else if (map[index] == TileTypes::CBSPAWN)
 				{
 					m_avatar = m_factory->CreateAvatar(m_tileMap,
-												m_tileMap->getTile(TilePosition(j, i)), m_stats);
+												m_tileMap->getTile(TilePosition(j, i)), m_stats,
+												m_animations);
 					m_gameObjects.push_back(m_avatar);
 				}
 				else if (map[index] > TileTypes::BUFFS && map[index] <= TileTypes::ITEMS)
 				{
 					m_gameObjects.push_back(m_factory->CreateBombPill(
 											m_tileMap->getTile(TilePosition(j,i)), m_stats));
+					bombItems++;
 				}
 				else if (map[index] > TileTypes::ITEMS && map[index] <= TileTypes::EATPOWERUP)
 				{
@@ -126,6 +137,11 @@ int MapLoader::parseMap(string p_MapPath, IODevice* p_io, GameStats* p_stats,
 		if(!m_avatar)
 			return GAME_FAIL;
 
+		// Every bomb item can be used once, so no more bombs are ever
+		// placed at the same time
+		for (int i = 0; i < bombItems; i++)
+			m_bombs.push_back(m_factory->CreateBomb(m_tileMap));
+
 		for (unsigned int i = 0; i < newSwitches.size(); i++)
 		{
 			for (unsigned int j = 0; j < newSwitches[i].size(); j++)
@@ -166,6 +182,22 @@ vector<Trap*> MapLoader::getTraps()
 {
 	return m_traps;
 }
+vector<Bomb*> MapLoader::getBombs()
+{
+	return m_bombs;
+}
+EntityStore* MapLoader::getEntities()
+{
+	return m_entities;
+}
+PillField* MapLoader::getPills()
+{
+	return m_pills;
+}
+AnimationPlayer* MapLoader::getAnimations()
+{
+	return m_animations;
+}
 GUI* MapLoader::getGUI()
 {
 	return m_gui;
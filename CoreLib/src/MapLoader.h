@@ -21,6 +21,10 @@ private:
 	Avatar*				m_avatar;
 	vector<Monster*>	m_monsters;
 	vector<Trap*>		m_traps;
+	vector<Bomb*>		m_bombs;
+	EntityStore*		m_entities;
+	PillField*			m_pills;
+	AnimationPlayer*	m_animations;
 	GameStats*			m_stats;
 	GUI*				m_gui;
 	GOFactory*			m_factory;
@@ -39,6 +43,14 @@ public:
 	Avatar* getAvatar();
 	vector<Monster*> getMonsters();
 	vector<Trap*>	getTraps();
+	// One hidden bomb per bomb item on the map, they are not in the game
+	// objects
+	vector<Bomb*>	getBombs();
+	// Switches, traps and wall switches are kept in the store
+	EntityStore*	getEntities();
+	PillField*		getPills();
+	// Plays the animations of the avatar and the monsters
+	AnimationPlayer*	getAnimations();
 	GUI*			getGUI();
 };
 
@@ -1,8 +1,11 @@
 #include "Monster.h"
 
-Monster::Monster(GameStats* p_gameStats, SpriteInfo* p_spriteInfo)
+Monster::Monster(GameStats* p_gameStats, SpriteInfo* p_spriteInfo, AnimationPlayer* p_animations)
 	: GameObject(p_spriteInfo,p_gameStats)
 {
+	m_ownsAnimations = p_animations == NULL;
+	m_animations = m_ownsAnimations ? new AnimationPlayer() : p_animations;
+	m_animation = -1;
 }
 
 Monster::~Monster()
@@ -11,10 +14,28 @@ Monster::~Monster()
 		delete m_ai;
 	if(m_monsterKilledSound)
 		m_monsterKilledSound->deleted = true;
-	delete m_right;
-	delete m_left;
-	delete m_down;
-	delete m_up;
+	if (m_ownsAnimations)
+		delete m_animations;
+}
+void Monster::initAnimations(float p_frameSize, unsigned int p_frameCount, float p_delay)
+{
+	int sheet = m_spriteInfo ? m_spriteInfo->texturePathId : 0;
+	m_right = AnimationClips::add(sheet, AnimationClip(fVector2(0, 0),
+		p_frameSize, p_frameSize, p_frameCount, p_delay, true));
+	m_left = AnimationClips::add(sheet, AnimationClip(fVector2(0, p_frameSize),
+		p_frameSize, p_frameSize, p_frameCount, p_delay, true));
+	m_down = AnimationClips::add(sheet, AnimationClip(fVector2(0, p_frameSize * 2),
+		p_frameSize, p_frameSize, p_frameCount, p_delay, true));
+	m_up = AnimationClips::add(sheet, AnimationClip(fVector2(0, p_frameSize * 3),
+		p_frameSize, p_frameSize, p_frameCount, p_delay, true));
+
+	m_animation = m_animations->add(m_down, m_spriteInfo);
+}
+void Monster::updateAnimation(float p_deltaTime, bool p_moving)
+{
+	m_animations->setRate(m_animation, p_moving ? 1.0f : 0.0f);
+	if (m_ownsAnimations)
+		m_animations->update(p_deltaTime);
 }
 void Monster::transformSpriteInformation()
 {
@@ -38,106 +59,48 @@ Tile* Monster::getCurrentTile()
 }
 void Monster::FindPath(Tile* p_start, Tile* p_goal)
 {
-	Tile* toCheck[4];
-
-	vector<AstarItem> queue;
-	vector<AstarItem> visited;
-
-	AstarItem first;
-	first.toStart = 0;
-	TilePosition startdif = p_goal->getTilePosition() - p_start->getTilePosition();
-	first.toGoal = abs(startdif.x) + abs(startdif.y);
-	first.tile = p_start;
-	first.parent = NULL;
-	queue.push_back(first);
-	while (queue.size() > 0 && queue.back().tile != p_goal)
-	{
-		visited.push_back(queue.back());
-		TilePosition p = queue.back().tile->getTilePosition();
-		queue.pop_back();
-		toCheck[0] = m_map->getTile(p + TilePosition(0, 1));
-		toCheck[1] = m_map->getTile(p + TilePosition(0, -1));
-		toCheck[2] = m_map->getTile(p + TilePosition(1, 0));
-		toCheck[3] = m_map->getTile(p + TilePosition(-1, 0));
-		for (int i = 0; i < 4; i++)
-		{
-			if (toCheck[i])
-			{
-				bool skip = !toCheck[i]->isFree();
-				for (unsigned int j = 0; j < visited.size(); j++)
-				{
-					if (visited[j].tile == toCheck[i])
-						skip = true;
-				}
-				if (!skip)
-				{
-					int toStart = visited.back().toStart+1;
-					TilePosition dif = p_goal->getTilePosition() - toCheck[i]->getTilePosition();
-					int toGoal = abs(dif.x) + abs(dif.y);
-					UpdateQueue(toCheck[i], visited.size()-1, toStart, toGoal, queue);
-				}
-			}
-		}
-	}
-	
-	if (queue.size() == 0)
+	// The path is kept if the goal can't be reached
+	vector<Tile*> route;
+	if (!m_map->findRoute(p_start, p_goal, &route))
 		return;
-
+	m_route = route;
 	m_path.clear();
-	m_path.push_back(queue.back().tile);
-	int parent = queue.back().parent;
-	while (m_path.back() != p_start)
-	{
-		AstarItem asi = visited[parent];
-		m_path.push_back(asi.tile);
-		parent = asi.parent;
-	}
-
-	return;
+	refineSegment();
 }
-int	Monster::UpdateQueue(Tile* p_tile, int p_parent, int p_toStart, int p_toGoal, vector<AstarItem>& p_queue)
+bool Monster::refineSegment()
 {
-	int index = FindTile(p_tile, p_queue);
-	if (index >= 0 && p_queue[index].distance() > p_toStart + p_toGoal)
+	// Search the way to the next waypoint only when it's needed
+	while (m_path.empty() && m_route.size() >= 2)
 	{
-		p_queue[index].toStart = p_toStart;
-		p_queue[index].toGoal = p_toGoal;
-		p_queue[index].parent = p_parent;
-		while (index < (int)(p_queue.size()-1) && p_queue[index].distance() < p_queue[index+1].distance())
-		{
-			AstarItem temp = p_queue[index];
-			p_queue[index] = p_queue[index+1];
-			p_queue[index+1] = temp;
-			index++;
-		}
-	}
-	else
-	{
-		AstarItem star;
-		star.toStart = p_toStart;
-		star.toGoal = p_toGoal;
-		star.tile = p_tile;
-		star.parent = p_parent;
-		p_queue.push_back(star);
-		index = p_queue.size() - 1;
-		while (index > 0 && p_queue[index].distance() > p_queue[index-1].distance())
-		{
-			AstarItem temp = p_queue[index];
-			p_queue[index] = p_queue[index-1];
-			p_queue[index-1] = temp;
-			index--;
-		}
+		Tile* from = m_route.back();
+		m_route.pop_back();
+		if (!m_map->findPath(from, m_route.back(), &m_path))
+			m_route.clear();
 	}
-	return 0;
+	if (m_route.size() < 2)
+		m_route.clear();
+	return !m_path.empty();
 }
-int	Monster::FindTile(Tile* p_tile, vector<AstarItem>& p_queue)
+void Monster::refinePath()
 {
-	for (unsigned int i = 0; i < p_queue.size(); i++)
-	{
-		if (p_queue[i].tile == p_tile)
-			return i;
-	}
-	return -1;
+	// Later segments start where the monster already stands
+	if (m_path.empty() && refineSegment())
+		m_path.pop_back();
+}
+void Monster::ChaseTile(Tile* p_target)
+{
+	// All monsters share the field, it's only rebuilt when the target moves
+	FlowField* field = m_map->getFlowField();
+	field->setTarget(p_target);
+	if (field->getChasePath(m_currentTile, &m_path))
+		m_route.clear();
+}
+void Monster::FleeFromTile(Tile* p_target)
+{
+	FlowField* field = m_map->getFlowField();
+	field->setTarget(p_target);
+	if (field->getFleePath(m_currentTile, &m_path))
+		m_route.clear();
 }
 void Monster::kill()
 {
@@ -169,28 +132,29 @@ void Monster::determineAnimation()
 		TilePosition t2 = m_nextTile->getTilePosition();
 		if (t2.x < t1.x)
 		{
-			m_currentAnimation = m_left;
+			m_animations->play(m_animation, m_left);
 		}
 		else if (t2.x > t1.x)
 		{
-			m_currentAnimation = m_right;
+			m_animations->play(m_animation, m_right);
 		}
 		else if (t2.y > t1.y)
 		{
-			m_currentAnimation = m_up;
+			m_animations->play(m_animation, m_up);
 		}
 		else if (t2.y < t1.y)
 		{
-			m_currentAnimation = m_down;
+			m_animations->play(m_animation, m_down);
 		}
 	}
 }
 void Monster::reset()
 {
-	m_currentAnimation = m_down;
+	m_animations->play(m_animation, m_down);
 	dt = 0;
 	m_currentTile = m_nextTile = m_startTile;
 	m_path.clear();
+	m_route.clear();
 	if(m_nextTile != NULL)
 		transformSpriteInformation();
 	beginRespawn();
@@ -11,19 +11,7 @@
 #include "Tilemap.h"
 #include "Avatar.h"
 #include "AI.h"
-#include "Animation.h"
-
-struct AstarItem
-{
-	Tile* tile;
-	int parent;
-	int toStart;
-	int toGoal;
-	int distance()
-	{
-		return toStart + toGoal;
-	}
-};
+#include "AnimationPlayer.h"
 
 class Monster: public GameObject
 {
@@ -40,30 +28,41 @@ protected:
 	float dt;
 
 	vector<Tile*> m_path;
+	// Waypoints still ahead after m_path, from the goal back
+	vector<Tile*> m_route;
 
-	Animation* m_left;
-	Animation* m_right;
-	Animation* m_up;
-	Animation* m_down;
+	// Clips of the sheet per direction, shared by all monsters on it
+	int m_left;
+	int m_right;
+	int m_up;
+	int m_down;
 
-	Animation* m_currentAnimation;
+	// Without a player of the map, the monster plays its own
+	AnimationPlayer*	m_animations;
+	bool				m_ownsAnimations;
+	int					m_animation;
 
 	bool	m_dead;
 	bool	m_respawning;
 	SoundInfo* m_monsterKilledSound;
 protected:
-	Monster(GameStats* p_gameStats, SpriteInfo* p_spriteInfo);
+	Monster(GameStats* p_gameStats, SpriteInfo* p_spriteInfo, AnimationPlayer* p_animations);
 protected:
-	int		UpdateQueue(Tile* p_tile, int p_parent, int p_toStart, int p_toGoal,
-				vector<AstarItem>& p_queue);
-	int		FindTile(Tile* p_tile, vector<AstarItem>& p_queue);
+	// The sheet has a row per direction: right, left, down and up
+	void	initAnimations(float p_frameSize, unsigned int p_frameCount, float p_delay);
 	void	determineAnimation();
+	// Plays the walk while moving and holds the frame otherwise
+	void	updateAnimation(float p_deltaTime, bool p_moving);
+	bool	refineSegment();
+	void	refinePath();
 	void	transformSpriteInformation();
 public:
 	virtual ~Monster();
 	virtual void	update(float p_deltaTime, InputInfo p_inputInfo) = 0;
 	Tile*	getCurrentTile();
 	void	FindPath(Tile* p_start, Tile* p_goal);
+	void	ChaseTile(Tile* p_target);
+	void	FleeFromTile(Tile* p_target);
 	void	kill();
 	bool	isDead();
 	void	addMonsterAI(Avatar* p_avatar, GameStats* p_gameStats, Tilemap* p_tilemap);
@@ -0,0 +1,96 @@
+#include "PathCache.h"
+
+PathCache::PathCache(unsigned int p_capacity)
+{
+	m_capacity	= p_capacity;
+	m_version	= 0;
+	m_hits		= 0;
+	m_misses	= 0;
+}
+
+void PathCache::checkVersion(unsigned int p_version)
+{
+	if (p_version != m_version)
+	{
+		clear();
+		m_version = p_version;
+	}
+}
+
+bool PathCache::find(int p_start, int p_goal, unsigned int p_version,
+	bool* out_found, vector<Tile*>* out_path)
+{
+	checkVersion(p_version);
+
+	bool reversed = false;
+	map<pair<int, int>, EntryIterator>::iterator it =
+		m_lookup.find(make_pair(p_start, p_goal));
+	if (it == m_lookup.end())
+	{
+		it = m_lookup.find(make_pair(p_goal, p_start));
+		reversed = true;
+	}
+	if (it == m_lookup.end())
+	{
+		m_misses++;
+		return false;
+	}
+	m_hits++;
+
+	// Move to the front as the most recently used
+	m_entries.splice(m_entries.begin(), m_entries, it->second);
+	Entry& entry = m_entries.front();
+	*out_found = entry.found;
+	if (entry.found)
+	{
+		if (reversed)
+			out_path->assign(entry.path.rbegin(), entry.path.rend());
+		else
+			*out_path = entry.path;
+	}
+	return true;
+}
+
+void PathCache::store(int p_start, int p_goal, unsigned int p_version,
+	bool p_found, const vector<Tile*>& p_path)
+{
+	checkVersion(p_version);
+	if (m_capacity == 0 || m_lookup.count(make_pair(p_start, p_goal)))
+		return;
+
+	if (m_entries.size() >= m_capacity)
+	{
+		m_lookup.erase(make_pair(m_entries.back().start, m_entries.back().goal));
+		m_entries.pop_back();
+	}
+
+	Entry entry;
+	entry.start	= p_start;
+	entry.goal	= p_goal;
+	entry.found	= p_found;
+	if (p_found)
+		entry.path = p_path;
+	m_entries.push_front(entry);
+	m_lookup[make_pair(p_start, p_goal)] = m_entries.begin();
+}
+
+void PathCache::clear()
+{
+	m_entries.clear();
+	m_lookup.clear();
+}
+
+int PathCache::getHits()
+{
+	return m_hits;
+}
+
+int PathCache::getMisses()
+{
+	return m_misses;
+}
+
+int PathCache::getSize()
+{
+	return (int)m_entries.size();
+}
@@ -0,0 +1,55 @@
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include "Tile.h"
+#include <vector>
+#include <list>
+#include <map>
+
+using namespace std;
+
+// Remembers the latest paths searched on a map, keyed by start and goal
+// tile index. When full the least recently used path is dropped. Each
+// lookup passes the map's topology version and everything stored under
+// an older version is thrown away, so no path survives a wall switch.
+class PathCache
+{
+private:
+	struct Entry
+	{
+		int				start;
+		int				goal;
+		bool			found;
+		vector<Tile*>	path;
+	};
+	typedef list<Entry>::iterator EntryIterator;
+
+	// Most recently used first
+	list<Entry>							m_entries;
+	map<pair<int, int>, EntryIterator>	m_lookup;
+	unsigned int						m_capacity;
+	unsigned int						m_version;
+	int									m_hits;
+	int									m_misses;
+
+private:
+	void	checkVersion(unsigned int p_version);
+
+public:
+	PathCache(unsigned int p_capacity);
+
+	// Returns true on a hit, out_found tells if the search found a path.
+	// A path stored from the goal to the start is reversed, since the
+	// shortest path is the same both ways.
+	bool	find(int p_start, int p_goal, unsigned int p_version,
+				bool* out_found, vector<Tile*>* out_path);
+	void	store(int p_start, int p_goal, unsigned int p_version,
+				bool p_found, const vector<Tile*>& p_path);
+	void	clear();
+
+	int		getHits();
+	int		getMisses();
+	int		getSize();
+};
+
+#endif
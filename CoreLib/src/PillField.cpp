@@ -0,0 +1,178 @@
+#include "PillField.h"
+#include <cmath>
+
+PillField::PillField(int p_width, int p_height, float p_tileWidth, float p_tileHeight,
+	SpriteInfo* p_spriteInfo, SoundInfo* p_sound, GameStats* p_gameStats)
+{
+	m_width			= p_width;
+	m_height		= p_height;
+	m_tileWidth		= p_tileWidth;
+	m_tileHeight	= p_tileHeight;
+	m_present.resize((p_width * p_height + 31) / 32, 0);
+	m_remaining		= 0;
+	m_time			= 0;
+
+	m_spriteInfo	= p_spriteInfo;
+	m_sound			= p_sound;
+	m_gameStats		= p_gameStats;
+
+	// Nothing to draw until the first update
+	if (m_spriteInfo)
+	{
+		m_origin = m_spriteInfo->transformInfo;
+		m_spriteInfo->visible = false;
+	}
+}
+
+PillField::~PillField()
+{
+	if (m_spriteInfo)
+	{
+		m_spriteInfo->instances		= NULL;
+		m_spriteInfo->instanceCount	= 0;
+		m_spriteInfo->visible		= false;
+	}
+	if (m_sound)
+		m_sound->deleted = true;
+}
+
+void PillField::add(Tile* p_tile)
+{
+	TilePosition position = p_tile->getTilePosition();
+	int tile = position.y * m_width + position.x;
+	unsigned int bit = 1u << (tile & 31);
+	if (m_present[tile >> 5] & bit)
+		return;
+
+	m_present[tile >> 5] |= bit;
+	m_remaining++;
+	if (m_gameStats)
+		m_gameStats->addPill();
+	p_tile->setPillField(this);
+}
+
+bool PillField::hasPill(TilePosition p_position)
+{
+	if (p_position.x < 0 || p_position.x >= m_width ||
+		p_position.y < 0 || p_position.y >= m_height)
+	{
+		return false;
+	}
+	int tile = p_position.y * m_width + p_position.x;
+	return (m_present[tile >> 5] & (1u << (tile & 31))) != 0;
+}
+
+bool PillField::eat(TilePosition p_position)
+{
+	if (!hasPill(p_position))
+		return false;
+
+	int tile = p_position.y * m_width + p_position.x;
+	m_present[tile >> 5] &= ~(1u << (tile & 31));
+	m_remaining--;
+
+	EatenPill eaten;
+	eaten.tile		= tile;
+	eaten.elapsed	= 0;
+	eaten.y			= getFloating(tile).translation[TransformInfo::Y];
+	m_eaten.push_back(eaten);
+
+	// A single voice, pills eaten in the same frame are heard once
+	if (m_sound)
+		m_sound->play = true;
+	if (m_gameStats)
+		m_gameStats->pillEaten();
+	return true;
+}
+
+TransformInfo PillField::getFloating(int p_tile)
+{
+	TransformInfo transform = m_origin;
+	float x = (p_tile % m_width) * m_tileWidth + m_tileWidth * 0.5f;
+	float y = (p_tile / m_width) * m_tileHeight + m_tileHeight * 0.5f;
+
+	// Floaty animation, out of step between neighbouring tiles
+	float offset = m_origin.scale[TransformInfo::Y] / 21.7f * 1.5f;
+	float sinFrac = sin(x + y + m_time * 5.0f);
+	float scaleFrac = 0.5f * sinFrac + 0.5f;
+	transform.translation[TransformInfo::X] = x;
+	transform.translation[TransformInfo::Y] = y + sinFrac * offset;
+	transform.scale[TransformInfo::X] = m_origin.scale[TransformInfo::X] * (1 + scaleFrac * 0.25f);
+	transform.scale[TransformInfo::Y] = m_origin.scale[TransformInfo::Y] * (1 + scaleFrac * 0.25f);
+	return transform;
+}
+
+void PillField::update(float p_deltaTime)
+{
+	m_time += p_deltaTime;
+	m_instances.clear();
+
+	// Words without any pill left are skipped whole
+	for (unsigned int word = 0; word < m_present.size(); word++)
+	{
+		unsigned int bits = m_present[word];
+		for (int bit = 0; bits != 0; bit++, bits >>= 1)
+		{
+			if (bits & 1)
+				m_instances.push_back(getFloating(word * 32 + bit));
+		}
+	}
+
+	// Grow and rise, then shrink back down and disappear
+	float startX = m_origin.scale[TransformInfo::X];
+	float startY = m_origin.scale[TransformInfo::Y];
+	for (int i = m_eaten.size() - 1; i >= 0; i--)
+	{
+		EatenPill& eaten = m_eaten[i];
+		eaten.elapsed += p_deltaTime;
+		if (eaten.elapsed >= 1.0f)
+		{
+			m_eaten[i] = m_eaten.back();
+			m_eaten.pop_back();
+			continue;
+		}
+
+		float grow = eaten.elapsed < 0.5f ? 0.5f + eaten.elapsed : 1.0f - eaten.elapsed;
+		float rise = eaten.elapsed < 0.5f ? eaten.elapsed : 1.0f - eaten.elapsed;
+		TransformInfo transform = m_origin;
+		transform.translation[TransformInfo::X] =
+			(eaten.tile % m_width) * m_tileWidth + m_tileWidth * 0.5f;
+		transform.translation[TransformInfo::Y] = eaten.y + rise * startX * 5;
+		transform.scale[TransformInfo::X] = startX * 2 * grow;
+		transform.scale[TransformInfo::Y] = startY * 2 * grow;
+		m_instances.push_back(transform);
+	}
+
+	if (m_spriteInfo)
+	{
+		m_spriteInfo->instances		= m_instances.empty() ? NULL : &m_instances[0];
+		m_spriteInfo->instanceCount	= m_instances.size();
+		m_spriteInfo->visible		= !m_instances.empty();
+	}
+}
+
+fVector2 PillField::getPosition(TilePosition p_position)
+{
+	return fVector2(p_position.x * m_tileWidth + m_tileWidth * 0.5f,
+		p_position.y * m_tileHeight + m_tileHeight * 0.5f);
+}
+
+float PillField::getRadius()
+{
+	return m_origin.scale[TransformInfo::X];
+}
+
+int PillField::getRemaining()
+{
+	return m_remaining;
+}
+
+int PillField::getInstanceCount()
+{
+	return m_instances.size();
+}
+
+const TransformInfo& PillField::getInstance(int p_index)
+{
+	return m_instances[p_index];
+}
@@ -0,0 +1,67 @@
+#ifndef PILLFIELD_H
+#define PILLFIELD_H
+
+#include "Tile.h"
+#include "GameStats.h"
+#include <SoundInfo.h>
+#include <vector>
+
+using namespace std;
+
+// The plain pills of a map. Which tiles still have a pill is kept as one
+// bit per tile, everything else follows from the tile position. All pills
+// share one sprite, drawn once per pill as instances of it, and one sound
+// that is played whenever a pill is eaten.
+//
+// Eaten pills play their grow and shrink animation for a second before
+// they are gone. A tile given to add answers removePill through the field.
+class PillField
+{
+private:
+	struct EatenPill
+	{
+		int		tile;
+		float	elapsed;
+		float	y;	// Where the pill was when it was eaten
+	};
+
+	int						m_width;
+	int						m_height;
+	float					m_tileWidth;
+	float					m_tileHeight;
+	vector<unsigned int>	m_present;	// One bit per tile
+	int						m_remaining;
+	vector<EatenPill>		m_eaten;
+	float					m_time;
+
+	SpriteInfo*				m_spriteInfo;	// Scale and depth of every pill
+	TransformInfo			m_origin;
+	vector<TransformInfo>	m_instances;
+	SoundInfo*				m_sound;
+	GameStats*				m_gameStats;
+
+private:
+	TransformInfo	getFloating(int p_tile);
+
+public:
+	PillField(int p_width, int p_height, float p_tileWidth, float p_tileHeight,
+		SpriteInfo* p_spriteInfo, SoundInfo* p_sound, GameStats* p_gameStats);
+	~PillField();
+
+	void		add(Tile* p_tile);
+	bool		hasPill(TilePosition p_position);
+	// Returns false if there was no pill on the tile
+	bool		eat(TilePosition p_position);
+
+	// Animates the pills and hands the remaining ones to the sprite
+	void		update(float p_deltaTime);
+
+	fVector2	getPosition(TilePosition p_position);
+	float		getRadius();
+	int			getRemaining();
+	// Pills drawn by the last update, eaten ones included
+	int			getInstanceCount();
+	const TransformInfo& getInstance(int p_index);
+};
+
+#endif
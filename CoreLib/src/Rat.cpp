@@ -1,8 +1,8 @@
 #include "Rat.h"
 
 Rat::Rat(GameStats* p_gameStats, SpriteInfo* p_spriteInfo, Tile* p_tile, Tilemap* p_map,
-					SoundInfo* p_monsterKilledSound)
-	: Monster(p_gameStats, p_spriteInfo)
+					SoundInfo* p_monsterKilledSound, AnimationPlayer* p_animations)
+	: Monster(p_gameStats, p_spriteInfo, p_animations)
 {
 	dt = 0;
 	m_startTile = m_currentTile = m_nextTile = p_tile;
@@ -13,12 +13,7 @@ Rat::Rat(GameStats* p_gameStats, SpriteInfo* p_spriteInfo, Tile* p_tile, Tilemap
 
 	m_monsterKilledSound = p_monsterKilledSound;
 
-	m_right = new Animation(fVector2(0, 0), 64, 64, 4, 0.1f, true);
-	m_left = new Animation(fVector2(0, 64), 64, 64, 4, 0.1f, true);
-	m_down = new Animation(fVector2(0, 128), 64, 64, 4, 0.1f, true);
-	m_up = new Animation(fVector2(0, 192), 64, 64, 4, 0.1f, true);
-
-	m_currentAnimation = m_down;
+	initAnimations(64, 4, 0.1f);
 	m_timeSinceSpawn = 0;
 	m_size = fVector2(p_spriteInfo->transformInfo.scale[TransformInfo::X],
 						p_spriteInfo->transformInfo.scale[TransformInfo::Y]);
@@ -42,6 +37,7 @@ void Rat::update(float p_deltaTime, InputInfo p_inputInfo)
 			if (m_currentTile)
 			{
 				m_currentTile = m_nextTile;
+				refinePath();
 				if (m_path.size() > 0)
 				{
 					if (m_path.back()->isFree())
@@ -60,15 +56,9 @@ void Rat::update(float p_deltaTime, InputInfo p_inputInfo)
 
 					if(m_path.size() == 0)
 					{
-						Tile* t;
-						do
-						{
-							int rndX = rand() % m_map->getWidth();
-							int rndY = rand() % m_map->getHeight();
-							t = m_map->getTile(TilePosition(rndX, rndY));					
-						} while (!t->isFree());
-
-						FindPath(m_currentTile, t);
+						Tile* t = m_map->randomFreeTile();
+						if (t)
+							FindPath(m_currentTile, t);
 					}
 				}
 			}
@@ -79,12 +69,7 @@ void Rat::update(float p_deltaTime, InputInfo p_inputInfo)
 		determineAnimation();
 		transformSpriteInformation();
 
-		if (m_currentAnimation)
-		{
-			if (m_currentTile != m_nextTile)
-				m_currentAnimation->update(p_deltaTime);
-			m_spriteInfo->textureRect = m_currentAnimation->getCurrentFrame();
-		}
+		updateAnimation(p_deltaTime, m_currentTile != m_nextTile);
 
 		if (m_timeSinceSpawn < SPAWNTIME)
 		{
@@ -13,7 +13,7 @@ private:
 	fVector2 m_size;
 public:
 	Rat(GameStats* p_gameStats, SpriteInfo* p_spriteInfo, Tile* p_tile, Tilemap* p_map,
-			SoundInfo* p_monsterKilled);
+			SoundInfo* p_monsterKilled, AnimationPlayer* p_animations = NULL);
 	virtual ~Rat();
 	void	update(float p_deltaTime, InputInfo p_inputInfo);
 	void	reset();
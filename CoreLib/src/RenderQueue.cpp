@@ -0,0 +1,148 @@
+#include "RenderQueue.h"
+#include <cstring>
+
+RenderQueue::RenderQueue()
+{
+	clear();
+}
+
+RenderKey RenderQueue::makeKey(float p_depth, int p_texture, int p_sequence)
+{
+	// Larger z is closer to the viewer, so it has to sort last. Flipping
+	// the float bits makes their unsigned order match the float order.
+	unsigned int depthBits;
+	memcpy(&depthBits, &p_depth, sizeof(depthBits));
+	if (depthBits & 0x80000000u)
+		depthBits = ~depthBits;
+	else
+		depthBits |= 0x80000000u;
+	RenderKey depth = depthBits >> (32 - DEPTH_BITS);
+
+	RenderKey texture	= (unsigned int)p_texture & ((1 << TEXTURE_BITS) - 1);
+	RenderKey sequence	= (unsigned int)p_sequence & ((1 << SEQUENCE_BITS) - 1);
+
+	return (depth << (TEXTURE_BITS + SEQUENCE_BITS)) |
+		(texture << SEQUENCE_BITS) | sequence;
+}
+
+void RenderQueue::clear()
+{
+	m_spriteInfos.clear();
+	m_keys.clear();
+	m_stats.queued		= 0;
+	m_stats.culled		= 0;
+	m_stats.depthLayers	= 0;
+	m_stats.textureRuns	= 0;
+}
+
+void RenderQueue::add(SpriteInfo* p_spriteInfo, int p_texture)
+{
+	if (!p_spriteInfo->visible)
+	{
+		m_stats.culled++;
+		return;
+	}
+	int sequence = (int)m_spriteInfos.size();
+	m_keys.push_back(makeKey(p_spriteInfo->transformInfo.translation[
+		TransformInfo::Z], p_texture, sequence));
+	m_spriteInfos.push_back(p_spriteInfo);
+}
+
+void RenderQueue::sort()
+{
+	radixSort();
+	countRuns();
+	m_stats.queued = (int)m_keys.size();
+}
+
+void RenderQueue::radixSort()
+{
+	// LSD radix sort on bytes. The histograms of all bytes are built in one
+	// pass, and bytes that are the same in every key, like the unused top
+	// of the sequence, are skipped.
+	const int DIGITS	= sizeof(RenderKey);
+	const int BUCKETS	= 256;
+
+	unsigned int count = (unsigned int)m_keys.size();
+	if (count < 2)
+		return;
+	m_sortBuffer.resize(count);
+
+	unsigned int counts[DIGITS][BUCKETS];
+	memset(counts, 0, sizeof(counts));
+	for (unsigned int i = 0; i < count; i++)
+	{
+		RenderKey key = m_keys[i];
+		for (int digit = 0; digit < DIGITS; digit++)
+			counts[digit][(key >> (digit * 8)) & (BUCKETS - 1)]++;
+	}
+
+	RenderKey* source		= &m_keys[0];
+	RenderKey* destination	= &m_sortBuffer[0];
+	for (int digit = 0; digit < DIGITS; digit++)
+	{
+		int shift = digit * 8;
+		unsigned int* offsets = counts[digit];
+		if (offsets[(source[0] >> shift) & (BUCKETS - 1)] == count)
+			continue;
+
+		unsigned int offset = 0;
+		for (int i = 0; i < BUCKETS; i++)
+		{
+			unsigned int bucketSize = offsets[i];
+			offsets[i] = offset;
+			offset += bucketSize;
+		}
+		for (unsigned int i = 0; i < count; i++)
+		{
+			RenderKey key = source[i];
+			destination[offsets[(key >> shift) & (BUCKETS - 1)]++] = key;
+		}
+
+		RenderKey* swap = source;
+		source = destination;
+		destination = swap;
+	}
+	if (source != &m_keys[0])
+		m_keys.swap(m_sortBuffer);
+}
+
+void RenderQueue::countRuns()
+{
+	m_stats.depthLayers = 0;
+	m_stats.textureRuns = 0;
+	RenderKey previous = 0;
+	for (unsigned int i = 0; i < m_keys.size(); i++)
+	{
+		RenderKey key = m_keys[i] >> SEQUENCE_BITS;
+		if (i == 0 || (key >> TEXTURE_BITS) != (previous >> TEXTURE_BITS))
+			m_stats.depthLayers++;
+		if (i == 0 || (key & ((1 << TEXTURE_BITS) - 1)) !=
+			(previous & ((1 << TEXTURE_BITS) - 1)))
+		{
+			m_stats.textureRuns++;
+		}
+		previous = key;
+	}
+}
+
+int RenderQueue::getCount() const
+{
+	return (int)m_keys.size();
+}
+
+SpriteInfo* RenderQueue::getSpriteInfo(int p_index) const
+{
+	int sequence = (int)(m_keys[p_index] & ((1 << SEQUENCE_BITS) - 1));
+	return m_spriteInfos[sequence];
+}
+
+RenderKey RenderQueue::getKey(int p_index) const
+{
+	return m_keys[p_index];
+}
+
+const RenderQueueStats& RenderQueue::getStats() const
+{
+	return m_stats;
+}
@@ -0,0 +1,63 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include "SpriteInfo.h"
+#include <vector>
+
+using namespace std;
+
+typedef unsigned long long RenderKey;
+
+// Per-frame counters of the render queue
+struct RenderQueueStats
+{
+	int queued;			// Visible sprites submitted this frame
+	int culled;			// Invisible sprites dropped before submission
+	int depthLayers;	// Distinct depths among the queued sprites
+	int textureRuns;	// Runs of consecutive sprites sharing a texture
+};
+
+// Collects the sprites of a frame and orders them back to front. Each
+// sprite gets a 64-bit key with its depth in the top bits, then its
+// texture and last its insertion order:
+//
+//   | depth (24) | texture (16) | sequence (24) |
+//
+// Sprites are thereby drawn back to front for correct blending, sprites
+// at the same depth are grouped per texture and ties keep the order they
+// were added in. The keys are sorted with a radix sort.
+class RenderQueue
+{
+private:
+	vector<SpriteInfo*>	m_spriteInfos;	// Indexed by sequence
+	vector<RenderKey>	m_keys;
+	vector<RenderKey>	m_sortBuffer;
+	RenderQueueStats	m_stats;
+
+private:
+	void	radixSort();
+	void	countRuns();
+
+public:
+	static const int DEPTH_BITS		= 24;
+	static const int TEXTURE_BITS	= 16;
+	static const int SEQUENCE_BITS	= 24;
+
+				RenderQueue();
+
+	static RenderKey	makeKey(float p_depth, int p_texture, int p_sequence);
+
+	void		clear();
+
+	// Invisible sprites are dropped. p_texture is the texture the sprite
+	// will be drawn with, as reported by the context.
+	void		add(SpriteInfo* p_spriteInfo, int p_texture);
+	void		sort();
+
+	int			getCount() const;
+	SpriteInfo*	getSpriteInfo(int p_index) const;
+	RenderKey	getKey(int p_index) const;
+	const RenderQueueStats& getStats() const;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(int p_width, int p_height, float p_cellWidth, float p_cellHeight)
+{
+	m_width			= p_width;
+	m_height		= p_height;
+	m_cellWidth		= p_cellWidth;
+	m_cellHeight	= p_cellHeight;
+	m_heads.resize(p_width * p_height, -1);
+}
+
+int SpatialGrid::cellX(float p_x)
+{
+	int x = (int)floor(p_x / m_cellWidth);
+	return min(max(x, 0), m_width - 1);
+}
+
+int SpatialGrid::cellY(float p_y)
+{
+	int y = (int)floor(p_y / m_cellHeight);
+	return min(max(y, 0), m_height - 1);
+}
+
+void SpatialGrid::clear()
+{
+	for (unsigned int i = 0; i < m_usedCells.size(); i++)
+		m_heads[m_usedCells[i]] = -1;
+	m_usedCells.clear();
+	m_entries.clear();
+}
+
+void SpatialGrid::add(fVector2 p_position, int p_id)
+{
+	int cell = cellY(p_position.y) * m_width + cellX(p_position.x);
+	if (m_heads[cell] < 0)
+		m_usedCells.push_back(cell);
+
+	Entry entry;
+	entry.id	= p_id;
+	entry.next	= m_heads[cell];
+	m_heads[cell] = m_entries.size();
+	m_entries.push_back(entry);
+}
+
+void SpatialGrid::query(fVector2 p_position, float p_reach, vector<int>* out_ids)
+{
+	if (m_entries.empty())
+		return;
+
+	int minX = cellX(p_position.x - p_reach);
+	int maxX = cellX(p_position.x + p_reach);
+	int minY = cellY(p_position.y - p_reach);
+	int maxY = cellY(p_position.y + p_reach);
+	for (int y = minY; y <= maxY; y++)
+	{
+		for (int x = minX; x <= maxX; x++)
+		{
+			for (int i = m_heads[y * m_width + x]; i >= 0; i = m_entries[i].next)
+				out_ids->push_back(m_entries[i].id);
+		}
+	}
+}
+
+int SpatialGrid::getSize()
+{
+	return m_entries.size();
+}
@@ -0,0 +1,48 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <fVector2.h>
+#include <vector>
+
+using namespace std;
+
+// Buckets ids by position in cells the size of a tile, so objects close to
+// a point can be found without testing every object. Each cell keeps a
+// linked list through the added entries. clear only touches the cells that
+// were used, so emptying and filling the grid every frame costs as much as
+// the number of objects, not the size of the map. Positions outside the
+// map go into the cells along its edge.
+class SpatialGrid
+{
+private:
+	struct Entry
+	{
+		int id;
+		int next;		// Next entry in the same cell, -1 at the end
+	};
+
+	int				m_width;
+	int				m_height;
+	float			m_cellWidth;
+	float			m_cellHeight;
+
+	vector<int>		m_heads;		// First entry in each cell, -1 if empty
+	vector<int>		m_usedCells;
+	vector<Entry>	m_entries;
+
+private:
+	int		cellX(float p_x);
+	int		cellY(float p_y);
+
+public:
+	SpatialGrid(int p_width, int p_height, float p_cellWidth, float p_cellHeight);
+
+	void	clear();
+	void	add(fVector2 p_position, int p_id);
+	// Appends the ids of everything added at most p_reach away in x and y
+	// from p_position, along with some in the same cells that are farther
+	void	query(fVector2 p_position, float p_reach, vector<int>* out_ids);
+	int		getSize();
+};
+
+#endif
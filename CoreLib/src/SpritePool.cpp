@@ -0,0 +1,126 @@
+#include "SpritePool.h"
+#include "CommonUtility.h"
+
+SpritePool::SpritePool(int p_tag)
+{
+	m_tag = p_tag & 1;
+}
+
+SpritePool::~SpritePool()
+{
+	for (unsigned int i = 0; i < m_blocks.size(); i++)
+		delete[] m_blocks[i];
+}
+
+SpriteInfo* SpritePool::getSlot(int p_slot) const
+{
+	return &m_blocks[p_slot / BLOCK_SIZE][p_slot % BLOCK_SIZE];
+}
+
+SpriteHandle SpritePool::makeHandle(int p_slot) const
+{
+	return (m_tag << (INDEX_BITS + GENERATION_BITS)) |
+		(m_generations[p_slot] << INDEX_BITS) | p_slot;
+}
+
+int SpritePool::getSlotIndex(SpriteHandle p_handle) const
+{
+	// Returns -1 for handles to removed sprites
+	if (p_handle < 0)
+		return -1;
+	int slot = p_handle & ((1 << INDEX_BITS) - 1);
+	int generation = (p_handle >> INDEX_BITS) & ((1 << GENERATION_BITS) - 1);
+	int tag = p_handle >> (INDEX_BITS + GENERATION_BITS);
+	if (tag != m_tag || slot >= (int)m_generations.size() || m_denseIndices[slot] < 0 ||
+		m_generations[slot] != generation)
+	{
+		return -1;
+	}
+	return slot;
+}
+
+SpriteInfo* SpritePool::add()
+{
+	if (m_freeSlots.empty())
+	{
+		int first = (int)m_generations.size();
+		if (first + BLOCK_SIZE > (1 << INDEX_BITS))
+			return NULL;
+
+		m_blocks.push_back(new SpriteInfo[BLOCK_SIZE]);
+		m_generations.resize(first + BLOCK_SIZE, 0);
+		m_denseIndices.resize(first + BLOCK_SIZE, -1);
+
+		// Lower slots are handed out first
+		for (int slot = first + BLOCK_SIZE - 1; slot >= first; slot--)
+			m_freeSlots.push_back(slot);
+	}
+
+	int slot = m_freeSlots.back();
+	m_freeSlots.pop_back();
+
+	SpriteInfo* spriteInfo = getSlot(slot);
+	*spriteInfo = SpriteInfo();
+	spriteInfo->id = makeHandle(slot);
+
+	m_denseIndices[slot] = (int)m_dense.size();
+	m_dense.push_back(spriteInfo);
+	m_denseSlots.push_back(slot);
+	return spriteInfo;
+}
+
+int SpritePool::remove(SpriteHandle p_handle)
+{
+	int slot = getSlotIndex(p_handle);
+	if (slot < 0)
+		return GAME_FAIL;
+
+	// The last live sprite takes the place of the removed one
+	int denseIndex = m_denseIndices[slot];
+	int lastSlot = m_denseSlots.back();
+	m_dense[denseIndex] = m_dense.back();
+	m_denseSlots[denseIndex] = lastSlot;
+	m_denseIndices[lastSlot] = denseIndex;
+	m_dense.pop_back();
+	m_denseSlots.pop_back();
+
+	m_denseIndices[slot] = -1;
+	m_generations[slot] = (m_generations[slot] + 1) & ((1 << GENERATION_BITS) - 1);
+	m_freeSlots.push_back(slot);
+	return GAME_OK;
+}
+
+void SpritePool::clear()
+{
+	// Storage is kept for reuse, only the live slots are released
+	while (!m_denseSlots.empty())
+		remove(makeHandle(m_denseSlots.back()));
+}
+
+SpriteInfo* SpritePool::get(SpriteHandle p_handle) const
+{
+	int slot = getSlotIndex(p_handle);
+	if (slot < 0)
+		return NULL;
+	return getSlot(slot);
+}
+
+bool SpritePool::isValid(SpriteHandle p_handle) const
+{
+	return getSlotIndex(p_handle) >= 0;
+}
+
+int SpritePool::getCount() const
+{
+	return (int)m_dense.size();
+}
+
+SpriteInfo* SpritePool::getSpriteInfo(int p_index) const
+{
+	return m_dense[p_index];
+}
+
+int SpritePool::getCapacity() const
+{
+	return (int)m_generations.size();
+}
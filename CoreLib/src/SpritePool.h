@@ -0,0 +1,58 @@
+#ifndef SPRITEPOOL_H
+#define SPRITEPOOL_H
+
+#include "SpriteInfo.h"
+#include <vector>
+
+using namespace std;
+
+// A handle is the slot index in the low bits, then the generation of the
+// slot and last the tag of the pool. The generation is bumped when a
+// sprite is removed, so handles to removed sprites can be detected.
+typedef int SpriteHandle;
+
+// Owns SpriteInfos in blocks of contiguous storage. Sprites never move,
+// so pointers handed out stay valid until the sprite is removed. Adding
+// and removing are O(1), and the live sprites are kept densely packed for
+// iteration. Every sprite's id is set to its handle.
+class SpritePool
+{
+private:
+	static const int BLOCK_SIZE			= 256;
+	static const int INDEX_BITS			= 20;
+	static const int GENERATION_BITS	= 10;
+
+	int					m_tag;
+	vector<SpriteInfo*>	m_blocks;
+	vector<int>			m_generations;	// Per slot
+	vector<int>			m_denseIndices;	// Per slot, -1 if the slot is free
+	vector<int>			m_freeSlots;
+	vector<SpriteInfo*>	m_dense;		// Live sprites
+	vector<int>			m_denseSlots;	// Slot of each live sprite
+
+private:
+	SpriteInfo*	getSlot(int p_slot) const;
+	SpriteHandle	makeHandle(int p_slot) const;
+	int			getSlotIndex(SpriteHandle p_handle) const;
+
+public:
+	static const SpriteHandle INVALID_HANDLE = -1;
+
+	// Pools with different tags never accept each other's handles
+				SpritePool(int p_tag = 0);
+	virtual		~SpritePool();
+
+	SpriteInfo*	add();
+	int			remove(SpriteHandle p_handle);
+	void		clear();
+
+	// Returns NULL if the sprite has been removed
+	SpriteInfo*	get(SpriteHandle p_handle) const;
+	bool		isValid(SpriteHandle p_handle) const;
+
+	int			getCount() const;
+	SpriteInfo*	getSpriteInfo(int p_index) const;
+	int			getCapacity() const;
+};
+
+#endif
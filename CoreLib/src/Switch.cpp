@@ -1,7 +1,7 @@
 #include "Switch.h"
 
 Switch::Switch(SpriteInfo* p_spriteInfo, Tile* p_tile, GameStats* p_gameStats,
-	vector<WallSwitch*> p_targets, SoundInfo* p_switchSound):
+	vector<WallSwitch*> p_targets, SoundInfo* p_switchSound, EntityStore* p_entities):
 	Collectable(p_spriteInfo, p_gameStats)
 {
 	m_targets = p_targets;
@@ -12,6 +12,14 @@ Switch::Switch(SpriteInfo* p_spriteInfo, Tile* p_tile, GameStats* p_gameStats,
 	m_consumed = false;
 	m_cooldown = 0;
 	m_switchSound = p_switchSound;
+
+	m_entities = NULL;
+	if (p_entities && p_spriteInfo)
+	{
+		m_entities = p_entities;
+		m_entity = m_entities->add(EntityKind::SWITCH, p_spriteInfo,
+			m_tile ? m_tile->getTilePosition() : TilePosition());
+	}
 }
 Switch::~Switch()
 {
@@ -22,8 +30,24 @@ void Switch::setTargets(vector<WallSwitch*> p_targets)
 {
 	m_targets = p_targets;
 }
+float Switch::getCooldown()
+{
+	if (m_entities)
+		return max(m_entities->getTimer(m_entity) - m_entities->getTime(), 0.0f);
+	return m_cooldown;
+}
+void Switch::setCooldown(float p_cooldown)
+{
+	if (m_entities)
+		m_entities->setTimer(m_entity, m_entities->getTime() + p_cooldown);
+	else
+		m_cooldown = p_cooldown;
+}
 void Switch::update(float p_deltaTime, InputInfo p_inputInfo)
 {
+	if (m_entities)
+		return;
+
 	if (m_cooldown == 0)
 	{
 		//m_spriteInfo->visible = true;
@@ -40,18 +64,24 @@ void Switch::update(float p_deltaTime, InputInfo p_inputInfo)
 void Switch::reset()
 {
 	m_spriteInfo->textureRect.x = 0;
-	m_cooldown = 0;
+	setCooldown(0);
+	// Its row may still sleep until the old cooldown ends
+	if (m_entities)
+		m_entities->wake(m_entity);
 }
 
 void Switch::consume()
 {
-	if (m_cooldown <= 0)
+	if (getCooldown() <= 0)
 	{
 		for (unsigned int i = 0; i < m_targets.size(); i++)
 		{
 			m_targets.at(i)->switchState();
 		}
 		m_switchSound->play = true;
-		m_cooldown = 5;
+		setCooldown(5);
+		// Wakes the switch in the store
+		if (m_entities)
+			m_entities->wake(m_entity);
 	}
 }
\ No newline at end of file
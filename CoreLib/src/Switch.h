@@ -6,6 +6,7 @@
 #include "Collectable.h"
 #include "IODevice.h"
 #include "WallSwitch.h"
+#include "EntityStore.h"
 
 class Switch: public Collectable
 {
@@ -14,9 +15,16 @@ private:
 	vector<WallSwitch*> m_targets;
 	float m_cooldown;
 	SoundInfo* m_switchSound;
+	EntityStore* m_entities;
+private:
+	// The cooldown is kept in the store when the switch is in one
+	float getCooldown();
+	void setCooldown(float p_cooldown);
 public:
+	// A switch given a store has its cooldown run by it and not by update
 	Switch(SpriteInfo* p_spriteInfo, Tile* p_tile, GameStats* p_gameStats,
-		vector<WallSwitch*> p_targets, SoundInfo* p_switchSound);
+		vector<WallSwitch*> p_targets, SoundInfo* p_switchSound,
+		EntityStore* p_entities = NULL);
 	~Switch();
 	void setTargets(vector<WallSwitch*> p_targets);
 	void update(float p_deltaTime, InputInfo p_inputInfo);
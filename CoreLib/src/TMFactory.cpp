@@ -76,9 +76,9 @@ Tile* TMFactory::CreateWallTile(int p_type, TilePosition p_position,int p_tileSi
 								p_position.y * p_tileSizeY + p_tileSizeY * 0.5f, 0.0f);
 	fVector2 size	= fVector2( (float)(p_tileSizeX), (float)(p_tileSizeY) );
 
-	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r);
+	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r, true);
 	newTile = new Tile (false, p_position, (float)(p_tileSizeX),
-		(float)(p_tileSizeY), sprite);
+		(float)(p_tileSizeY), sprite, m_io);
 
 	return newTile;
 }
@@ -98,9 +98,9 @@ Tile* TMFactory::CreatePathTile(int p_type, TilePosition p_position,int p_tileSi
 								p_position.y * p_tileSizeY + p_tileSizeY * 0.5f, 0.0f);
 	fVector2 size	= fVector2( (float)(p_tileSizeX), (float)(p_tileSizeY) );
 
-	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r);
+	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r, true);
 	newTile = new Tile(true, p_position, (float)(p_tileSizeX),
-		(float)(p_tileSizeY), sprite);
+		(float)(p_tileSizeY), sprite, m_io);
 
 	return newTile;
 }
@@ -121,9 +121,9 @@ Tile* TMFactory::CreateDecorationTile(int p_type, TilePosition p_position,int p_
 		p_position.y * p_tileSizeY + p_tileSizeY * 0.5f, 0.0f);
 	fVector2 size	= fVector2( (float)(p_tileSizeX), (float)(p_tileSizeY) );
 
-	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r);
+	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r, true);
 	newTile = new Tile(true, p_position, (float)(p_tileSizeX),
-		(float)(p_tileSizeY),sprite);
+		(float)(p_tileSizeY), sprite, m_io);
 
 	return newTile;
 }
@@ -144,9 +144,9 @@ Tile* TMFactory::CreateBasicWalkableTile(TilePosition p_position, int p_tileSize
 								p_position.y * p_tileSizeY + p_tileSizeY * 0.5f, 0.0f);
 	fVector2 size	= fVector2( (float)(p_tileSizeX), (float)(p_tileSizeY) );
 
-	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r);
+	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r, true);
 	newTile = new Tile(true, p_position, (float)(p_tileSizeX),
-		(float)(p_tileSizeY), sprite);
+		(float)(p_tileSizeY), sprite, m_io);
 
 	return newTile;
 }
@@ -167,9 +167,9 @@ Tile* TMFactory::CreateWallSwitch(int p_type,TilePosition p_position, int p_tile
 								p_position.y * p_tileSizeY + p_tileSizeY * 0.5f, 0.0f);
 	fVector2 size	= fVector2( (float)(p_tileSizeX), (float)(p_tileSizeY) );
 
-	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r);
+	SpriteInfo* sprite = m_GOFactory->CreateSpriteInfo(m_currentTileMap, pos,size, &r, true);
 	newTile = new Tile(false, p_position, (float)(p_tileSizeX),
-		(float)(p_tileSizeY), sprite);
+		(float)(p_tileSizeY), sprite, m_io);
 
 	return newTile;
 }
@@ -1,14 +1,20 @@
 #include "Tile.h"
 #include "Pill.h"
+#include "PillField.h"
+#include "Tilemap.h"
 
-Tile::Tile(bool p_type, TilePosition p_position, float p_width, float p_height, SpriteInfo* p_spriteInfo): GameObject(p_spriteInfo)
+Tile::Tile(bool p_type, TilePosition p_position, float p_width, float p_height,
+	SpriteInfo* p_spriteInfo, IODevice* p_io): GameObject(p_spriteInfo)
 {
+	m_io = p_io;
 	m_width = p_width;
 	m_height = p_height;
 
 	m_position = p_position;
 	m_type = p_type;
 	m_collectable = NULL;
+	m_pillField = NULL;
+	m_tilemap = NULL;
 }
 Tile::~Tile()
 {
@@ -50,8 +56,14 @@ bool Tile::removePill()
 			m_collectable = NULL;
 		return true;
 	}
+	if (m_pillField)
+		return m_pillField->eat(m_position);
 	return false;
 }
+void Tile::setPillField(PillField* p_pillField)
+{
+	m_pillField = p_pillField;
+}
 void Tile::switchState()
 {
 	m_type = !m_type;
@@ -59,10 +71,24 @@ void Tile::switchState()
 		m_spriteInfo->visible = false;
 	else
 		m_spriteInfo->visible = true;
+
+	// The tile sprite is part of the baked tile layer
+	if (m_io)
+		m_io->invalidateStaticLayer();
+	if (m_tilemap)
+		m_tilemap->topologyChanged(this);
 }
 void Tile::setWalkAble(bool p_walkAble)
 {
+	if (m_type == p_walkAble)
+		return;
 	m_type = p_walkAble;
+	if (m_tilemap)
+		m_tilemap->topologyChanged(this);
+}
+void Tile::setTilemap(Tilemap* p_tilemap)
+{
+	m_tilemap = p_tilemap;
 }
 
 Collectable* Tile::getCollectable()
@@ -6,6 +6,8 @@
 #include "IODevice.h"
 
 class Pill;
+class PillField;
+class Tilemap;
 
 struct TilePosition
 {
@@ -49,10 +51,13 @@ private:
 	float			m_height;
 
 	Collectable*	m_collectable;
+	PillField*		m_pillField;
 	IODevice* m_io;
+	Tilemap*	m_tilemap;
 
 public:
-	Tile(bool p_type, TilePosition p_position, float p_width, float p_height, SpriteInfo* p_spriteInfo);
+	Tile(bool p_type, TilePosition p_position, float p_width, float p_height,
+		SpriteInfo* p_spriteInfo, IODevice* p_io = NULL);
 	~Tile();
 	bool getType();
 	TilePosition getTilePosition();
@@ -62,9 +67,13 @@ public:
 	bool isFree();
 	void addPill(Collectable* p_pill);
 	Collectable* getCollectable();
+	// Eats the collectable on the tile or, without one, the plain pill
 	bool removePill();
+	void setPillField(PillField* p_pillField);
 	void switchState();
 	void setWalkAble(bool p_walkAble);
+	// The map is told when the tile turns walkable or blocked
+	void setTilemap(Tilemap* p_tilemap);
 };
 
 #endif
\ No newline at end of file
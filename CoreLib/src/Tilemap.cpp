@@ -1,13 +1,53 @@
 #include "Tilemap.h"
+#include <cstdlib>
+
+SearchMethod Tilemap::s_defaultSearchMethod = SEARCH_ASTAR;
 
 Tilemap::Tilemap(int p_width, int p_height, Tile** p_tiles)
 {
 	m_width = p_width;
 	m_height = p_height;
 	m_tiles = p_tiles;
+	m_pathfinder = new AStar(p_width, p_height, p_tiles);
+	m_jumpPoints = new JumpPointSearch(p_width, p_height, p_tiles);
+	m_searchMethod = s_defaultSearchMethod;
+	m_hierarchy = NULL;
+	if (p_width * p_height >= HIERARCHY_MIN_TILES)
+		m_hierarchy = new HPAStar(p_width, p_height, p_tiles, CLUSTER_SIZE);
+	m_flowField = new FlowField(p_width, p_height, p_tiles);
+	m_pathCache = new PathCache(PATH_CACHE_SIZE);
+	m_freeTiles = new FreeTileIndex(p_width, p_height, p_tiles);
+	m_hazards = new HazardLayer(p_width, p_height);
+	m_topologyVersion = 0;
+	m_regionsDirty = true;
+	m_unreachable = 0;
+	m_walkable.resize((m_width * m_height + 31) / 32, 0);
+	for (int i = 0; i < m_width * m_height; i++)
+	{
+		m_tiles[i]->setTilemap(this);
+		if (m_tiles[i]->isFree())
+			m_walkable[i / 32] |= 1u << (i % 32);
+	}
+	Run blocked = {-1, -1};
+	m_rowRuns.resize(m_width * m_height, blocked);
+	m_columnRuns.resize(m_width * m_height, blocked);
+	for (int i = 0; i < m_width * m_height; i++)
+	{
+		if (m_rowRuns[i].first < 0)
+			buildRun(i % m_width, i / m_width, true);
+		if (m_columnRuns[i].first < 0)
+			buildRun(i % m_width, i / m_width, false);
+	}
 }
 Tilemap::~Tilemap()
 {
+	delete m_pathfinder;
+	delete m_jumpPoints;
+	delete m_hierarchy;
+	delete m_flowField;
+	delete m_pathCache;
+	delete m_freeTiles;
+	delete m_hazards;
 	for (int i = 0; i < m_width * m_height; i++)
 	{
 		delete m_tiles[i];
@@ -23,35 +63,245 @@ Tile* Tilemap::getTile(TilePosition p_position)
 }
 Tile* Tilemap::closestFreeTile(Tile* p_start)
 {
-	TilePosition min = p_start->getTilePosition() - TilePosition(1, 1);
-	TilePosition max = p_start->getTilePosition() + TilePosition(1, 1);
+	TilePosition position = p_start->getTilePosition();
+	int nearest = m_freeTiles->getNearest(position.y * m_width + position.x);
+	if (nearest < 0)
+		return NULL;
+	return m_tiles[nearest];
+}
+Tile* Tilemap::randomFreeTile()
+{
+	if (m_freeTiles->getFreeCount() == 0)
+		return NULL;
+	return m_tiles[m_freeTiles->getFreeTile(rand() % m_freeTiles->getFreeCount())];
+}
+bool Tilemap::isValidPosition(TilePosition p_position)
+{
+	if (p_position.x < 0 || p_position.x >= m_width)
+		return false;
+	if (p_position.y < 0 || p_position.y >= m_height)
+		return false;
+	return true;
+}
+bool Tilemap::isFree(TilePosition p_position)
+{
+	return isFree(p_position.x, p_position.y);
+}
+bool Tilemap::isFree(int p_x, int p_y)
+{
+	if (p_x < 0 || p_x >= m_width || p_y < 0 || p_y >= m_height)
+		return false;
+	int index = p_y * m_width + p_x;
+	return (m_walkable[index / 32] >> (index % 32)) & 1;
+}
+bool Tilemap::isLineFree(Tile* p_from, Tile* p_to)
+{
+	TilePosition from = p_from->getTilePosition();
+	TilePosition to = p_to->getTilePosition();
+	if (from == to)
+		return true;
+	if (from.y == to.y)
+	{
+		Run run = m_rowRuns[from.y * m_width + from.x];
+		if (run.first < 0)
+			return false;
+		return to.x > from.x ? run.last >= to.x - 1 : run.first <= to.x + 1;
+	}
+	if (from.x == to.x)
+	{
+		Run run = m_columnRuns[from.y * m_width + from.x];
+		if (run.first < 0)
+			return false;
+		return to.y > from.y ? run.last >= to.y - 1 : run.first <= to.y + 1;
+	}
+	return false;
+}
+Tile* Tilemap::farthestFreeTile(Tile* p_start, TilePosition p_direction)
+{
+	TilePosition start = p_start->getTilePosition();
+	int index = start.y * m_width + start.x;
+	if (p_direction.x != 0 && m_rowRuns[index].first >= 0)
+	{
+		int x = p_direction.x > 0 ? m_rowRuns[index].last : m_rowRuns[index].first;
+		return m_tiles[start.y * m_width + x];
+	}
+	if (p_direction.y != 0 && m_columnRuns[index].first >= 0)
+	{
+		int y = p_direction.y > 0 ? m_columnRuns[index].last : m_columnRuns[index].first;
+		return m_tiles[y * m_width + start.x];
+	}
+	return p_start;
+}
+bool Tilemap::findPath(Tile* p_start, Tile* p_goal, vector<Tile*>* out_path)
+{
+	TilePosition startPosition = p_start->getTilePosition();
+	TilePosition goalPosition = p_goal->getTilePosition();
+	int start = startPosition.y * m_width + startPosition.x;
+	int goal = goalPosition.y * m_width + goalPosition.x;
+
+	if (!isReachable(start, goal))
+		return false;
 
-	while (min.x >= 0 || min.y >= 0 || max.x < m_width || max.y < m_height)
+	bool found;
+	if (m_pathCache->find(start, goal, m_topologyVersion, &found, out_path))
+		return found;
+	if (m_searchMethod == SEARCH_JUMP_POINTS)
+		found = m_jumpPoints->findPath(p_start, p_goal, out_path);
+	else
+		found = m_pathfinder->findPath(p_start, p_goal, out_path);
+	m_pathCache->store(start, goal, m_topologyVersion, found, *out_path);
+	return found;
+}
+bool Tilemap::findRoute(Tile* p_start, Tile* p_goal, vector<Tile*>* out_route)
+{
+	TilePosition startPosition = p_start->getTilePosition();
+	TilePosition goalPosition = p_goal->getTilePosition();
+	if (!isReachable(startPosition.y * m_width + startPosition.x,
+		goalPosition.y * m_width + goalPosition.x))
 	{
-		for (int row = min.y; row <= max.y; row++)
+		return false;
+	}
+
+	if (m_hierarchy)
+		return m_hierarchy->findRoute(p_start, p_goal, out_route);
+	out_route->clear();
+	out_route->push_back(p_goal);
+	if (p_goal != p_start)
+		out_route->push_back(p_start);
+	return true;
+}
+bool Tilemap::isReachable(int p_start, int p_goal)
+{
+	// Goals in another region can't be reached, no need to search
+	if (m_regionsDirty)
+		buildRegions();
+	if (p_start != p_goal && m_regions[p_goal] != m_regions[p_start] &&
+		(m_regions[p_goal] < 0 || m_regions[p_start] >= 0))
+	{
+		m_unreachable++;
+		return false;
+	}
+	return true;
+}
+void Tilemap::setSearchMethod(SearchMethod p_method)
+{
+	m_searchMethod = p_method;
+}
+SearchMethod Tilemap::getSearchMethod()
+{
+	return m_searchMethod;
+}
+void Tilemap::setDefaultSearchMethod(SearchMethod p_method)
+{
+	s_defaultSearchMethod = p_method;
+}
+HPAStar* Tilemap::getHierarchy()
+{
+	return m_hierarchy;
+}
+FlowField* Tilemap::getFlowField()
+{
+	return m_flowField;
+}
+PathCache* Tilemap::getPathCache()
+{
+	return m_pathCache;
+}
+HazardLayer* Tilemap::getHazards()
+{
+	return m_hazards;
+}
+void Tilemap::topologyChanged(Tile* p_tile)
+{
+	TilePosition position = p_tile->getTilePosition();
+	int index = position.y * m_width + position.x;
+	if (p_tile->isFree())
+		m_walkable[index / 32] |= 1u << (index % 32);
+	else
+		m_walkable[index / 32] &= ~(1u << (index % 32));
+	m_freeTiles->tileChanged(index);
+	for (int i = -1; i <= 1; i++)
+	{
+		buildRun(position.x + i, position.y, true);
+		buildRun(position.x, position.y + i, false);
+	}
+
+	m_topologyVersion++;
+	m_regionsDirty = true;
+	m_flowField->invalidate();
+	if (m_hierarchy)
+		m_hierarchy->tileChanged(p_tile);
+}
+unsigned int Tilemap::getTopologyVersion()
+{
+	return m_topologyVersion;
+}
+int Tilemap::getUnreachableCount()
+{
+	return m_unreachable;
+}
+void Tilemap::buildRun(int p_x, int p_y, bool p_row)
+{
+	if (!isValidPosition(TilePosition(p_x, p_y)))
+		return;
+	vector<Run>& runs = p_row ? m_rowRuns : m_columnRuns;
+	if (!isFree(p_x, p_y))
+	{
+		runs[p_y * m_width + p_x].first = -1;
+		runs[p_y * m_width + p_x].last = -1;
+		return;
+	}
+
+	int dx = p_row ? 1 : 0;
+	int dy = p_row ? 0 : 1;
+	TilePosition first(p_x, p_y);
+	TilePosition last(p_x, p_y);
+	while (isFree(first.x - dx, first.y - dy))
+		first = first - TilePosition(dx, dy);
+	while (isFree(last.x + dx, last.y + dy))
+		last = last + TilePosition(dx, dy);
+
+	Run run;
+	run.first = p_row ? first.x : first.y;
+	run.last = p_row ? last.x : last.y;
+	for (TilePosition p = first; !(p == last + TilePosition(dx, dy)); p = p + TilePosition(dx, dy))
+		runs[p.y * m_width + p.x] = run;
+}
+void Tilemap::buildRegions()
+{
+	m_regions.assign(m_width * m_height, -1);
+	m_regionsDirty = false;
+
+	vector<int> queue;
+	int region = 0;
+	for (int i = 0; i < m_width * m_height; i++)
+	{
+		if (m_regions[i] >= 0 || !isFree(i % m_width, i / m_width))
+			continue;
+
+		// Flood fill everything reachable from this tile
+		queue.clear();
+		queue.push_back(i);
+		m_regions[i] = region;
+		for (unsigned int j = 0; j < queue.size(); j++)
 		{
-			for (int col = min.x; col <= max.x; col++)
+			TilePosition p(queue[j] % m_width, queue[j] / m_width);
+			TilePosition neighbours[] = {p + TilePosition(0, 1), p + TilePosition(0, -1),
+				p + TilePosition(1, 0), p + TilePosition(-1, 0)};
+			for (int k = 0; k < 4; k++)
 			{
-				if (row == min.y || row == max.y || col == min.x || col == max.x)
+				if (!isFree(neighbours[k]))
+					continue;
+				int index = neighbours[k].y * m_width + neighbours[k].x;
+				if (m_regions[index] < 0)
 				{
-					Tile* t = getTile(TilePosition(col, row));
-					if (t && t->isFree())
-						return t;
+					m_regions[index] = region;
+					queue.push_back(index);
 				}
 			}
 		}
-		min = min - TilePosition(1, 1);
-		max = max + TilePosition(1, 1);
+		region++;
 	}
-	return 0;
-}
-bool Tilemap::isValidPosition(TilePosition p_position)
-{
-	if (p_position.x < 0 || p_position.x >= m_width)
-		return false;
-	if (p_position.y < 0 || p_position.y >= m_height)
-		return false;
-	return true;
 }
 int Tilemap::getWidth()
 {
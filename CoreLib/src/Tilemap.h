@@ -2,20 +2,108 @@
 #define TILEMAP_H
 
 #include "Tile.h"
+#include "AStar.h"
+#include "JumpPointSearch.h"
+#include "HPAStar.h"
+#include "FlowField.h"
+#include "PathCache.h"
+#include "FreeTileIndex.h"
+#include "HazardLayer.h"
 #include "IODevice.h"
 
+enum SearchMethod
+{
+	SEARCH_ASTAR,
+	SEARCH_JUMP_POINTS
+};
+
 class Tilemap
 {
 private:
+	static SearchMethod s_defaultSearchMethod;
+
+	static const int PATH_CACHE_SIZE = 64;
+	// Maps with at least this many tiles are searched in clusters
+	static const int HIERARCHY_MIN_TILES = 64 * 64;
+	static const int CLUSTER_SIZE = 10;
+
 	Tile**		m_tiles;
 	int			m_width;
 	int			m_height;
+	AStar*		m_pathfinder;
+	JumpPointSearch* m_jumpPoints;
+	SearchMethod m_searchMethod;
+	HPAStar*	m_hierarchy;
+	FlowField*	m_flowField;
+	PathCache*	m_pathCache;
+	FreeTileIndex* m_freeTiles;
+	HazardLayer* m_hazards;
+	unsigned int m_topologyVersion;
+
+	// One bit per tile, set while it is walkable, so loops over neighbours
+	// don't have to load every Tile
+	vector<unsigned int> m_walkable;
+
+	// Where the walkable run along a row or column that each tile is in
+	// starts and ends, -1 for blocked tiles
+	struct Run
+	{
+		int first;
+		int last;
+	};
+	vector<Run>	m_rowRuns;
+	vector<Run>	m_columnRuns;
+
+	// Connected free tiles share a region, -1 for blocked tiles
+	vector<int>	m_regions;
+	bool		m_regionsDirty;
+	int			m_unreachable;
+private:
+	// Measures the run through the tile again, along a row or a column
+	void buildRun(int p_x, int p_y, bool p_row);
+	void buildRegions();
+	// False, and counted, if the goal is in another region
+	bool isReachable(int p_start, int p_goal);
 public:
 	Tilemap(int p_width, int p_height, Tile** p_tiles);
 	virtual ~Tilemap();
 	Tile* getTile(TilePosition p_position);
+	// The walkable tile closest to p_start in square rings, p_start itself
+	// if it is walkable. NULL if no tile is.
 	Tile* closestFreeTile(Tile* p_start);
+	// A walkable tile picked with rand(), NULL if no tile is
+	Tile* randomFreeTile();
 	bool isValidPosition(TilePosition p_position);
+	// Reads the walkable bits, false outside the map
+	bool isFree(TilePosition p_position);
+	bool isFree(int p_x, int p_y);
+	// True if p_from and p_to share a row or column and every tile from
+	// p_from up to the one before p_to is walkable
+	bool isLineFree(Tile* p_from, Tile* p_to);
+	// The last walkable tile reached going from p_start in a row or column
+	// direction, p_start itself if it is blocked
+	Tile* farthestFreeTile(Tile* p_start, TilePosition p_direction);
+	bool findPath(Tile* p_start, Tile* p_goal, vector<Tile*>* out_path);
+	// Waypoints from the goal back to the start, a path between two
+	// following waypoints is short to search. Small maps only give the
+	// goal and the start.
+	bool findRoute(Tile* p_start, Tile* p_goal, vector<Tile*>* out_route);
+	// Which search findPath uses, both give paths of the same length
+	void setSearchMethod(SearchMethod p_method);
+	SearchMethod getSearchMethod();
+	// Search used by maps created from now on
+	static void setDefaultSearchMethod(SearchMethod p_method);
+	HPAStar* getHierarchy();
+	FlowField* getFlowField();
+	PathCache* getPathCache();
+	// Flames and other tiles that hurt, shared by everything on the map
+	HazardLayer* getHazards();
+	// Called by tiles when they turn walkable or blocked, drops the
+	// cached paths and fields
+	void topologyChanged(Tile* p_tile);
+	unsigned int getTopologyVersion();
+	// Searches answered from the regions without a search
+	int getUnreachableCount();
 	int getWidth();
 	int getHeight();
 };
@@ -9,4 +9,8 @@ Trap::~Trap()
 }
 void Trap::update(float p_deltaTime, InputInfo p_inputInfo)
 {
+}
+bool Trap::isIdle()
+{
+	return true;
 }
\ No newline at end of file
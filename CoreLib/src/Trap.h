@@ -10,6 +10,8 @@ public:
 	Trap(SpriteInfo* p_spriteInfo, Tile* p_tile, Tilemap* p_map);
 	virtual ~Trap();
 	void	update(float p_deltaTime, InputInfo p_inputInfo);
+	// Nothing changes on its own
+	bool	isIdle();
 };
 
 #endif
\ No newline at end of file
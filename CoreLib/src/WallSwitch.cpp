@@ -13,6 +13,11 @@ void WallSwitch::update(float p_deltaTime, InputInfo p_inputInfo)
 
 }
 
+bool WallSwitch::isIdle()
+{
+	return true;
+}
+
 void WallSwitch::switchState()
 {
 	if(m_tile->getType() == false)	// Not walkable.
@@ -15,6 +15,8 @@ public:
 	WallSwitch(SpriteInfo* p_spriteInfo, Tile* p_tile);
 	void update(float p_deltaTime, InputInfo p_inputInfo);
 	void reset();
+	// Only changes when its switch is pressed
+	bool isIdle();
 	void switchState();
 };
 
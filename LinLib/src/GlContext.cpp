@@ -8,10 +8,11 @@ GlContext::GlContext(int p_screenWidth, int p_screenHeight, bool p_windowed )
 {
 	s_instance				= this;
 	m_totalGameTime			= 0;
+	m_spriteRenderer		= NULL;
+	m_batchedRendering		= true;
 
-	// Create texture manager and load default texture
-	m_textureManager = new GlTextureManager();
-	m_textureManager->getTexture("../Textures/default.png");
+	m_textureManager		= NULL;
+	m_postProcess			= NULL;
 
 	m_initialized			= false;
 	if (init() != GAME_OK)
@@ -21,11 +22,15 @@ GlContext::GlContext(int p_screenWidth, int p_screenHeight, bool p_windowed )
 }
 GlContext::~GlContext()
 {
+	// GL resources have to be released while the context still exists
+	clearStaticBatches();
+	delete m_postProcess;
+	delete m_spriteRenderer;
+	delete m_textureManager;
+
 	if (m_initialized)
 		glfwTerminate();
 
-	delete m_spriteRenderer;
-	delete m_textureManager;
 	s_instance = NULL;
 }
 int GlContext::init()
@@ -41,10 +46,19 @@ int GlContext::init()
 	glfwSetWindowTitle("Den lille ostpojken");
 	glfwEnable( GLFW_STICKY_KEYS );
 	glViewport(0, 0, getScreenWidth(), getScreenHeight());
+
+	// Create texture manager and load default texture. Needs a GL context
+	// since textures are uploaded as soon as they are loaded.
+	m_textureManager = new GlTextureManager();
+	m_textureManager->getTexture("../Textures/default.png");
+
 	m_spriteRenderer = new GlSpriteRenderer(this);
 	if (!m_spriteRenderer->isInitialized())
 		return GAME_FAIL;
 
+	// Without offscreen targets the scene effects are skipped
+	m_postProcess = new GlPostProcess();
+
 	initKeyMappings();
 
 	glfwSetWindowSizeCallback(setWindowSizeCB);
@@ -170,35 +184,231 @@ int GlContext::update(float p_dt)
 
 int GlContext::beginDraw()
 {
+	// Scene effects need the whole frame, so it's drawn offscreen first
+	if (hasSceneEffects())
+		m_postProcess->begin(getScreenWidth(), getScreenHeight());
+
+	// Textures decoded since the last frame are uploaded between frames
+	if (m_textureManager->update() > 0)
+		updateTextures();
+
 	glClearColor(0, 0, 0, 1.0);
 	glClearDepth(1.0);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	m_drawCalls = 0;
+	m_spriteRenderer->beginFrame();
 	return GAME_OK;
 }
 
 int GlContext::drawSprite( SpriteInfo* p_spriteInfo )
 {
-	m_spriteRenderer->setSpriteInfo(p_spriteInfo);
+	if(!p_spriteInfo->visible)
+		return GAME_OK;
 
-	if( p_spriteInfo->textureIndex >= 0 )
+	TextureRegion texture;
+	if(m_textureManager->getTextureRegion(p_spriteInfo->textureIndex, 
+		&texture) != GAME_OK)
 	{
-		GLuint texture = 0;
-		m_textureManager->getTexture(p_spriteInfo->textureIndex, &texture);
-		if(texture != NULL)
-			m_spriteRenderer->setTexture(texture);
+		return GAME_FAIL;
 	}
 
-	if(p_spriteInfo->visible)
+	if(isBatchedRendering())
+	{
+		queueSprite(p_spriteInfo, texture);
+	}
+	else
+	{
+		m_spriteRenderer->setSpriteInfo(p_spriteInfo);
+		m_spriteRenderer->setTexture(texture);
 		m_spriteRenderer->draw();
+		m_drawCalls++;
+	}
+	return GAME_OK;
+}
+
+int GlContext::drawInstances(SpriteInfo* p_spriteInfo)
+{
+	if (!isBatchedRendering())
+		return IOContext::drawInstances(p_spriteInfo);
+	if (!p_spriteInfo->visible)
+		return GAME_OK;
+
+	TextureRegion texture;
+	if(m_textureManager->getTextureRegion(p_spriteInfo->textureIndex, 
+		&texture) != GAME_OK)
+	{
+		return GAME_FAIL;
+	}
+
+	// Every instance shares the texture, so they all join one batch
+	SpriteInfo instance = *p_spriteInfo;
+	for (int i = 0; i < p_spriteInfo->instanceCount; i++)
+	{
+		instance.transformInfo = p_spriteInfo->instances[i];
+		queueSprite(&instance, texture);
+	}
 	return GAME_OK;
 }
 
 int GlContext::endDraw()
 {
+	flushFrameBatch();
+	if (m_postProcess->isActive())
+	{
+		m_postProcess->end(getSceneBlackAndWhite(), getSceneFadeToBlack());
+		m_drawCalls++;
+	}
+	m_textureBinds = m_spriteRenderer->getTextureBindCount();
 	glfwSwapBuffers();
 	return GAME_OK;
 }
 
+int GlContext::buildStaticLayer(const vector<SpriteInfo*>& p_spriteInfos)
+{
+	m_staticSpriteInfos = p_spriteInfos;
+	clearStaticBatches();
+	if (!isBatchedRendering())
+		return IOContext::buildStaticLayer(p_spriteInfos);
+	IOContext::buildStaticLayer(vector<SpriteInfo*>());
+
+	// The static layer is drawn first, so its sprites can be grouped per
+	// page regardless of order.
+	for (unsigned int i = 0; i < p_spriteInfos.size(); i++)
+	{
+		TextureRegion texture;
+		if (p_spriteInfos[i]->visible && m_textureManager->getTextureRegion(
+			p_spriteInfos[i]->textureIndex, &texture) == GAME_OK)
+		{
+			batchSprite(p_spriteInfos[i], texture);
+		}
+	}
+	for (unsigned int i = 0; i < m_batchOrder.size(); i++)
+	{
+		SpriteBatch& batch = m_batches[m_batchOrder[i]];
+
+		StaticBatch staticBatch;
+		staticBatch.texture			= batch.texture;
+		staticBatch.instanceCount	= (int)batch.instances.size();
+		staticBatch.instanceBuffer	= m_spriteRenderer->createInstanceBuffer(
+			&batch.instances[0], staticBatch.instanceCount);
+		m_staticBatches.push_back(staticBatch);
+
+		batch.instances.clear();
+	}
+	m_batchOrder.clear();
+	return GAME_OK;
+}
+
+int GlContext::drawStaticLayer()
+{
+	if (!isBatchedRendering())
+		return IOContext::drawStaticLayer();
+
+	for (unsigned int i = 0; i < m_staticBatches.size(); i++)
+	{
+		StaticBatch& batch = m_staticBatches[i];
+		m_spriteRenderer->drawInstanceBuffer(batch.texture,
+			batch.instanceBuffer, batch.instanceCount);
+		m_drawCalls++;
+	}
+	return GAME_OK;
+}
+
+void GlContext::updateTextures()
+{
+	// The static layer holds texture coordinates of the placeholders
+	if (!m_staticBatches.empty())
+		buildStaticLayer(vector<SpriteInfo*>(m_staticSpriteInfos));
+}
+
+int GlContext::waitForPendingTextures()
+{
+	m_textureManager->waitForPendingTextures();
+	updateTextures();
+	return GAME_OK;
+}
+
+void GlContext::clearStaticBatches()
+{
+	for (unsigned int i = 0; i < m_staticBatches.size(); i++)
+		glDeleteBuffers(1, &m_staticBatches[i].instanceBuffer);
+	m_staticBatches.clear();
+}
+
+int GlContext::getTextureSortId(SpriteInfo* p_spriteInfo)
+{
+	// Sprites are batched per page, so sorting on the page is enough
+	TextureRegion texture;
+	if (m_textureManager->getTextureRegion(p_spriteInfo->textureIndex, 
+		&texture) != GAME_OK)
+	{
+		return 0;
+	}
+	return texture.page;
+}
+
+void GlContext::setBatchedRendering(bool p_batched)
+{
+	m_batchedRendering = p_batched;
+}
+
+bool GlContext::isBatchedRendering() const
+{
+	return m_batchedRendering && m_spriteRenderer->isInstancingSupported();
+}
+
+void GlContext::dumpAtlasOccupancy(ostream& p_stream)
+{
+	if (m_textureManager)
+		m_textureManager->dumpAtlasOccupancy(p_stream);
+}
+
+void GlContext::batchSprite(SpriteInfo* p_spriteInfo,
+	const TextureRegion& p_texture)
+{
+	if (p_texture.page >= (int)m_batches.size())
+		m_batches.resize(p_texture.page + 1);
+
+	SpriteBatch& batch = m_batches[p_texture.page];
+	if (batch.instances.empty())
+	{
+		batch.texture = p_texture.texture;
+		m_batchOrder.push_back(p_texture.page);
+	}
+
+	batch.instances.push_back(SpriteInstance());
+	GlSpriteRenderer::fillInstance(p_spriteInfo, p_texture,
+		&batch.instances.back());
+}
+
+void GlContext::queueSprite(SpriteInfo* p_spriteInfo,
+	const TextureRegion& p_texture)
+{
+	// Sprites arrive in draw order, so a batch can only grow while the
+	// page stays the same.
+	if (!m_frameBatch.instances.empty() && 
+		m_frameBatch.texture != p_texture.texture)
+	{
+		flushFrameBatch();
+	}
+
+	m_frameBatch.texture = p_texture.texture;
+	m_frameBatch.instances.push_back(SpriteInstance());
+	GlSpriteRenderer::fillInstance(p_spriteInfo, p_texture,
+		&m_frameBatch.instances.back());
+}
+
+void GlContext::flushFrameBatch()
+{
+	// The instance vector keeps its capacity between frames
+	if (m_frameBatch.instances.empty())
+		return;
+	m_spriteRenderer->drawInstances(m_frameBatch.texture,
+		&m_frameBatch.instances[0], (int)m_frameBatch.instances.size());
+	m_drawCalls++;
+	m_frameBatch.instances.clear();
+}
+
 int GlContext::getScreenWidth() const
 {
 	return m_screenWidth;
@@ -219,13 +429,13 @@ int GlContext::spriteSetUnindexedTexture(SpriteInfo* p_spriteInfo)
 	GLuint texture = 0;
 
 	int textureIndex = p_spriteInfo->textureIndex = m_textureManager->getTexture(
-		p_spriteInfo->textureFilePath, &texture);
+		p_spriteInfo->getTexturePath(), &texture);
 
 	if(texture == 0)
 		return GAME_FAIL;
 	else
 	{
-		spriteSetTextureRect(p_spriteInfo, texture);
+		spriteSetTextureRect(p_spriteInfo);
 		return GAME_OK;
 	}
 }
@@ -247,18 +457,16 @@ int GlContext::spriteSetDefaultTexture(SpriteInfo* p_spriteInfo)
 		return GAME_FAIL;
 	else
 	{
-		spriteSetTextureRect(p_spriteInfo, texture);
+		spriteSetTextureRect(p_spriteInfo);
 		return GAME_OK;
 	}
 }
 
-void GlContext::spriteSetTextureRect(SpriteInfo* p_spriteInfo, GLuint texture)
+void GlContext::spriteSetTextureRect(SpriteInfo* p_spriteInfo)
 {
-	glBindTexture(GL_TEXTURE_2D, texture);
-
-	int textureWidth, textureHeight;
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &textureWidth);
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &textureHeight);
+	int textureWidth = 0, textureHeight = 0;
+	m_textureManager->getTextureSize(p_spriteInfo->textureIndex, 
+		&textureWidth, &textureHeight);
 
 	p_spriteInfo->textureRect.width = textureWidth;
 	p_spriteInfo->textureRect.height = textureHeight;
@@ -267,11 +475,11 @@ void GlContext::spriteSetTextureRect(SpriteInfo* p_spriteInfo, GLuint texture)
 int GlContext::addSprite( SpriteInfo* p_spriteInfo)
 {
 	int textureReadSuccess = GAME_FAIL;
-	bool named = p_spriteInfo->textureFilePath != "";
+	bool named = p_spriteInfo->getTexturePath() != "";
 
 	if( named )
 	{
-		m_textureManager->getTexture(p_spriteInfo->textureFilePath);
+		m_textureManager->getTexture(p_spriteInfo->getTexturePath());
 		spriteSetUnindexedTexture( p_spriteInfo );
 		textureReadSuccess = GAME_OK;
 	}
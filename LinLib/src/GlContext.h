@@ -5,9 +5,25 @@
 #include <CommonUtility.h>
 #include "GlSpriteRenderer.h"
 #include "GlTextureManager.h"
+#include "GlPostProcess.h"
 
 class GlSpriteRenderer;
 
+// Instances collected for one texture during a frame.
+struct SpriteBatch
+{
+	GLuint					texture;
+	vector<SpriteInstance>	instances;
+};
+
+// Instances of the static layer, uploaded once per texture page.
+struct StaticBatch
+{
+	GLuint	texture;
+	GLuint	instanceBuffer;
+	int		instanceCount;
+};
+
 class GlContext: public IOContext
 {
 private:
@@ -23,6 +39,14 @@ private:
 	float				posY;
 	GlSpriteRenderer*	m_spriteRenderer;
 	GlTextureManager*	m_textureManager;
+	GlPostProcess*		m_postProcess;
+
+	bool				m_batchedRendering;
+	SpriteBatch			m_frameBatch;	// Consecutive sprites on one page
+	vector<SpriteBatch>	m_batches;		// Indexed by texture page
+	vector<int>			m_batchOrder;	// Texture pages in first-use order
+	vector<StaticBatch>	m_staticBatches;
+	vector<SpriteInfo*>	m_staticSpriteInfos;	// Kept to rebuild the layer
 
 private:
 	int init();
@@ -31,9 +55,15 @@ private:
 	int initGlew();
 	void initKeyMappings();
 
+	void batchSprite(SpriteInfo* p_spriteInfo, const TextureRegion& p_texture);
+	void queueSprite(SpriteInfo* p_spriteInfo, const TextureRegion& p_texture);
+	void flushFrameBatch();
+	void clearStaticBatches();
+	void updateTextures();
+
 	int spriteSetUnindexedTexture(SpriteInfo* p_spriteInfo);
 	int spriteSetDefaultTexture(SpriteInfo* p_spriteInfo);
-	void spriteSetTextureRect(SpriteInfo* p_spriteInfo, GLuint p_textureResourceView);  
+	void spriteSetTextureRect(SpriteInfo* p_spriteInfo);  
 public:
 							GlContext(int p_screenWidth, int p_screenHeight, bool p_windowed);
 	virtual					~GlContext();
@@ -46,8 +76,22 @@ public:
 
 	int						beginDraw();
 	int						drawSprite(SpriteInfo* p_spriteInfo);
+	int						drawInstances(SpriteInfo* p_spriteInfo);
 	int						endDraw();
 
+	int						buildStaticLayer(const vector<SpriteInfo*>& p_spriteInfos);
+	int						drawStaticLayer();
+
+	int						getTextureSortId(SpriteInfo* p_spriteInfo);
+	int						waitForPendingTextures();
+
+	// Draws consecutive sprites that share a texture page with one
+	// instanced call. Ignored if instancing isn't supported.
+	void					setBatchedRendering(bool p_batched);
+	bool					isBatchedRendering() const;
+
+	void					dumpAtlasOccupancy(ostream& p_stream);
+
 	int						getScreenWidth() const;
 	int						getScreenHeight() const;
 	static void GLFWCALL	setWindowSizeCB(int p_width, int p_height);
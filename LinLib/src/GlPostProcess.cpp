@@ -0,0 +1,205 @@
+#include "GlPostProcess.h"
+#include "GlSpriteShader.h"
+
+GlPostProcess::GlPostProcess()
+{
+	m_program		= 0;
+	m_vertexBuffer	= 0;
+	m_framebuffer	= 0;
+	m_colorTexture	= 0;
+	m_depthBuffer	= 0;
+	m_width			= 0;
+	m_height		= 0;
+	m_active		= false;
+	m_initialized	= false;
+
+	// Offscreen targets are core in GL 3.0
+	if (!GLEW_VERSION_3_0 && !GLEW_ARB_framebuffer_object)
+		return;
+	if (initializeShader() != GAME_OK)
+		return;
+	if (initializeGeometry() != GAME_OK)
+		return;
+
+	m_initialized = true;
+}
+GlPostProcess::~GlPostProcess()
+{
+	deleteTarget();
+	if (m_vertexBuffer)
+		glDeleteBuffers(1, &m_vertexBuffer);
+	if (m_program)
+		glDeleteProgram(m_program);
+}
+int GlPostProcess::initializeShader()
+{
+	GLuint vertexShader, fragmentShader;
+	GLint vsCompiled, fsCompiled, linked;
+
+	const char* vsCode = GlSpriteShader::readShader("../Shaders/postGL.vert");
+	const char* fsCode = GlSpriteShader::readShader("../Shaders/postGL.frag");
+
+	if (!vsCode || !fsCode)
+		return GAME_FAIL;
+
+	vertexShader = glCreateShader(GL_VERTEX_SHADER);
+	fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+	if (!vertexShader || !fragmentShader)
+		return GAME_FAIL;
+
+	glShaderSource(vertexShader, 1, (const GLchar**)&vsCode, NULL);
+	glShaderSource(fragmentShader, 1, (const GLchar**)&fsCode, NULL);	
+	glCompileShader(vertexShader);
+	glGetShaderiv(vertexShader, GL_COMPILE_STATUS, (GLint*)&vsCompiled);
+	glCompileShader(fragmentShader);
+	glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, (GLint*)&fsCompiled);
+
+	free((void*)vsCode);
+	free((void*)fsCode);
+
+	if (!vsCompiled || !fsCompiled)
+		return GAME_FAIL;
+
+	m_program = glCreateProgram();
+	glAttachShader(m_program, vertexShader);
+	glAttachShader(m_program, fragmentShader);
+
+	glLinkProgram(m_program);
+	glGetProgramiv(m_program, GL_LINK_STATUS, &linked);
+	if (!linked)
+		return GAME_FAIL;
+
+	m_position		= glGetAttribLocation(m_program, "Position");
+	m_sceneSampler	= glGetUniformLocation(m_program, "SceneSampler");
+	m_blackAndWhite	= glGetUniformLocation(m_program, "BlackAndWhite");
+	m_fadeToBlack	= glGetUniformLocation(m_program, "FadeToBlack");
+	return GAME_OK;
+}
+int GlPostProcess::initializeGeometry()
+{
+	// Two triangles covering the screen in clip space
+	float vertices[] =
+	{
+		-1.0f,  1.0f,
+		-1.0f, -1.0f,
+		 1.0f, -1.0f,
+		 1.0f, -1.0f,
+		 1.0f,  1.0f,
+		-1.0f,  1.0f
+	};
+
+	glGenBuffers(1, &m_vertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	return GAME_OK;
+}
+int GlPostProcess::createTarget(int p_width, int p_height)
+{
+	deleteTarget();
+
+	glGenTextures(1, &m_colorTexture);
+	glBindTexture(GL_TEXTURE_2D, m_colorTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, p_width, p_height, 0,
+		GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	// The sprites are depth tested, so the target needs a depth buffer
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24,
+		p_width, p_height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+		GL_TEXTURE_2D, m_colorTexture, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+		GL_RENDERBUFFER, m_depthBuffer);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		deleteTarget();
+		return GAME_FAIL;
+	}
+
+	m_width		= p_width;
+	m_height	= p_height;
+	return GAME_OK;
+}
+void GlPostProcess::deleteTarget()
+{
+	if (m_framebuffer)
+		glDeleteFramebuffers(1, &m_framebuffer);
+	if (m_depthBuffer)
+		glDeleteRenderbuffers(1, &m_depthBuffer);
+	if (m_colorTexture)
+		glDeleteTextures(1, &m_colorTexture);
+	m_framebuffer	= 0;
+	m_depthBuffer	= 0;
+	m_colorTexture	= 0;
+	m_width			= 0;
+	m_height		= 0;
+}
+int GlPostProcess::begin(int p_width, int p_height)
+{
+	m_active = false;
+	if (!m_initialized)
+		return GAME_FAIL;
+
+	if (p_width != m_width || p_height != m_height)
+	{
+		if (createTarget(p_width, p_height) != GAME_OK)
+			return GAME_FAIL;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	m_active = true;
+	return GAME_OK;
+}
+int GlPostProcess::end(float p_blackAndWhite, float p_fadeToBlack)
+{
+	if (!m_active)
+		return GAME_FAIL;
+	m_active = false;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// The target covers the whole screen, nothing to test or blend against
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+
+	glUseProgram(m_program);
+	glUniform1i(m_sceneSampler, 0);
+	glUniform1f(m_blackAndWhite, p_blackAndWhite);
+	glUniform1f(m_fadeToBlack, p_fadeToBlack);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, m_colorTexture);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	glVertexAttribPointer(m_position, 2, GL_FLOAT, GL_FALSE, 
+		sizeof(float) * 2, (void*)0);
+	if (GLEW_ARB_instanced_arrays)
+		glVertexAttribDivisorARB(m_position, 0);
+	glEnableVertexAttribArray(m_position);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glDisableVertexAttribArray(m_position);
+
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	return GAME_OK;
+}
+bool GlPostProcess::isActive()
+{
+	return m_active;
+}
+bool GlPostProcess::isInitialized()
+{
+	return m_initialized;
+}
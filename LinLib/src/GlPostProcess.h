@@ -0,0 +1,55 @@
+#ifndef GLPOSTPROCESS_H
+#define GLPOSTPROCESS_H
+
+#include <CommonUtility.h>
+#include <GL/glew.h>
+#include <GL/glfw.h>
+
+#ifdef _WIN32
+#include <GL/wglew.h>
+#endif
+
+// Full-screen pass for the scene-wide effects. While an effect is active
+// the frame is drawn into an offscreen target which is then drawn to the
+// screen with black and white and fade to black applied.
+class GlPostProcess
+{
+private:
+	GLuint	m_program;
+	GLint	m_position;
+	GLint	m_sceneSampler;
+	GLint	m_blackAndWhite;
+	GLint	m_fadeToBlack;
+	GLuint	m_vertexBuffer;
+
+	GLuint	m_framebuffer;
+	GLuint	m_colorTexture;
+	GLuint	m_depthBuffer;
+	int		m_width;
+	int		m_height;
+
+	bool	m_active;
+	bool	m_initialized;
+
+private:
+	int		initializeShader();
+	int		initializeGeometry();
+	int		createTarget(int p_width, int p_height);
+	void	deleteTarget();
+
+public:
+			GlPostProcess();
+	virtual	~GlPostProcess();
+
+	// Redirects drawing to the offscreen target, which is resized to the
+	// screen if needed.
+	int		begin(int p_width, int p_height);
+
+	// Draws the offscreen target to the screen with the given effects
+	int		end(float p_blackAndWhite, float p_fadeToBlack);
+
+	bool	isActive();
+	bool	isInitialized();
+};
+
+#endif
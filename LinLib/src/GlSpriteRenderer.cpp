@@ -9,11 +9,18 @@ GlSpriteRenderer::GlSpriteRenderer(GlContext* p_context)
 {
 	m_initialized	= false;
 	m_context		= p_context;
+	m_boundTexture	= 0;
+	m_textureBinds	= 0;
+	m_instancingSupported = false;
 	m_spriteShader	= new GlSpriteShader();
 	if (!m_spriteShader->isInitialized())
 		return;
 	if (initializeGeometry() != GAME_OK)
 		return;
+
+	// Instancing is optional, the per-sprite path is used without it
+	if (GLEW_ARB_instanced_arrays && GLEW_ARB_draw_instanced)
+		m_instancingSupported = initializeInstancing() == GAME_OK;
 	
 	m_positionX = 0;
 	m_positionY = 0;
@@ -22,6 +29,8 @@ GlSpriteRenderer::GlSpriteRenderer(GlContext* p_context)
 }
 GlSpriteRenderer::~GlSpriteRenderer()
 {
+	if (m_instancingSupported)
+		glDeleteBuffers(1, &m_instanceBuffer);
 	delete m_spriteShader;
 }
 int GlSpriteRenderer::initializeGeometry()
@@ -42,76 +51,197 @@ int GlSpriteRenderer::initializeGeometry()
 	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(SpriteVertex)*6, 
 		vertices, GL_STATIC_DRAW);
-
+	return 0;
+}
+void GlSpriteRenderer::setGeometryBuffer()
+{
 	//Map the CPU data to the shader data for the input assembler.
+	//Done before every draw since other passes reuse the attribute slots.
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
 	glVertexAttribPointer (m_spriteShader->getPostionIndex(), 3, GL_FLOAT, 
 		GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex,x));
 	glVertexAttribPointer (m_spriteShader->getTexCoordIndex(), 2, GL_FLOAT, 
 		GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex,s));
-	return 0;
+	if (m_instancingSupported)
+	{
+		glVertexAttribDivisorARB(m_spriteShader->getPostionIndex(), 0);
+		glVertexAttribDivisorARB(m_spriteShader->getTexCoordIndex(), 0);
+	}
 }
-void GlSpriteRenderer::setPosition(float p_positionX, float p_positionY)
+int GlSpriteRenderer::initializeInstancing()
 {
-	m_positionX = p_positionX;
-	m_positionY = p_positionY;
+	//The instance buffer is refilled for every batch
+	while (glGetError() != GL_NO_ERROR);
+	glGenBuffers(1, &m_instanceBuffer);
+	setInstanceBuffer(m_instanceBuffer);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	if (glGetError() != GL_NO_ERROR)
+	{
+		glDeleteBuffers(1, &m_instanceBuffer);
+		return GAME_FAIL;
+	}
+	return GAME_OK;
 }
-int GlSpriteRenderer::draw()
+void GlSpriteRenderer::setInstanceBuffer(GLuint p_buffer)
+{
+	//Points the per-instance attributes at the given buffer
+	glBindBuffer(GL_ARRAY_BUFFER, p_buffer);
+	setInstanceAttribute(m_spriteShader->getCenterPositionIndex(), 4,
+		offsetof(SpriteInstance, centerPosition));
+	setInstanceAttribute(m_spriteShader->getHalfScaleIndex(), 2,
+		offsetof(SpriteInstance, halfScale));
+	setInstanceAttribute(m_spriteShader->getTextureRectIndex(), 4,
+		offsetof(SpriteInstance, textureRect));
+	setInstanceAttribute(m_spriteShader->getColorOverlayIndex(), 4,
+		offsetof(SpriteInstance, colorOverlay));
+}
+void GlSpriteRenderer::setInstanceAttribute(GLint p_index, int p_components,
+	size_t p_offset)
+{
+	glVertexAttribPointer(p_index, p_components, GL_FLOAT, GL_FALSE,
+		sizeof(SpriteInstance), (void*)p_offset);
+	glVertexAttribDivisorARB(p_index, 1);
+}
+void GlSpriteRenderer::enableInstanceAttributes(bool p_enable)
+{
+	GLint indices[] = 
+	{
+		m_spriteShader->getCenterPositionIndex(),
+		m_spriteShader->getHalfScaleIndex(),
+		m_spriteShader->getTextureRectIndex(),
+		m_spriteShader->getColorOverlayIndex()
+	};
+	for (int i = 0; i < 4; i++)
+	{
+		if (p_enable)
+			glEnableVertexAttribArray(indices[i]);
+		else
+			glDisableVertexAttribArray(indices[i]);
+	}
+}
+void GlSpriteRenderer::useProgram()
 {
 	glUseProgram(m_spriteShader->getID());
-	 
-	glUniform4f(m_spriteShader->getCenterPositionConstant(), 
-		m_spriteInfo->transformInfo.translation[TransformInfo::X],
-		m_spriteInfo->transformInfo.translation[TransformInfo::Y],
-		m_spriteInfo->transformInfo.translation[TransformInfo::Z],
-		0.0f
+	glUniform2f(m_spriteShader->getScreenSizeConstant(), 
+		(GLfloat)m_context->getScreenWidth(), (GLfloat)m_context->getScreenHeight()
 	);
-
 	glActiveTexture(GL_TEXTURE0);
-	// :NOTE: Must bind texture before retrieving width and height
-	glBindTexture(GL_TEXTURE_2D, m_texture);
-
-	int textureWidth, textureHeight;
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &textureWidth);
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &textureHeight);
-
-	if (m_spriteInfo->textureIndex == 3)
+}
+void GlSpriteRenderer::bindTexture(GLuint p_texture)
+{
+	if (p_texture != m_boundTexture)
 	{
-		int i = 0;
+		glBindTexture(GL_TEXTURE_2D, p_texture);
+		m_boundTexture = p_texture;
+		m_textureBinds++;
 	}
+}
+void GlSpriteRenderer::fillInstance(SpriteInfo* p_spriteInfo,
+	const TextureRegion& p_texture, SpriteInstance* out_instance)
+{
+	TransformInfo& transform = p_spriteInfo->transformInfo;
+	out_instance->centerPosition[0] = transform.translation[TransformInfo::X];
+	out_instance->centerPosition[1] = transform.translation[TransformInfo::Y];
+	out_instance->centerPosition[2] = transform.translation[TransformInfo::Z];
+	out_instance->centerPosition[3] = 0.0f;
 
-	glUniform4f(m_spriteShader->getTextureRectConstant(),
-		(float)m_spriteInfo->textureRect.x / textureWidth,
-		(float)m_spriteInfo->textureRect.y / textureHeight,
-		(float)m_spriteInfo->textureRect.width / textureWidth,
-		(float)m_spriteInfo->textureRect.height / textureHeight
-	);
-	glUniform2f(m_spriteShader->getHalfScaleConstant(),
-		m_spriteInfo->transformInfo.scale[TransformInfo::X] / 2,
-		m_spriteInfo->transformInfo.scale[TransformInfo::Y] / 2
-	);
-	glUniform2f(m_spriteShader->getScreenSizeConstant(), 
-		(GLfloat)m_context->getScreenWidth(), (GLfloat)m_context->getScreenHeight()
-	);
+	// The texture rect is relative to the source image, offset it to where
+	// the image was placed in its page. A placeholder is drawn whole since
+	// the rect refers to the texture that is still loading.
+	Rect rect = p_spriteInfo->textureRect;
+	if (p_texture.placeholder)
+		rect = Rect(0, 0, p_texture.width, p_texture.height);
+	float pageWidth		= (float)p_texture.pageWidth;
+	float pageHeight	= (float)p_texture.pageHeight;
+	out_instance->textureRect[0] = (p_texture.x + rect.x) / pageWidth;
+	out_instance->textureRect[1] = (p_texture.y + rect.y) / pageHeight;
+	out_instance->textureRect[2] = rect.width / pageWidth;
+	out_instance->textureRect[3] = rect.height / pageHeight;
 
-	//Added by Anton
-	glUniform1f(m_spriteShader->getBWFraction(), m_spriteInfo->bwFraction);
-	glUniform1f(m_spriteShader->getFadeToBlackFraction(), m_spriteInfo->fadeToBlackFraction);
+	for (int i = 0; i < 4; i++)
+		out_instance->colorOverlay[i] = (float)p_spriteInfo->overlay[i];
 
-	glUniform4f(m_spriteShader->getColorOverlay(),
-		(float)m_spriteInfo->overlay[0],
-		(float)m_spriteInfo->overlay[1],
-		(float)m_spriteInfo->overlay[2],
-		(float)m_spriteInfo->overlay[3]
-	);
+	out_instance->halfScale[0] = transform.scale[TransformInfo::X] / 2;
+	out_instance->halfScale[1] = transform.scale[TransformInfo::Y] / 2;
+}
+void GlSpriteRenderer::setPosition(float p_positionX, float p_positionY)
+{
+	m_positionX = p_positionX;
+	m_positionY = p_positionY;
+}
+int GlSpriteRenderer::draw()
+{
+	useProgram();
+	bindTexture(m_texture.texture);
+
+	//The per-instance attributes are fed as constant attributes
+	SpriteInstance instance;
+	fillInstance(m_spriteInfo, m_texture, &instance);
+
+	glVertexAttrib4fv(m_spriteShader->getCenterPositionIndex(),
+		instance.centerPosition);
+	glVertexAttrib2fv(m_spriteShader->getHalfScaleIndex(), instance.halfScale);
+	glVertexAttrib4fv(m_spriteShader->getTextureRectIndex(),
+		instance.textureRect);
+	glVertexAttrib4fv(m_spriteShader->getColorOverlayIndex(),
+		instance.colorOverlay);
 
+	setGeometryBuffer();
 	glEnableVertexAttribArray(m_spriteShader->getPostionIndex());
 	glEnableVertexAttribArray(m_spriteShader->getTexCoordIndex());
-	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
 	glDrawArrays(GL_TRIANGLES, 0, 6);
 	glDisableVertexAttribArray(m_spriteShader->getPostionIndex());
 	glDisableVertexAttribArray(m_spriteShader->getTexCoordIndex());
 	return 0;
 }
+int GlSpriteRenderer::drawInstances(GLuint p_texture,
+	const SpriteInstance* p_instances, int p_instanceCount)
+{
+	if (!m_instancingSupported || p_instanceCount <= 0)
+		return GAME_FAIL;
+
+	//Orphan the previous contents so the driver doesn't have to wait
+	//for earlier batches to finish.
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(SpriteInstance) * p_instanceCount,
+		p_instances, GL_STREAM_DRAW);
+
+	return drawInstanceBuffer(p_texture, m_instanceBuffer, p_instanceCount);
+}
+GLuint GlSpriteRenderer::createInstanceBuffer(const SpriteInstance* p_instances,
+	int p_instanceCount)
+{
+	if (!m_instancingSupported || p_instanceCount <= 0)
+		return 0;
+
+	GLuint buffer = 0;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(SpriteInstance) * p_instanceCount,
+		p_instances, GL_STATIC_DRAW);
+	return buffer;
+}
+int GlSpriteRenderer::drawInstanceBuffer(GLuint p_texture, GLuint p_buffer,
+	int p_instanceCount)
+{
+	if (!m_instancingSupported || p_instanceCount <= 0)
+		return GAME_FAIL;
+
+	useProgram();
+	bindTexture(p_texture);
+	setInstanceBuffer(p_buffer);
+	setGeometryBuffer();
+
+	glEnableVertexAttribArray(m_spriteShader->getPostionIndex());
+	glEnableVertexAttribArray(m_spriteShader->getTexCoordIndex());
+	enableInstanceAttributes(true);
+	glDrawArraysInstancedARB(GL_TRIANGLES, 0, 6, p_instanceCount);
+	enableInstanceAttributes(false);
+	glDisableVertexAttribArray(m_spriteShader->getPostionIndex());
+	glDisableVertexAttribArray(m_spriteShader->getTexCoordIndex());
+	return GAME_OK;
+}
 
 /*
 GLboolean GlSpriteRenderer::load(string path)
@@ -148,12 +278,29 @@ bool GlSpriteRenderer::isInitialized()
 	return m_initialized;
 }
 
+bool GlSpriteRenderer::isInstancingSupported()
+{
+	return m_instancingSupported;
+}
+
 void GlSpriteRenderer::setSpriteInfo( SpriteInfo* p_spriteInfo )
 {
 	m_spriteInfo = p_spriteInfo;
 }
 
-void GlSpriteRenderer::setTexture(GLuint p_texture)
+void GlSpriteRenderer::setTexture(const TextureRegion& p_texture)
 {
 	m_texture = p_texture;
 }
+
+void GlSpriteRenderer::beginFrame()
+{
+	// Textures may have been bound elsewhere, e.g. while loading
+	m_boundTexture	= 0;
+	m_textureBinds	= 0;
+}
+
+int GlSpriteRenderer::getTextureBindCount()
+{
+	return m_textureBinds;
+}
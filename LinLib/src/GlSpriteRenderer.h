@@ -4,6 +4,7 @@
 #include <string>
 #include "GlContext.h"
 #include "GlSpriteShader.h"
+#include "GlTextureManager.h"
 #include "LodePNG.h"
 #include "SpriteInfo.h"
 
@@ -15,9 +16,13 @@ class GlSpriteRenderer
 {
 private:
 	GLuint			m_vertexBuffer;
+	GLuint			m_instanceBuffer;
 	float			m_positionX;
 	float			m_positionY;	
-	GLuint			m_texture;
+	TextureRegion	m_texture;
+	GLuint			m_boundTexture;
+	int				m_textureBinds;
+	bool			m_instancingSupported;
 	GlSpriteShader* m_spriteShader;
 	GlContext*		m_context;
 	bool			m_initialized;
@@ -25,6 +30,13 @@ private:
 
 private:
 	int initializeGeometry();
+	int initializeInstancing();
+	void setGeometryBuffer();
+	void setInstanceAttribute(GLint p_index, int p_components, size_t p_offset);
+	void setInstanceBuffer(GLuint p_buffer);
+	void enableInstanceAttributes(bool p_enable);
+	void useProgram();
+	void bindTexture(GLuint p_texture);
 
 	//temp
 //	GLboolean load(string path);
@@ -34,10 +46,27 @@ public:
 	virtual ~GlSpriteRenderer();
 	void	setPosition(float p_positionX, float p_positionY);
 	int		draw();
+	int		drawInstances(GLuint p_texture, const SpriteInstance* p_instances,
+				int p_instanceCount);
+
+	// Instance buffers that are kept between frames, e.g. for static layers.
+	// The caller owns the returned buffer.
+	GLuint	createInstanceBuffer(const SpriteInstance* p_instances,
+				int p_instanceCount);
+	int		drawInstanceBuffer(GLuint p_texture, GLuint p_buffer,
+				int p_instanceCount);
 	void	setSpriteInfo( SpriteInfo* p_spriteInfo );
-	void	setTexture( GLuint p_texture );
+	void	setTexture( const TextureRegion& p_texture );
+
+	// Resets the bound texture cache and the bind counter
+	void	beginFrame();
+	int		getTextureBindCount();
 
 	bool	isInitialized();
+	bool	isInstancingSupported();
+
+	static void fillInstance(SpriteInfo* p_spriteInfo,
+		const TextureRegion& p_texture, SpriteInstance* out_instance);
 };
 
 #endif
@@ -54,18 +54,18 @@ GlSpriteShader::GlSpriteShader()
 	m_position = glGetAttribLocation(m_id, "MCVertex");
 	m_texCoord = glGetAttribLocation(m_id, "MCTexCoord");
 
-	m_textureRectConstant		= glGetUniformLocation(m_id, "TextureRect");
-	m_centerPositionConstant	= glGetUniformLocation(m_id, "CenterPosition");
-	m_halfScaleConstant			= glGetUniformLocation(m_id, "HalfScale");
+	//Per-instance attributes
+	m_centerPosition	= glGetAttribLocation(m_id, "CenterPosition");
+	m_halfScale			= glGetAttribLocation(m_id, "HalfScale");
+	m_textureRect		= glGetAttribLocation(m_id, "TextureRect");
+	m_colorOverlay		= glGetAttribLocation(m_id, "ColorOverlay");
+
 	m_screenSizeConstant		= glGetUniformLocation(m_id, "ScreenSize");
-	m_bwFraction				= glGetUniformLocation(m_id, "bwFraction");
-	m_fadeToBlackFraction		= glGetUniformLocation(m_id, "fadeToBlack");
-	m_colorOverlay				= glGetUniformLocation(m_id, "colorOverlay");
 	m_sampler					= glGetUniformLocation(m_id, "gSampler");
 
 	m_initialized = true;
 }
-char* GlSpriteShader::readShader(char* p_path)
+char* GlSpriteShader::readShader(const char* p_path)
 {
     FILE* file;
     long length;
@@ -105,30 +105,25 @@ GLint GlSpriteShader::getTexCoordIndex()
 {
 	return m_texCoord;
 }
-GLint GlSpriteShader::getCenterPositionConstant()
-{	
-	return m_centerPositionConstant;
-}
-GLint GlSpriteShader::getHalfScaleConstant()
+GLint GlSpriteShader::getCenterPositionIndex()
 {
-	return m_halfScaleConstant;
+	return m_centerPosition;
 }
-GLint GlSpriteShader::getScreenSizeConstant()
+GLint GlSpriteShader::getHalfScaleIndex()
 {
-	return m_screenSizeConstant;
+	return m_halfScale;
 }
-
-GLint GlSpriteShader::getTextureRectConstant()
+GLint GlSpriteShader::getTextureRectIndex()
 {
-	return m_textureRectConstant;
+	return m_textureRect;
 }
-GLint GlSpriteShader::getBWFraction()
+GLint GlSpriteShader::getColorOverlayIndex()
 {
-	return m_bwFraction;
+	return m_colorOverlay;
 }
-GLint GlSpriteShader::getFadeToBlackFraction()
+GLint GlSpriteShader::getScreenSizeConstant()
 {
-	return m_fadeToBlackFraction;
+	return m_screenSizeConstant;
 }
 GLuint GlSpriteShader::getTextureSampler()
 {
@@ -138,8 +133,4 @@ bool GlSpriteShader::isInitialized()
 {
 	return m_initialized;
 }
-GLint GlSpriteShader::getColorOverlay()
-{
-	return m_colorOverlay;
-}
 
@@ -18,28 +18,24 @@ private:
 	GLuint	m_id;
 	GLint	m_position;
 	GLint	m_texCoord;
-	GLint	m_centerPositionConstant;
-	GLint	m_halfScaleConstant;
-	GLint	m_screenSizeConstant;
-	GLint	m_textureRectConstant;
-	GLint	m_bwFraction;
+	GLint	m_centerPosition;
+	GLint	m_halfScale;
+	GLint	m_textureRect;
 	GLint	m_colorOverlay;
-	GLint	m_fadeToBlackFraction;
+	GLint	m_screenSizeConstant;
 	GLuint	m_sampler;
 	bool	m_initialized;
 public:
 			GlSpriteShader();
-	char*	readShader(char* p_path);
+	static char*	readShader(const char* p_path);
 	GLuint	getID();
 	GLint	getPostionIndex();
 	GLint	getTexCoordIndex();
-	GLint	getCenterPositionConstant();
-	GLint	getHalfScaleConstant();
+	GLint	getCenterPositionIndex();
+	GLint	getHalfScaleIndex();
+	GLint	getTextureRectIndex();
+	GLint	getColorOverlayIndex();
 	GLint	getScreenSizeConstant();
-	GLint	getTextureRectConstant();
-	GLint	getBWFraction();
-	GLint	getFadeToBlackFraction();
-	GLint	getColorOverlay();
 	GLuint	getTextureSampler();
 	bool	isInitialized();
 };
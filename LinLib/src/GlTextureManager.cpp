@@ -1,62 +1,248 @@
 #include "GlTextureManager.h"
+#include <algorithm>
 
 GlTextureManager::GlTextureManager()
 {
+	// Pages can't be larger than what the driver supports
+	GLint maxSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	m_atlasPageSize = ATLAS_PAGE_SIZE;
+	if (maxSize > 0 && maxSize < m_atlasPageSize)
+		m_atlasPageSize = maxSize;
+
+	m_decoder = new AsyncPngDecoder();
+	m_startTime = AsyncPngDecoder::getTime();
+	m_readyTime = m_startTime;
 }
 
 GlTextureManager::~GlTextureManager()
 {
-	for(unsigned int i = 0; i < m_textures.size(); i++)
+	delete m_decoder;
+
+	for(unsigned int i = 0; i < m_pages.size(); i++)
 	{
-		glDeleteTextures( 1, &m_textures[i].textureResource );
+		glDeleteTextures( 1, &m_pages[i].texture );
+		delete m_pages[i].packer;
 	}
 }
 
+GLuint GlTextureManager::createTexture(int p_width, int p_height,
+	const unsigned char* p_data)
+{
+	GLuint texture = 0;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, p_width, p_height, 0, 
+		GL_RGBA, GL_UNSIGNED_BYTE, p_data);
+	glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+	return texture;
+}
+
 int GlTextureManager::loadTexture(string p_filePath,
 	vector<TextureWithName>* p_textures)
 {
 	int textureIndex = -1;
 
-	GLuint texture = 0;
+	// The first texture stands in for the others while they load, so it
+	// is the only one decoded right away.
+	if (!p_textures->empty())
+	{
+		int width = 0, height = 0;
+		if (AsyncPngDecoder::readSize(p_filePath, &width, &height) != GAME_OK)
+			return -1;
 
-	vector<unsigned char> rawImage;
-	lodepng::State state;
+		textureIndex = (int)p_textures->size();
+		TextureWithName texture((*p_textures)[0].region, p_filePath);
+		texture.region.placeholder	= true;
+		texture.loading				= true;
+		texture.width				= width;
+		texture.height				= height;
+		p_textures->push_back(texture);
 
-	lodepng::load_file(rawImage, p_filePath);
-	std::vector<unsigned char> image;
+		m_decoder->request(textureIndex, p_filePath);
+		return textureIndex;
+	}
 
-	unsigned int width = 0, height = 0, error = 0;
-	error = lodepng::decode(image, width, height, state, rawImage);
+	DecodedImage image(0, p_filePath);
+	AsyncPngDecoder::decode(&image);
 
-	if (error)
+	if (image.error)
 	{
-		const char* err = lodepng_error_text(error);
+		const char* err = lodepng_error_text(image.error);
 		textureIndex = -1;
 	}
 	else
 	{
-		glGenTextures(1, &texture);
-		glBindTexture(GL_TEXTURE_2D, texture);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, 
-			GL_RGBA, GL_UNSIGNED_BYTE, &image[0]);
-		glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
-		
+		TextureRegion region;
+		uploadImage(image.data, image.width, image.height, &region);
+
 		textureIndex = (int)m_textures.size();
 
-		p_textures->push_back(TextureWithName(texture, p_filePath));
+		TextureWithName texture(region, p_filePath);
+		texture.decodeTime	= image.decodeTime;
+		texture.fromCache	= image.fromCache;
+		p_textures->push_back(texture);
+		m_readyTime = AsyncPngDecoder::getTime();
 	}
 
 	return textureIndex;
 }
 
+void GlTextureManager::uploadImage(const unsigned char* p_image,
+	int p_width, int p_height, TextureRegion* out_region)
+{
+	if (addToAtlas(p_image, p_width, p_height, out_region) != GAME_OK)
+		addSinglePage(p_image, p_width, p_height, out_region);
+	out_region->placeholder = false;
+}
+
+int GlTextureManager::update()
+{
+	m_decodedImages.clear();
+	m_decoder->fetchFinished(&m_decodedImages);
+
+	int uploaded = 0;
+	for (unsigned int i = 0; i < m_decodedImages.size(); i++)
+	{
+		DecodedImage* image = m_decodedImages[i];
+		TextureWithName& texture = m_textures[image->id];
+		texture.loading		= false;
+		texture.decodeTime	= image->decodeTime;
+		texture.fromCache	= image->fromCache;
+
+		// Textures that fail to decode keep the placeholder
+		if (image->error == 0)
+		{
+			uploadImage(image->data, image->width, image->height,
+				&texture.region);
+			texture.width	= image->width;
+			texture.height	= image->height;
+			uploaded++;
+		}
+		delete image;
+	}
+	if (uploaded > 0)
+		m_readyTime = AsyncPngDecoder::getTime();
+	return uploaded;
+}
+
+void GlTextureManager::waitForPendingTextures()
+{
+	m_decoder->waitForAll();
+	update();
+}
+
+int GlTextureManager::getPendingCount()
+{
+	return m_decoder->getPendingCount();
+}
+
+int GlTextureManager::addToAtlas(const unsigned char* p_image,
+	int p_width, int p_height, TextureRegion* out_region)
+{
+	// Only textures up to half a page are packed, larger ones would waste
+	// most of a page anyway.
+	int paddedWidth		= p_width + 2 * ATLAS_PADDING;
+	int paddedHeight	= p_height + 2 * ATLAS_PADDING;
+	if (paddedWidth > m_atlasPageSize / 2 || paddedHeight > m_atlasPageSize / 2)
+		return GAME_FAIL;
+
+	int page = -1;
+	int x = 0, y = 0;
+	for (unsigned int i = 0; i < m_pages.size() && page < 0; i++)
+	{
+		if (m_pages[i].packer &&
+			m_pages[i].packer->insert(paddedWidth, paddedHeight, &x, &y) == GAME_OK)
+		{
+			page = i;
+		}
+	}
+	if (page < 0)
+	{
+		page = addAtlasPage();
+		if (m_pages[page].packer->insert(paddedWidth, paddedHeight, &x, &y) != GAME_OK)
+			return GAME_FAIL;
+	}
+
+	// Repeat the edge pixels into the padding so linear filtering at the
+	// sprite border doesn't pick up the neighbouring texture.
+	vector<unsigned char> padded(paddedWidth * paddedHeight * 4);
+	for (int row = 0; row < paddedHeight; row++)
+	{
+		int srcRow = min(max(row - ATLAS_PADDING, 0), p_height - 1);
+		for (int col = 0; col < paddedWidth; col++)
+		{
+			int srcCol = min(max(col - ATLAS_PADDING, 0), p_width - 1);
+			const unsigned char* src = &p_image[(srcRow * p_width + srcCol) * 4];
+			unsigned char* dst = &padded[(row * paddedWidth + col) * 4];
+			dst[0] = src[0];
+			dst[1] = src[1];
+			dst[2] = src[2];
+			dst[3] = src[3];
+		}
+	}
+
+	TexturePage& atlas = m_pages[page];
+	glBindTexture(GL_TEXTURE_2D, atlas.texture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, paddedWidth, paddedHeight,
+		GL_RGBA, GL_UNSIGNED_BYTE, &padded[0]);
+	atlas.textureCount++;
+
+	out_region->texture		= atlas.texture;
+	out_region->page		= page;
+	out_region->x			= x + ATLAS_PADDING;
+	out_region->y			= y + ATLAS_PADDING;
+	out_region->width		= p_width;
+	out_region->height		= p_height;
+	out_region->pageWidth	= atlas.width;
+	out_region->pageHeight	= atlas.height;
+	return GAME_OK;
+}
+
+int GlTextureManager::addAtlasPage()
+{
+	vector<unsigned char> empty(m_atlasPageSize * m_atlasPageSize * 4, 0);
+
+	TexturePage page;
+	page.texture		= createTexture(m_atlasPageSize, m_atlasPageSize, &empty[0]);
+	page.width			= m_atlasPageSize;
+	page.height			= m_atlasPageSize;
+	page.packer			= new SkylinePacker(m_atlasPageSize, m_atlasPageSize);
+	page.textureCount	= 0;
+	m_pages.push_back(page);
+	return (int)m_pages.size() - 1;
+}
+
+int GlTextureManager::addSinglePage(const unsigned char* p_image,
+	int p_width, int p_height, TextureRegion* out_region)
+{
+	TexturePage page;
+	page.texture		= createTexture(p_width, p_height, p_image);
+	page.width			= p_width;
+	page.height			= p_height;
+	page.packer			= NULL;
+	page.textureCount	= 1;
+	m_pages.push_back(page);
+
+	out_region->texture		= page.texture;
+	out_region->page		= (int)m_pages.size() - 1;
+	out_region->x			= 0;
+	out_region->y			= 0;
+	out_region->width		= p_width;
+	out_region->height		= p_height;
+	out_region->pageWidth	= p_width;
+	out_region->pageHeight	= p_height;
+	return GAME_OK;
+}
+
 int GlTextureManager::getTexture(int p_textureIndex, GLuint* out_textureResource)
 {
 	int textureIndex = -1;
 
 	if( p_textureIndex < (int)m_textures.size() )
 	{
-		*out_textureResource = m_textures[p_textureIndex].textureResource;
+		*out_textureResource = m_textures[p_textureIndex].region.texture;
 
 		textureIndex = p_textureIndex;
 	}
@@ -64,6 +250,72 @@ int GlTextureManager::getTexture(int p_textureIndex, GLuint* out_textureResource
 	return textureIndex;
 }
 
+int GlTextureManager::getTextureSize(int p_textureIndex, int* out_width,
+	int* out_height)
+{
+	if( p_textureIndex < 0 || p_textureIndex >= (int)m_textures.size() )
+		return GAME_FAIL;
+
+	*out_width = m_textures[p_textureIndex].width;
+	*out_height = m_textures[p_textureIndex].height;
+	return GAME_OK;
+}
+
+int GlTextureManager::getTextureRegion(int p_textureIndex,
+	TextureRegion* out_region)
+{
+	if( p_textureIndex < 0 || p_textureIndex >= (int)m_textures.size() )
+		return GAME_FAIL;
+
+	*out_region = m_textures[p_textureIndex].region;
+	return GAME_OK;
+}
+
+int GlTextureManager::getPageCount()
+{
+	return (int)m_pages.size();
+}
+
+void GlTextureManager::dumpAtlasOccupancy(ostream& p_stream)
+{
+	int cached = 0;
+	float loadTime = 0;
+	for (unsigned int i = 0; i < m_textures.size(); i++)
+	{
+		if (m_textures[i].fromCache)
+			cached++;
+		loadTime += m_textures[i].decodeTime;
+	}
+	p_stream << "Textures: " << m_textures.size() << ", " << cached
+		<< " from cache, " << (int)(loadTime * 1000) << " ms loading, ready after "
+		<< (int)((m_readyTime - m_startTime) * 1000) << " ms" << endl;
+
+	p_stream << "Texture pages: " << m_pages.size() << endl;
+	for (unsigned int i = 0; i < m_pages.size(); i++)
+	{
+		TexturePage& page = m_pages[i];
+		p_stream << "Page " << i << ": " << page.width << "x" << page.height;
+		if (page.packer)
+		{
+			p_stream << " atlas, " << page.textureCount << " textures, "
+				<< (int)(page.packer->getOccupancy() * 100) << "% used" << endl;
+		}
+		else
+			p_stream << " single texture" << endl;
+
+		for (unsigned int j = 0; j < m_textures.size(); j++)
+		{
+			TextureRegion& region = m_textures[j].region;
+			if (region.page != (int)i || region.placeholder)
+				continue;
+			p_stream << "  " << m_textures[j].textureName << " at (" << region.x
+				<< ", " << region.y << ") " << region.width << "x"
+				<< region.height << (m_textures[j].fromCache ? ", mapped in " : ", decoded in ")
+				<< (int)(m_textures[j].decodeTime * 1000) << " ms" << endl;
+		}
+	}
+}
+
 int GlTextureManager::getTexture(string p_filePath)
 {
 	return getTexture(p_filePath, NULL);
@@ -78,7 +330,7 @@ int GlTextureManager::getTexture(string p_filePath, GLuint* out_textureResource)
 		if( m_textures[i].textureName == p_filePath )
 		{
 			if( out_textureResource != NULL)
-				*out_textureResource = m_textures[i].textureResource;
+				*out_textureResource = m_textures[i].region.texture;
 
 			textureIndex = i;
 			break;
@@ -89,4 +341,4 @@ int GlTextureManager::getTexture(string p_filePath, GLuint* out_textureResource)
 		textureIndex = loadTexture(p_filePath, &m_textures);
 
 	return textureIndex;
-}
\ No newline at end of file
+}
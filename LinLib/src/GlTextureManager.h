@@ -8,33 +8,84 @@
 #include <GL/wglew.h>
 #endif
 
+#include <CommonUtility.h>
+#include <SkylinePacker.h>
+#include <AsyncPngDecoder.h>
 #include "LodePNG.h"
 #include <vector>
 #include <string>
+#include <ostream>
 
 using namespace std;
 
+// Where a loaded texture ended up. Small textures share an atlas page, so
+// the region is an offset into a larger GL texture.
+struct TextureRegion
+{
+	GLuint	texture;
+	int		page;
+	int		x, y;
+	int		width, height;
+	int		pageWidth, pageHeight;
+	bool	placeholder;	// Stands in for a texture that is still loading
+};
+
+struct TexturePage
+{
+	GLuint			texture;
+	int				width;
+	int				height;
+	SkylinePacker*	packer;		// NULL if the page holds a single texture
+	int				textureCount;
+};
+
 struct TextureWithName
 {
-	GLuint	textureResource;
-	string	textureName;
+	TextureRegion	region;
+	string			textureName;
+	bool			loading;
+	int				width, height;	// Known from the header while loading
+	float			decodeTime;
+	bool			fromCache;		// Mapped from the raw texture cache
 
 	TextureWithName(){}
-	TextureWithName(GLuint p_textureResource, string p_textureName)
+	TextureWithName(TextureRegion p_region, string p_textureName)
 	{
-		textureResource = p_textureResource;
+		region = p_region;
 		textureName = p_textureName;
+		loading = false;
+		width = p_region.width;
+		height = p_region.height;
+		decodeTime = 0;
+		fromCache = false;
 	}
 };
 
 class GlTextureManager
 {
 private:
+	static const int ATLAS_PAGE_SIZE	= 2048;
+	static const int ATLAS_PADDING		= 2;
+
 	vector<TextureWithName> m_textures;
-	bool m_initialized;
+	vector<TexturePage>		m_pages;
+	int						m_atlasPageSize;
+	bool					m_initialized;
+	AsyncPngDecoder*		m_decoder;
+	vector<DecodedImage*>	m_decodedImages;
+	double					m_startTime;
+	double					m_readyTime;	// When the last texture was uploaded
 
 private:
 	int loadTexture(string p_filePath, vector<TextureWithName>* p_textures);
+	void uploadImage(const unsigned char* p_image, int p_width,
+		int p_height, TextureRegion* out_region);
+	int addToAtlas(const unsigned char* p_image, int p_width,
+		int p_height, TextureRegion* out_region);
+	int addAtlasPage();
+	int addSinglePage(const unsigned char* p_image, int p_width,
+		int p_height, TextureRegion* out_region);
+	GLuint createTexture(int p_width, int p_height, const unsigned char* p_data);
 
 public:
 	GlTextureManager();
@@ -44,7 +95,19 @@ public:
 
 	int getTexture(string p_filePath);
 	int getTexture(string p_filePath, GLuint* out_textureResource);
-	
+
+	int getTextureSize(int p_textureIndex, int* out_width, int* out_height);
+	int getTextureRegion(int p_textureIndex, TextureRegion* out_region);
+
+	// Textures after the first are decoded on worker threads. Until they
+	// are uploaded by update, their region is the first texture's.
+	// Returns the number of textures uploaded.
+	int update();
+	void waitForPendingTextures();
+	int getPendingCount();
+
+	int getPageCount();
+	void dumpAtlasOccupancy(ostream& p_stream);
 };
 
 #endif
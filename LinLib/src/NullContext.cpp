@@ -0,0 +1,185 @@
+#include "NullContext.h"
+#include <AsyncPngDecoder.h>
+
+NullContext::NullContext(int p_screenWidth, int p_screenHeight)
+	: IOContext( p_screenWidth, p_screenHeight, true )
+{
+	m_frame				= 0;
+	m_frameLimit		= 0;
+	m_totalTime			= 0;
+	m_totalDrawCalls	= 0;
+	m_spritesAdded		= 0;
+	m_initialized		= true;
+}
+NullContext::~NullContext()
+{
+}
+bool NullContext::isInitialized() const
+{
+	return m_initialized;
+}
+int NullContext::setWindowPosition(int, int)
+{
+	return GAME_OK;
+}
+int NullContext::setWindowSize(int p_width, int p_height)
+{
+	m_screenWidth = p_width;
+	m_screenHeight = p_height;
+	return GAME_OK;
+}
+int NullContext::update(float p_dt)
+{
+	if (!isRunning())
+		return GAME_OK;
+
+	m_totalTime += p_dt;
+
+	// Same key state transitions as the windowed contexts
+	for (int i = 0; i < InputInfo::NUM_KEYS; i++)
+	{
+		bool wasDown = m_input.keys[i] == InputInfo::KEYPRESSED || 
+			m_input.keys[i] == InputInfo::KEYDOWN;
+
+		if (isKeyScriptedDown(i))
+			m_input.keys[i] = wasDown ? InputInfo::KEYDOWN : InputInfo::KEYPRESSED;
+		else
+			m_input.keys[i] = wasDown ? InputInfo::KEYRELEASED : InputInfo::KEYUP;
+	}
+
+	m_frame++;
+	if (m_frameLimit > 0 && m_frame >= m_frameLimit)
+		setRunning(false);
+
+	return GAME_OK;
+}
+bool NullContext::isKeyScriptedDown(int p_key)
+{
+	for (unsigned int i = 0; i < m_keyPresses.size(); i++)
+	{
+		if (m_keyPresses[i].key == p_key && m_frame >= m_keyPresses[i].firstFrame &&
+			m_frame <= m_keyPresses[i].lastFrame)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int NullContext::getTextureIndex(const string& p_filePath)
+{
+	for (unsigned int i = 0; i < m_textures.size(); i++)
+	{
+		if (m_textures[i].name == p_filePath)
+			return i;
+	}
+
+	// Only the PNG header is needed for the size
+	TextureSize texture;
+	texture.name	= p_filePath;
+	texture.width	= 0;
+	texture.height	= 0;
+
+	AsyncPngDecoder::readSize(p_filePath, &texture.width, &texture.height);
+	m_textures.push_back(texture);
+	return (int)m_textures.size() - 1;
+}
+
+int NullContext::addSprite( SpriteInfo* p_spriteInfo )
+{
+	m_spritesAdded++;
+
+	string path = p_spriteInfo->getTexturePath();
+	if (path == "")
+		path = "../Textures/default.png";
+
+	p_spriteInfo->textureIndex = getTextureIndex(path);
+	TextureSize& texture = m_textures[p_spriteInfo->textureIndex];
+	p_spriteInfo->textureRect.width = texture.width;
+	p_spriteInfo->textureRect.height = texture.height;
+
+	if (texture.width == 0)
+		return GAME_FAIL;
+	return GAME_OK;
+}
+
+int NullContext::beginDraw()
+{
+	m_drawCalls = 0;
+	return GAME_OK;
+}
+int NullContext::drawSprite(SpriteInfo* p_spriteInfo)
+{
+	if (p_spriteInfo->visible)
+	{
+		m_drawCalls++;
+		m_totalDrawCalls++;
+	}
+	return GAME_OK;
+}
+int NullContext::drawInstances(SpriteInfo* p_spriteInfo)
+{
+	// Counted like a batched backend, one call for all instances
+	if (p_spriteInfo->instanceCount > 0)
+		return drawSprite(p_spriteInfo);
+	return GAME_OK;
+}
+int NullContext::endDraw()
+{
+	return GAME_OK;
+}
+
+int NullContext::getScreenWidth() const
+{
+	return m_screenWidth;
+}
+int NullContext::getScreenHeight() const
+{
+	return m_screenHeight;
+}
+void NullContext::setWindowText(string)
+{
+}
+
+void NullContext::addKeyPress(int p_frame, int p_key, int p_frameCount)
+{
+	KeyPress press;
+	press.key			= p_key;
+	press.firstFrame	= p_frame;
+	press.lastFrame		= p_frame + p_frameCount - 1;
+	m_keyPresses.push_back(press);
+}
+void NullContext::setFrameLimit(int p_frames)
+{
+	m_frameLimit = p_frames;
+}
+int NullContext::getFrameCount() const
+{
+	return m_frame;
+}
+float NullContext::getTotalTime() const
+{
+	return m_totalTime;
+}
+int NullContext::getTotalDrawCalls() const
+{
+	return m_totalDrawCalls;
+}
+int NullContext::getSpritesAdded() const
+{
+	return m_spritesAdded;
+}
+
+int NullContext::keyFromName(const string& p_name)
+{
+	const char* names[] = { "RIGHT", "LEFT", "UP", "DOWN", "SPACE", "ESC",
+		"ENTER" };
+	for (int i = 0; i <= InputInfo::ENTER; i++)
+	{
+		if (p_name == names[i])
+			return i;
+	}
+	if (p_name.size() == 1 && p_name[0] >= 'A' && p_name[0] <= 'Z')
+		return InputInfo::A_KEY + p_name[0] - 'A';
+	return -1;
+}
@@ -0,0 +1,79 @@
+#ifndef NULLCONTEXT_H
+#define NULLCONTEXT_H
+
+#include <IOContext.h>
+#include <CommonUtility.h>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+// IOContext without a window or GPU. Sprites are accepted and counted but
+// never drawn, input comes from a script. Used to run the game headless,
+// e.g. to measure simulation and submission cost.
+class NullContext: public IOContext
+{
+private:
+	struct TextureSize
+	{
+		string	name;
+		int		width;
+		int		height;
+	};
+	struct KeyPress
+	{
+		int		key;
+		int		firstFrame;
+		int		lastFrame;
+	};
+
+	vector<TextureSize>	m_textures;
+	vector<KeyPress>	m_keyPresses;
+	int					m_frame;
+	int					m_frameLimit;
+	float				m_totalTime;
+	int					m_totalDrawCalls;
+	int					m_spritesAdded;
+
+private:
+	int		getTextureIndex(const string& p_filePath);
+	bool	isKeyScriptedDown(int p_key);
+
+public:
+					NullContext(int p_screenWidth, int p_screenHeight);
+	virtual			~NullContext();
+	bool			isInitialized() const;
+	int				setWindowPosition(int p_x, int p_y);
+	int				setWindowSize(int p_width, int p_height);
+	int				update(float p_dt);
+
+	int				addSprite( SpriteInfo* p_spriteInfo );
+
+	int				beginDraw();
+	int				drawSprite(SpriteInfo* p_spriteInfo);
+	int				drawInstances(SpriteInfo* p_spriteInfo);
+	int				endDraw();
+
+	int				getScreenWidth() const;
+	int				getScreenHeight() const;
+	void			setWindowText(string p_text);
+
+	// Holds p_key (an InputInfo::KeyCode) down for p_frameCount frames,
+	// starting at frame p_frame.
+	void			addKeyPress(int p_frame, int p_key, int p_frameCount = 1);
+
+	// Stops running after the given number of frames. 0 runs until the
+	// game quits by itself.
+	void			setFrameLimit(int p_frames);
+
+	int				getFrameCount() const;
+	float			getTotalTime() const;
+	int				getTotalDrawCalls() const;
+	int				getSpritesAdded() const;
+
+	// Maps names like "ENTER" or "LEFT" to InputInfo key codes. Returns -1
+	// for unknown names.
+	static int		keyFromName(const string& p_name);
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#endif
+
+// Counts the heap allocations made between start and stop through an
+// allocation hook of the debug CRT, which keeps its own bookkeeping and
+// leak report. Only MSVC debug builds have the hook; elsewhere nothing
+// can be counted and tests relying on the count are skipped.
+class AllocationCounter
+{
+private:
+	static long& count()
+	{
+		static long s_count = 0;
+		return s_count;
+	}
+#if defined(_MSC_VER) && defined(_DEBUG)
+	static _CRT_ALLOC_HOOK& previous()
+	{
+		static _CRT_ALLOC_HOOK s_previous = NULL;
+		return s_previous;
+	}
+	static int __cdecl hook(int p_type, void* p_data, size_t p_size, int p_block,
+		long p_request, const unsigned char* p_file, int p_line)
+	{
+		// Blocks the CRT allocates for itself are not counted
+		if (p_block != _CRT_BLOCK && (p_type == _HOOK_ALLOC || p_type == _HOOK_REALLOC))
+			count()++;
+		if (previous())
+			return previous()(p_type, p_data, p_size, p_block, p_request, p_file, p_line);
+		return TRUE;
+	}
+#endif
+public:
+	static bool isAvailable()
+	{
+#if defined(_MSC_VER) && defined(_DEBUG)
+		return true;
+#else
+		return false;
+#endif
+	}
+	static void start()
+	{
+		count() = 0;
+#if defined(_MSC_VER) && defined(_DEBUG)
+		previous() = _CrtSetAllocHook(hook);
+#endif
+	}
+	// The allocations since start
+	static long stop()
+	{
+#if defined(_MSC_VER) && defined(_DEBUG)
+		_CrtSetAllocHook(previous());
+#endif
+		return count();
+	}
+};
+
+#endif
@@ -90,6 +90,13 @@ TotalTestData Test::run()
 
 	return TotalTestData(total - success, total);
 }
+double Test::getTime()
+{
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / frequency.QuadPart;
+}
 void Test::printResult(TestData p_entry)
 {
 	HANDLE hConsole;
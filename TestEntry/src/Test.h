@@ -59,6 +59,8 @@ private:
 protected:
 	void newSection(string p_id);
 	void newEntry(TestData p_entry);
+	// Seconds on the performance counter, for timing what a test runs
+	double getTime();
 public:
 	Test(string p_name);
 	virtual TotalTestData run();
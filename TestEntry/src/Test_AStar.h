@@ -0,0 +1,314 @@
+#ifndef TESTASTAR_H
+#define TESTASTAR_H
+
+#include "Test.h"
+#include <AStar.h>
+#include <GOFactory.h>
+#include <fstream>
+#include <cstdlib>
+
+// Runs AStar on random queries over every map in the game's map folder.
+// Paths must be as short as a breadth first search finds them and only
+// step between neighbouring free tiles. The time is compared with the
+// search Monster used before.
+class Test_AStar: public Test
+{
+private:
+	static const int QUERIES = 50;
+	static const unsigned int LIMIT = 2000;
+
+	struct AstarItem
+	{
+		Tile* tile;
+		int parent;
+		int toStart;
+		int toGoal;
+		int distance()
+		{
+			return toStart + toGoal;
+		}
+	};
+
+	// The search from before AStar, with the open list sorted by insertion
+	// and linear scans for the closed list. Tiles already in the open list
+	// are added again when reached without a better distance, which makes
+	// the list grow without bound in open areas, so it gives up after
+	// p_limit expansions.
+	int FindTile(Tile* p_tile, vector<AstarItem>& p_queue)
+	{
+		for (unsigned int i = 0; i < p_queue.size(); i++)
+		{
+			if (p_queue[i].tile == p_tile)
+				return i;
+		}
+		return -1;
+	}
+	void UpdateQueue(Tile* p_tile, int p_parent, int p_toStart, int p_toGoal, vector<AstarItem>& p_queue)
+	{
+		int index = FindTile(p_tile, p_queue);
+		if (index >= 0 && p_queue[index].distance() > p_toStart + p_toGoal)
+		{
+			p_queue[index].toStart = p_toStart;
+			p_queue[index].toGoal = p_toGoal;
+			p_queue[index].parent = p_parent;
+			while (index < (int)(p_queue.size()-1) && p_queue[index].distance() < p_queue[index+1].distance())
+			{
+				AstarItem temp = p_queue[index];
+				p_queue[index] = p_queue[index+1];
+				p_queue[index+1] = temp;
+				index++;
+			}
+		}
+		else
+		{
+			AstarItem star;
+			star.toStart = p_toStart;
+			star.toGoal = p_toGoal;
+			star.tile = p_tile;
+			star.parent = p_parent;
+			p_queue.push_back(star);
+			index = p_queue.size() - 1;
+			while (index > 0 && p_queue[index].distance() > p_queue[index-1].distance())
+			{
+				AstarItem temp = p_queue[index];
+				p_queue[index] = p_queue[index-1];
+				p_queue[index-1] = temp;
+				index--;
+			}
+		}
+	}
+	bool FindPath(Tilemap* p_map, Tile* p_start, Tile* p_goal, vector<Tile*>& p_path,
+		unsigned int p_limit)
+	{
+		Tile* toCheck[4];
+		vector<AstarItem> queue;
+		vector<AstarItem> visited;
+
+		AstarItem first;
+		first.toStart = 0;
+		TilePosition startdif = p_goal->getTilePosition() - p_start->getTilePosition();
+		first.toGoal = abs(startdif.x) + abs(startdif.y);
+		first.tile = p_start;
+		first.parent = -1;
+		queue.push_back(first);
+		while (queue.size() > 0 && queue.back().tile != p_goal)
+		{
+			if (visited.size() >= p_limit)
+				return false;
+			visited.push_back(queue.back());
+			TilePosition p = queue.back().tile->getTilePosition();
+			queue.pop_back();
+			toCheck[0] = p_map->getTile(p + TilePosition(0, 1));
+			toCheck[1] = p_map->getTile(p + TilePosition(0, -1));
+			toCheck[2] = p_map->getTile(p + TilePosition(1, 0));
+			toCheck[3] = p_map->getTile(p + TilePosition(-1, 0));
+			for (int i = 0; i < 4; i++)
+			{
+				if (toCheck[i])
+				{
+					bool skip = !toCheck[i]->isFree();
+					for (unsigned int j = 0; j < visited.size(); j++)
+					{
+						if (visited[j].tile == toCheck[i])
+							skip = true;
+					}
+					if (!skip)
+					{
+						int toStart = visited.back().toStart+1;
+						TilePosition dif = p_goal->getTilePosition() - toCheck[i]->getTilePosition();
+						int toGoal = abs(dif.x) + abs(dif.y);
+						UpdateQueue(toCheck[i], visited.size()-1, toStart, toGoal, queue);
+					}
+				}
+			}
+		}
+		if (queue.size() == 0)
+			return true;
+
+		p_path.clear();
+		p_path.push_back(queue.back().tile);
+		int parent = queue.back().parent;
+		while (p_path.back() != p_start)
+		{
+			AstarItem asi = visited[parent];
+			p_path.push_back(asi.tile);
+			parent = asi.parent;
+		}
+		return true;
+	}
+	// Steps from p_start to p_goal, -1 if it can't be reached
+	int shortestDistance(Tilemap* p_map, Tile* p_start, Tile* p_goal)
+	{
+		int width = p_map->getWidth();
+		vector<int> distances(width * p_map->getHeight(), -1);
+		vector<Tile*> queue;
+		TilePosition start = p_start->getTilePosition();
+		distances[start.y * width + start.x] = 0;
+		queue.push_back(p_start);
+		for (unsigned int i = 0; i < queue.size(); i++)
+		{
+			TilePosition p = queue[i]->getTilePosition();
+			if (queue[i] == p_goal)
+				return distances[p.y * width + p.x];
+			TilePosition offsets[] = {TilePosition(0, 1), TilePosition(0, -1),
+				TilePosition(1, 0), TilePosition(-1, 0)};
+			for (int j = 0; j < 4; j++)
+			{
+				Tile* next = p_map->getTile(p + offsets[j]);
+				if (!next || !next->isFree())
+					continue;
+				TilePosition n = next->getTilePosition();
+				if (distances[n.y * width + n.x] < 0)
+				{
+					distances[n.y * width + n.x] = distances[p.y * width + p.x] + 1;
+					queue.push_back(next);
+				}
+			}
+		}
+		return -1;
+	}
+public:
+	// Reads the tile layer of a map file the way MapLoader does, without
+	// creating the game objects
+	static Tilemap* loadMap(string p_path, GOFactory* p_factory)
+	{
+		ifstream file(p_path.c_str(), ios::in);
+		string temp;
+		char dummy = 't';
+		int width = 0, height = 0, theme = 0;
+		file >> temp;
+		while (file.good() && dummy != '=')
+			file >> dummy;
+		file >> width;
+		dummy = 't';
+		while (file.good() && dummy != '=')
+			file >> dummy;
+		file >> height;
+		file >> temp >> temp >> temp >> theme;
+		for (int i = 0; i < height; i++)
+			file >> temp;
+		file >> temp >> temp >> temp;
+		if (!file.good() || width <= 0 || height <= 0)
+			return NULL;
+
+		// The last value has no comma after it
+		vector<int> data(width * height);
+		char comma;
+		for (int i = height - 1; i >= 0; i--)
+		{
+			for (int j = 0; j < width; j++)
+			{
+				if (!(file >> data[i * width + j]))
+					return NULL;
+				file >> comma;
+			}
+		}
+		return p_factory->CreateTileMap(theme, width, height, data);
+	}
+	static bool isValidPath(const vector<Tile*>& p_path, Tile* p_start, Tile* p_goal)
+	{
+		if (p_path.empty() || p_path.front() != p_goal || p_path.back() != p_start)
+			return false;
+		for (unsigned int i = 1; i < p_path.size(); i++)
+		{
+			TilePosition step = p_path[i]->getTilePosition() - p_path[i - 1]->getTilePosition();
+			if (abs(step.x) + abs(step.y) != 1 || !p_path[i - 1]->isFree())
+				return false;
+		}
+		return true;
+	}
+	Test_AStar(): Test("ASTAR")
+	{
+	}
+	void setup()
+	{
+		// A wall between the start and the goal has to be walked around
+		Tile** tiles = new Tile*[9];
+		for (int i = 0; i < 9; i++)
+			tiles[i] = new Tile(i != 1 && i != 4, TilePosition(i % 3, i / 3), 10, 10, NULL);
+		Tilemap small(3, 3, tiles);
+		vector<Tile*> path;
+		newEntry(TestData("Around wall", small.findPath(tiles[0], tiles[2], &path) &&
+			path.size() == 7 && isValidPath(path, tiles[0], tiles[2])));
+		newEntry(TestData("Same tile", small.findPath(tiles[3], tiles[3], &path) &&
+			path.size() == 1 && path[0] == tiles[3]));
+		tiles[7]->setWalkAble(false);
+		path.clear();
+		newEntry(TestData("No path", !small.findPath(tiles[0], tiles[2], &path) &&
+			path.empty()));
+
+		string folder = "../../WinEntry/Maps/";
+		vector<string> files;
+		WIN32_FIND_DATAA found;
+		HANDLE search = FindFirstFileA((folder + "*.txt").c_str(), &found);
+		if (search != INVALID_HANDLE_VALUE)
+		{
+			do
+				files.push_back(folder + found.cFileName);
+			while (FindNextFileA(search, &found));
+			FindClose(search);
+		}
+
+		GOFactory factory(NULL);
+		int maps = 0;
+		bool shortest = true;
+		int compared = 0;
+		double referenceTime = 0, time = 0;
+		srand(1);
+		for (unsigned int i = 0; i < files.size(); i++)
+		{
+			Tilemap* map = loadMap(files[i], &factory);
+			if (!map)
+				continue;
+			maps++;
+
+			vector<Tile*> freeTiles;
+			for (int y = 0; y < map->getHeight(); y++)
+			{
+				for (int x = 0; x < map->getWidth(); x++)
+				{
+					Tile* tile = map->getTile(TilePosition(x, y));
+					if (tile->isFree())
+						freeTiles.push_back(tile);
+				}
+			}
+
+			for (int j = 0; j < QUERIES && !freeTiles.empty(); j++)
+			{
+				Tile* start = freeTiles[rand() % freeTiles.size()];
+				Tile* goal = freeTiles[rand() % freeTiles.size()];
+				vector<Tile*> referencePath, path;
+
+				double begin = getTime();
+				bool finished = FindPath(map, start, goal, referencePath, LIMIT);
+				double middle = getTime();
+				bool found = map->findPath(start, goal, &path);
+				double end = getTime();
+				if (finished)
+				{
+					referenceTime += middle - begin;
+					time += end - middle;
+					compared++;
+				}
+
+				int distance = shortestDistance(map, start, goal);
+				if (found != (distance >= 0) || (found && ((int)path.size() != distance + 1 ||
+					!isValidPath(path, start, goal))))
+				{
+					shortest = false;
+				}
+			}
+
+			delete map;
+		}
+		newEntry(TestData("Maps loaded", maps > 0));
+		newEntry(TestData("Shortest paths", shortest));
+
+		stringstream times;
+		times << "A* " << (int)(time * 1000) << " ms vs "
+			<< (int)(referenceTime * 1000) << " ms over " << compared << " paths";
+		newEntry(TestData(times.str(), compared > 0));
+	}
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef TESTACTIVITYLIST_H
+#define TESTACTIVITYLIST_H
+
+#include "Test.h"
+#include <ActivityList.h>
+
+// Puts ids of an ActivityList to sleep in each way they can wake and
+// checks that they wake at the right time, and that going through the
+// awake ids from the back visits each once while some fall asleep.
+class Test_ActivityList: public Test
+{
+private:
+public:
+	Test_ActivityList(): Test("ACTIVITYLIST")
+	{
+	}
+	void setup()
+	{
+		ActivityList list;
+		for (int i = 0; i < 6; i++)
+			list.add(i % 2 == 0);
+		newEntry(TestData("Added", list.getCount() == 6 && list.getAwakeCount() == 3 &&
+			list.isAwake(0) && !list.isAwake(1)));
+
+		list.sleepFor(0, 1.0f);
+		list.sleepFor(2, 0.5f);
+		list.sleep(4);
+		list.update(0.75f);
+		newEntry(TestData("Timer", list.isAwake(2) && !list.isAwake(0)));
+		list.update(0.5f);
+		newEntry(TestData("Later timer", list.isAwake(0)));
+
+		list.update(10.0f);
+		bool asleep = !list.isAwake(4);
+		list.wake(4);
+		newEntry(TestData("Woken", asleep && list.isAwake(4)));
+
+		// Woken early, the timer must not put it back or wake it again
+		list.sleepFor(1, 1.0f);
+		list.wake(1);
+		list.sleep(1);
+		list.update(2.0f);
+		newEntry(TestData("Cancelled timer", !list.isAwake(1)));
+
+		for (int i = 0; i < 6; i++)
+			list.wake(i);
+		vector<int> visits(6, 0);
+		for (int index = list.getAwakeCount() - 1; index >= 0; index--)
+		{
+			int id = list.getAwake(index);
+			visits[id]++;
+			if (id % 3 != 0)
+				list.sleep(id);
+		}
+		bool once = true;
+		for (int i = 0; i < 6; i++)
+			once = once && visits[i] == 1;
+		newEntry(TestData("Sleep while going through", once &&
+			list.getAwakeCount() == 2 && list.isAwake(0) && list.isAwake(3)));
+
+		list.clear();
+		newEntry(TestData("Cleared", list.getCount() == 0 && list.getAwakeCount() == 0));
+	}
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef TESTANIMATIONPLAYER_H
+#define TESTANIMATIONPLAYER_H
+
+#include "Test.h"
+#include <AnimationPlayer.h>
+#include <Animation.h>
+#include <Rat.h>
+#include <SpritePool.h>
+
+// Checks that shared clips are registered once per sheet and that the
+// player steps through them like an Animation. The time of a thousand
+// walking monsters is reported both ways.
+class Test_AnimationPlayer: public Test
+{
+private:
+	static const int INSTANCES = 1000;
+	static const int FRAMES = 1000;
+
+	bool sameRect(Rect p_a, Rect p_b)
+	{
+		return p_a.x == p_b.x && p_a.y == p_b.y &&
+			p_a.width == p_b.width && p_a.height == p_b.height;
+	}
+public:
+	Test_AnimationPlayer(): Test("ANIMATIONPLAYER")
+	{
+	}
+	void setup()
+	{
+		int sheet = TexturePaths::intern("../Textures/test_sheet.png");
+		int right = AnimationClips::add(sheet, AnimationClip(fVector2(0, 0), 64, 64, 4, 0.1f, true));
+		int left = AnimationClips::add(sheet, AnimationClip(fVector2(0, 64), 64, 64, 4, 0.1f, true));
+		int count = AnimationClips::getCount();
+		newEntry(TestData("Registered once", right != left &&
+			AnimationClips::add(sheet, AnimationClip(fVector2(0, 0), 64, 64, 4, 0.1f, true)) == right &&
+			AnimationClips::getCount() == count));
+		newEntry(TestData("Per sheet", AnimationClips::add(sheet + 1,
+			AnimationClip(fVector2(0, 0), 64, 64, 4, 0.1f, true)) != right));
+
+		// Steps like an Animation of the same clip
+		AnimationPlayer player;
+		SpriteInfo sprite;
+		int id = player.add(right, &sprite);
+		Animation animation(fVector2(0, 0), 64, 64, 4, 0.1f, true);
+		bool same = true;
+		for (int i = 0; i < 50; i++)
+		{
+			animation.update(0.03f);
+			player.update(0.03f);
+			same = same && sameRect(animation.getCurrentFrame(), player.getFrame(id)) &&
+				sameRect(sprite.textureRect, player.getFrame(id));
+		}
+		newEntry(TestData("Same as Animation", same));
+
+		Rect frame = player.getFrame(id);
+		player.play(id, left);
+		newEntry(TestData("Direction keeps frame", player.getClip(id) == left &&
+			player.getFrame(id).x == frame.x && player.getFrame(id).y == 64));
+
+		player.setRate(id, 0);
+		player.update(1.0f);
+		newEntry(TestData("Held", sameRect(player.getFrame(id), sprite.textureRect) &&
+			sprite.textureRect.x == frame.x));
+
+		int once = AnimationClips::add(sheet, AnimationClip(fVector2(0, 128), 64, 64, 2, 0.1f));
+		player.play(id, once);
+		player.restart(id);
+		player.setRate(id, 1);
+		for (int i = 0; i < 5; i++)
+			player.update(0.11f);
+		newEntry(TestData("Finished", player.hasFinished(id)));
+
+		player.clear();
+		newEntry(TestData("Cleared", player.getCount() == 0));
+
+		// Rats on the same sheet share their clips
+		SpritePool pool;
+		SpriteInfo* ratSprite = pool.add();
+		ratSprite->setTexturePath("../Textures/rat.png");
+		Rat* first = new Rat(NULL, ratSprite, NULL, NULL, NULL, &player);
+		count = AnimationClips::getCount();
+		Rat* second = new Rat(NULL, ratSprite, NULL, NULL, NULL, &player);
+		newEntry(TestData("Rats share clips", AnimationClips::getCount() == count &&
+			player.getCount() == 2));
+		delete first;
+		delete second;
+		player.clear();
+
+		// Every monster walking, as four Animations each and in one player
+		vector<SpriteInfo> sprites(INSTANCES);
+		vector<Animation*> animations;
+		double begin = getTime();
+		for (int i = 0; i < INSTANCES; i++)
+		{
+			animations.push_back(new Animation(fVector2(0, 0), 64, 64, 4, 0.1f, true));
+			animations.push_back(new Animation(fVector2(0, 64), 64, 64, 4, 0.1f, true));
+			animations.push_back(new Animation(fVector2(0, 128), 64, 64, 4, 0.1f, true));
+			animations.push_back(new Animation(fVector2(0, 192), 64, 64, 4, 0.1f, true));
+		}
+		for (int frame = 0; frame < FRAMES; frame++)
+		{
+			for (int i = 0; i < INSTANCES; i++)
+			{
+				Animation* current = animations[i * 4 + (i + frame / 100) % 4];
+				current->update(0.016f);
+				sprites[i].textureRect = current->getCurrentFrame();
+			}
+		}
+		double middle = getTime();
+		int clips[4];
+		for (int i = 0; i < 4; i++)
+		{
+			clips[i] = AnimationClips::add(sheet, AnimationClip(fVector2(0, i * 64.0f),
+				64, 64, 4, 0.1f, true));
+		}
+		for (int i = 0; i < INSTANCES; i++)
+			player.add(clips[0], &sprites[i]);
+		for (int frame = 0; frame < FRAMES; frame++)
+		{
+			if (frame % 100 == 0)
+			{
+				for (int i = 0; i < INSTANCES; i++)
+					player.play(i, clips[(i + frame / 100) % 4]);
+			}
+			player.update(0.016f);
+		}
+		double end = getTime();
+
+		stringstream times;
+		times << "Player " << (int)((end - middle) * 1000) << " ms vs animations "
+			<< (int)((middle - begin) * 1000) << " ms";
+		newEntry(TestData(times.str(), true));
+
+		for (unsigned int i = 0; i < animations.size(); i++)
+			delete animations[i];
+	}
+};
+
+#endif
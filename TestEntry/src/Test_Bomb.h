@@ -4,22 +4,121 @@
 #include "Test.h"
 #include <Bomb.h>
 #include <Tilemap.h>
+#include <SpritePool.h>
+#include "AllocationCounter.h"
 
+// Checks that a bomb made hidden with the map is placed, blows up and is
+// taken back again, and that doing so over and over allocates nothing.
+// The allocations are only counted in builds with the counter's hook.
 class Test_Bomb: public Test
 {
 private:
+	static const int SIZE = 9;
+	static const int BLASTS = 100;
+
+	// Runs a blast until the bomb is free again, at most p_frames
+	void blowUp(Bomb* p_bomb, HazardLayer* p_hazards, int p_frames = 300)
+	{
+		float step = 1.0f / 60.0f;
+		for (int i = 0; i < p_frames && !p_bomb->isIdle(); i++)
+		{
+			p_hazards->update(step);
+			p_bomb->update(step, InputInfo());
+		}
+	}
 public:
 	Test_Bomb(): Test("BOMB")
 	{
 	}
 	void setup()
 	{
-		vector<pair<Tile*, SpriteInfo*>> data;
-		Bomb b(NULL, data, NULL, NULL, NULL, NULL);
+		Bomb b(NULL, vector<SpriteInfo*>(), NULL, NULL, NULL);
 		newEntry(TestData("Construction", true));
 		b.update(0.5f, InputInfo());
-		newEntry(TestData("Update", true));
+		newEntry(TestData("Update", b.isIdle()));
+
+		// An open map, the blast reaches a whole row and column
+		Tile** tiles = new Tile*[SIZE * SIZE];
+		for (int i = 0; i < SIZE * SIZE; i++)
+			tiles[i] = new Tile(true, TilePosition(i % SIZE, i / SIZE), 10, 10, NULL);
+		Tilemap map(SIZE, SIZE, tiles);
+		HazardLayer* hazards = map.getHazards();
+
+		SpritePool pool;
+		vector<SpriteInfo*> flames;
+		for (int i = 0; i < SIZE * 2 - 1; i++)
+			flames.push_back(pool.add());
+		SpriteInfo* sprite = pool.add();
+		SoundInfo tick, blast;
+		Bomb bomb(sprite, flames, &map, &tick, &blast);
+		newEntry(TestData("Hidden until spawned", bomb.isIdle() && !sprite->visible &&
+			!flames[0]->visible && bomb.getFlameCapacity() == SIZE * 2 - 1));
+
+		bomb.spawn(tiles[2 * SIZE + 3]);
+		newEntry(TestData("Spawned", !bomb.isIdle() && sprite->visible &&
+			sprite->transformInfo.translation[TransformInfo::X] == 35 &&
+			sprite->transformInfo.translation[TransformInfo::Y] == 25));
+
+		// Every flame sprite is used once the blast has spread
+		float step = 1.0f / 60.0f;
+		for (int i = 0; i < 110; i++)
+		{
+			hazards->update(step);
+			bomb.update(step, InputInfo());
+		}
+		int lit = 0;
+		for (unsigned int i = 0; i < flames.size(); i++)
+		{
+			if (flames[i]->visible)
+				lit++;
+		}
+		newEntry(TestData("Whole cross lit", lit == SIZE * 2 - 1 &&
+			hazards->isBurning(TilePosition(3, 8)) && hazards->isBurning(TilePosition(0, 2)) &&
+			!hazards->isBurning(TilePosition(4, 3))));
+
+		bomb.reset();
+		newEntry(TestData("Reset takes back", bomb.isIdle() && !sprite->visible &&
+			!flames[0]->visible && !hazards->isBurning(TilePosition(3, 2))));
+
+		// Spawned again somewhere else, the flames follow
+		bomb.spawn(tiles[7 * SIZE + 1]);
+		blowUp(&bomb, hazards);
+		bool moved = true;
+		for (unsigned int i = 0; i < flames.size(); i++)
+		{
+			float x = flames[i]->transformInfo.translation[TransformInfo::X];
+			float y = flames[i]->transformInfo.translation[TransformInfo::Y];
+			moved = moved && !flames[i]->visible && (x == 15 || y == 75);
+		}
+		newEntry(TestData("Respawned", bomb.isIdle() && !sprite->visible && moved));
+
+		if (AllocationCounter::isAvailable())
+		{
+			// The counter sees an allocation when there is one
+			AllocationCounter::start();
+			vector<int> allocated(1);
+			long counted = AllocationCounter::stop();
+			newEntry(TestData("Counter counts", counted > 0 && allocated.size() == 1));
+		}
+
+		// Every other bomb is taken back halfway through its blast
+		AllocationCounter::start();
+		for (int i = 0; i < BLASTS; i++)
+		{
+			bomb.spawn(tiles[(i % SIZE) * SIZE + (i * 7) % SIZE]);
+			blowUp(&bomb, hazards, i % 2 == 0 ? 90 : 300);
+			bomb.reset();
+		}
+		long allocations = AllocationCounter::stop();
+		newEntry(TestData("Blasts repeated", bomb.isIdle() && !sprite->visible));
+
+		if (AllocationCounter::isAvailable())
+		{
+			stringstream spawned;
+			spawned << "Spawn allocations " << allocations;
+			newEntry(TestData(spawned.str(), allocations == 0));
+		}
 	}	
 };	
 
-#endif
\ No newline at end of file
+#endif
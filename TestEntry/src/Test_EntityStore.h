@@ -0,0 +1,123 @@
+#ifndef TESTENTITYSTORE_H
+#define TESTENTITYSTORE_H
+
+#include "Test.h"
+#include <EntityStore.h>
+#include <Switch.h>
+#include <SpritePool.h>
+
+// Checks that switches kept in an EntityStore cool down exactly like the
+// switches updating themselves and sleep while nothing happens to them.
+// The time of a frame of a 100x100 map full of switches, a tenth of them
+// pressed, is reported both ways.
+class Test_EntityStore: public Test
+{
+private:
+	static const int SIZE = 100;
+	static const int FRAMES = 100;
+
+	SpriteInfo* createSprite(SpritePool* p_pool, int p_x, int p_y)
+	{
+		SpriteInfo* sprite = p_pool->add();
+		sprite->transformInfo.translation[TransformInfo::X] = p_x * 32.0f + 16;
+		sprite->transformInfo.translation[TransformInfo::Y] = p_y * 32.0f + 16;
+		return sprite;
+	}
+public:
+	Test_EntityStore(): Test("ENTITYSTORE")
+	{
+	}
+	void setup()
+	{
+		SpritePool pool;
+		EntityStore store;
+		InputInfo input;
+		SoundInfo sound;
+
+		Switch own(createSprite(&pool, 5, 5), NULL, NULL, vector<WallSwitch*>(), &sound);
+		Switch button(createSprite(&pool, 5, 5), NULL, NULL, vector<WallSwitch*>(),
+			&sound, &store);
+		newEntry(TestData("Added", own.getEntity() == INVALID_ENTITY &&
+			store.getKind(button.getEntity()) == EntityKind::SWITCH &&
+			store.getCount() == 1));
+
+		newSection("Switches");
+		store.update(0.1f);
+		newEntry(TestData("Ready switch asleep", store.getAwakeCount() == 0));
+		button.consume();
+		newEntry(TestData("Pressed switch awake", store.getAwakeCount() == 1));
+		store.update(1.0f);
+		bool cooling = button.getSpriteInfo()->textureRect.x == 64 &&
+			store.getAwakeCount() == 0;
+		button.consume();
+		store.update(3.5f);
+		newEntry(TestData("Switch cooldown", cooling &&
+			button.getSpriteInfo()->textureRect.x == 64));
+		store.update(1.0f);
+		newEntry(TestData("Switch ready", button.getSpriteInfo()->textureRect.x == 0 &&
+			store.getAwakeCount() == 0));
+
+		// Reset while cooling, then pressed again at once
+		button.consume();
+		store.update(1.0f);
+		button.reset();
+		store.update(0.1f);
+		button.consume();
+		store.update(0.1f);
+		newEntry(TestData("Pressed after reset", button.getSpriteInfo()->textureRect.x == 64));
+
+		store.clear();
+		newEntry(TestData("Cleared", store.getCount() == 0));
+
+		// Every tile on the map has a switch, once updating itself and once
+		// stored, and every tenth one is pressed
+		newSection("Full map");
+		vector<Switch*> switches;
+		for (int y = 0; y < SIZE; y++)
+		{
+			for (int x = 0; x < SIZE; x++)
+			{
+				switches.push_back(new Switch(createSprite(&pool, x, y), NULL, NULL,
+					vector<WallSwitch*>(), &sound));
+				switches.push_back(new Switch(createSprite(&pool, x, y), NULL, NULL,
+					vector<WallSwitch*>(), &sound, &store));
+			}
+		}
+		for (unsigned int i = 0; i < switches.size(); i += 20)
+		{
+			switches[i]->consume();
+			switches[i + 1]->consume();
+		}
+
+		double begin = getTime();
+		for (int frame = 0; frame < FRAMES; frame++)
+		{
+			for (unsigned int i = 0; i < switches.size(); i += 2)
+				switches[i]->update(0.016f, input);
+		}
+		double middle = getTime();
+		for (int frame = 0; frame < FRAMES; frame++)
+			store.update(0.016f);
+		double end = getTime();
+
+		bool same = true;
+		for (unsigned int i = 0; i < switches.size(); i += 2)
+		{
+			same = same && switches[i]->getSpriteInfo()->textureRect.x ==
+				switches[i + 1]->getSpriteInfo()->textureRect.x;
+		}
+		newEntry(TestData("Same on a full map", same));
+		newEntry(TestData("Asleep on a full map", store.getAwakeCount() == 0));
+
+		stringstream times;
+		times.precision(3);
+		times << "Frame store " << (end - middle) * 1000000 / FRAMES << " us vs objects "
+			<< (middle - begin) * 1000000 / FRAMES << " us";
+		newEntry(TestData(times.str(), true));
+
+		for (unsigned int i = 0; i < switches.size(); i++)
+			delete switches[i];
+	}
+};
+
+#endif
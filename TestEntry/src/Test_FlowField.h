@@ -0,0 +1,113 @@
+#ifndef TESTFLOWFIELD_H
+#define TESTFLOWFIELD_H
+
+#include "Test.h"
+#include <Tilemap.h>
+
+// Checks the chase field against AStar on a small map with a dead end and
+// a closed room, and that the fields are only rebuilt when the target moves
+class Test_FlowField: public Test
+{
+private:
+	static const int WIDTH = 9;
+	static const int HEIGHT = 6;
+
+	Tilemap* createMap()
+	{
+		// '#' is a wall, the two tiles in the bottom right can't be reached
+		const char* rows[HEIGHT] = {
+			"....#....",
+			".##.#.##.",
+			".#.....#.",
+			".#.##..#.",
+			"...#..###",
+			"##.#..#.."
+		};
+		Tile** tiles = new Tile*[WIDTH * HEIGHT];
+		for (int y = 0; y < HEIGHT; y++)
+		{
+			for (int x = 0; x < WIDTH; x++)
+			{
+				tiles[y * WIDTH + x] = new Tile(rows[y][x] != '#', TilePosition(x, y),
+					10, 10, NULL);
+			}
+		}
+		return new Tilemap(WIDTH, HEIGHT, tiles);
+	}
+	bool isValidPath(const vector<Tile*>& p_path, Tile* p_from)
+	{
+		if (p_path.empty() || p_path.back() != p_from)
+			return false;
+		for (unsigned int i = 1; i < p_path.size(); i++)
+		{
+			TilePosition step = p_path[i]->getTilePosition() - p_path[i - 1]->getTilePosition();
+			if (abs(step.x) + abs(step.y) != 1 || !p_path[i - 1]->isFree())
+				return false;
+		}
+		return true;
+	}
+public:
+	Test_FlowField(): Test("FLOWFIELD")
+	{
+	}
+	void setup()
+	{
+		Tilemap* map = createMap();
+		FlowField* field = map->getFlowField();
+		Tile* target = map->getTile(TilePosition(0, 0));
+		field->setTarget(target);
+
+		bool same = true;
+		bool valid = true;
+		bool unreachable = true;
+		for (int y = 0; y < HEIGHT; y++)
+		{
+			for (int x = 0; x < WIDTH; x++)
+			{
+				Tile* tile = map->getTile(TilePosition(x, y));
+				if (!tile->isFree())
+					continue;
+				vector<Tile*> path, reference;
+				bool found = field->getChasePath(tile, &path);
+				if (found != map->findPath(tile, target, &reference) ||
+					path.size() != reference.size())
+				{
+					same = false;
+				}
+				if (found && (!isValidPath(path, tile) || path.front() != target))
+					valid = false;
+				if (!found && (!path.empty() || field->getDistance(tile) != -1 ||
+					field->getChaseStep(tile) || field->getFleeStep(tile)))
+				{
+					unreachable = false;
+				}
+			}
+		}
+		newEntry(TestData("Chase paths as short as A*", same));
+		newEntry(TestData("Chase paths end at target", valid));
+		newEntry(TestData("Closed room not reached", unreachable));
+
+		// Fleeing from the target ends farther away than it started
+		Tile* start = map->getTile(TilePosition(2, 2));
+		vector<Tile*> flee;
+		newEntry(TestData("Flee path", field->getFleePath(start, &flee) &&
+			isValidPath(flee, start) && flee.size() > 1 &&
+			field->getDistance(flee.front()) > field->getDistance(start)));
+		Tile* step = field->getFleeStep(start);
+		newEntry(TestData("Flee step", step && flee.size() > 1 && step == flee[flee.size() - 2]));
+
+		int rebuilds = field->getRebuildCount();
+		field->setTarget(target);
+		field->getChaseStep(start);
+		field->getFleeStep(start);
+		newEntry(TestData("Same target kept", field->getRebuildCount() == rebuilds));
+
+		field->setTarget(map->getTile(TilePosition(5, 5)));
+		newEntry(TestData("Moved target", field->getDistance(map->getTile(TilePosition(5, 4))) == 1 &&
+			field->getRebuildCount() == rebuilds + 1));
+
+		delete map;
+	}
+};
+
+#endif
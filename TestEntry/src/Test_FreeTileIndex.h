@@ -0,0 +1,112 @@
+#ifndef TESTFREETILEINDEX_H
+#define TESTFREETILEINDEX_H
+
+#include "Test.h"
+#include <Tilemap.h>
+#include <cstdlib>
+
+// Toggles random tiles on a map and compares FreeTileIndex with a scan of
+// every tile after each change. The packed list must hold exactly the
+// walkable tiles and every tile must know its closest walkable tile.
+class Test_FreeTileIndex: public Test
+{
+private:
+	static const int WIDTH = 37;
+	static const int HEIGHT = 23;
+	static const int TOGGLES = 300;
+
+	int closest(Tile** p_tiles, int p_index)
+	{
+		int best = -1, bestDistance = 0;
+		for (int i = 0; i < WIDTH * HEIGHT; i++)
+		{
+			if (!p_tiles[i]->isFree())
+				continue;
+			int dx = abs(i % WIDTH - p_index % WIDTH);
+			int dy = abs(i / WIDTH - p_index / WIDTH);
+			int distance = max(dx, dy);
+			if (best < 0 || distance < bestDistance)
+			{
+				best = i;
+				bestDistance = distance;
+			}
+		}
+		return best;
+	}
+	bool matches(FreeTileIndex* p_index, Tile** p_tiles)
+	{
+		int free = 0;
+		for (int i = 0; i < WIDTH * HEIGHT; i++)
+		{
+			if (p_tiles[i]->isFree())
+				free++;
+			if (p_index->getNearest(i) != closest(p_tiles, i))
+				return false;
+		}
+		if (p_index->getFreeCount() != free)
+			return false;
+		for (int i = 0; i < free; i++)
+		{
+			if (!p_tiles[p_index->getFreeTile(i)]->isFree())
+				return false;
+		}
+		return true;
+	}
+public:
+	Test_FreeTileIndex(): Test("FREETILEINDEX")
+	{
+	}
+	void setup()
+	{
+		// Mostly walls, so the closest walkable tiles are far apart
+		srand(5);
+		Tile** tiles = new Tile*[WIDTH * HEIGHT];
+		for (int i = 0; i < WIDTH * HEIGHT; i++)
+			tiles[i] = new Tile(rand() % 100 < 5, TilePosition(i % WIDTH, i / WIDTH), 10, 10, NULL);
+		FreeTileIndex index(WIDTH, HEIGHT, tiles);
+		newEntry(TestData("Built", matches(&index, tiles)));
+
+		bool updated = true;
+		for (int i = 0; i < TOGGLES && updated; i++)
+		{
+			int tile = rand() % (WIDTH * HEIGHT);
+			tiles[tile]->setWalkAble(!tiles[tile]->isFree());
+			index.tileChanged(tile);
+			updated = matches(&index, tiles);
+		}
+		newEntry(TestData("Updated after toggles", updated));
+
+		for (int i = 0; i < WIDTH * HEIGHT; i++)
+		{
+			tiles[i]->setWalkAble(false);
+			index.tileChanged(i);
+		}
+		newEntry(TestData("No walkable tiles", index.getFreeCount() == 0 &&
+			index.getNearest(0) == -1));
+		for (int i = 0; i < WIDTH * HEIGHT; i++)
+			delete tiles[i];
+		delete[] tiles;
+
+		// Tilemap keeps its index up to date when tiles change
+		tiles = new Tile*[WIDTH * HEIGHT];
+		for (int i = 0; i < WIDTH * HEIGHT; i++)
+			tiles[i] = new Tile(false, TilePosition(i % WIDTH, i / WIDTH), 10, 10, NULL);
+		Tilemap map(WIDTH, HEIGHT, tiles);
+		newEntry(TestData("Random on blocked map", !map.randomFreeTile()));
+		tiles[5 * WIDTH + 30]->setWalkAble(true);
+		bool picked = true;
+		for (int i = 0; i < 10; i++)
+			picked = picked && map.randomFreeTile() == tiles[5 * WIDTH + 30];
+		newEntry(TestData("Random walkable tile", picked));
+		newEntry(TestData("Closest walkable tile", map.closestFreeTile(tiles[0]) ==
+			tiles[5 * WIDTH + 30]));
+		tiles[6 * WIDTH + 2]->setWalkAble(true);
+		newEntry(TestData("Closer tile opened", map.closestFreeTile(tiles[0]) ==
+			tiles[6 * WIDTH + 2]));
+		tiles[6 * WIDTH + 2]->setWalkAble(false);
+		newEntry(TestData("Closer tile closed", map.closestFreeTile(tiles[0]) ==
+			tiles[5 * WIDTH + 30]));
+	}
+};
+
+#endif
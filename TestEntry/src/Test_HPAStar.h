@@ -0,0 +1,162 @@
+#ifndef TESTHPASTAR_H
+#define TESTHPASTAR_H
+
+#include "Test.h"
+#include <Tilemap.h>
+#include <cstdlib>
+
+// Runs HPAStar on a generated map larger than the ones shipped. Routes
+// must exist exactly when A* finds a path, walk through free tiles when
+// refined and stay close to the shortest length. After a wall moves the
+// updated clusters must give routes as long as a graph built from scratch.
+class Test_HPAStar: public Test
+{
+private:
+	static const int SIZE = 200;
+	static const int QUERIES = 100;
+
+	Tilemap* createMap(Tile*** out_tiles)
+	{
+		// Scattered walls, and long walls with a few gaps every 23 columns
+		srand(7);
+		Tile** tiles = new Tile*[SIZE * SIZE];
+		for (int y = 0; y < SIZE; y++)
+		{
+			for (int x = 0; x < SIZE; x++)
+			{
+				bool free = rand() % 100 >= 25;
+				if (x % 23 == 22 && y % 40 > 2)
+					free = false;
+				tiles[y * SIZE + x] = new Tile(free, TilePosition(x, y), 10, 10, NULL);
+			}
+		}
+		*out_tiles = tiles;
+		return new Tilemap(SIZE, SIZE, tiles);
+	}
+	// Walked length of a route refined with p_search, -1 if a segment fails
+	int routeLength(const vector<Tile*>& p_route, AStar* p_search, bool* out_valid)
+	{
+		int length = 0;
+		for (unsigned int i = 1; i < p_route.size(); i++)
+		{
+			vector<Tile*> segment;
+			if (!p_search->findPath(p_route[i], p_route[i - 1], &segment))
+				return -1;
+			for (unsigned int j = 1; j < segment.size(); j++)
+			{
+				TilePosition step = segment[j]->getTilePosition() - segment[j - 1]->getTilePosition();
+				if (abs(step.x) + abs(step.y) != 1 || !segment[j]->isFree())
+					*out_valid = false;
+			}
+			length += segment.size() - 1;
+		}
+		return length;
+	}
+public:
+	Test_HPAStar(): Test("HPASTAR")
+	{
+	}
+	void setup()
+	{
+		Tile** tiles;
+		Tilemap* map = createMap(&tiles);
+		HPAStar* hierarchy = map->getHierarchy();
+		newEntry(TestData("Clusters built", hierarchy && hierarchy->getNodeCount() > 0));
+		if (!hierarchy)
+		{
+			delete map;
+			return;
+		}
+
+		vector<Tile*> freeTiles;
+		for (int i = 0; i < SIZE * SIZE; i++)
+		{
+			if (tiles[i]->isFree())
+				freeTiles.push_back(tiles[i]);
+		}
+
+		AStar search(SIZE, SIZE, tiles);
+		bool same = true;
+		bool valid = true;
+		int routeTotal = 0, shortestTotal = 0;
+		int routeExpanded = 0, searchExpanded = 0;
+		double routeTime = 0, searchTime = 0;
+		for (int i = 0; i < QUERIES; i++)
+		{
+			Tile* start = freeTiles[rand() % freeTiles.size()];
+			Tile* goal = freeTiles[rand() % freeTiles.size()];
+			vector<Tile*> route, path, segment;
+
+			// A monster only searches the first segment before walking
+			double begin = getTime();
+			bool routed = hierarchy->findRoute(start, goal, &route);
+			routeExpanded += hierarchy->getExpandedCount();
+			if (routed && route.size() > 1)
+			{
+				search.findPath(route[route.size() - 1], route[route.size() - 2], &segment);
+				routeExpanded += search.getExpandedCount();
+			}
+			double middle = getTime();
+			bool found = search.findPath(start, goal, &path);
+			double end = getTime();
+			searchExpanded += search.getExpandedCount();
+			routeTime += middle - begin;
+			searchTime += end - middle;
+
+			if (routed != found || (found && (route.front() != goal || route.back() != start)))
+			{
+				same = false;
+				continue;
+			}
+			if (found)
+			{
+				int length = routeLength(route, &search, &valid);
+				if (length < 0)
+					valid = false;
+				routeTotal += length;
+				shortestTotal += path.size() - 1;
+			}
+		}
+		newEntry(TestData("Routes where A* finds paths", same));
+		newEntry(TestData("Refined routes walkable", valid));
+		newEntry(TestData("Within 20% of shortest", routeTotal <= shortestTotal * 1.2));
+
+		// Nodes expanded decide, the times are only reported. The small
+		// searches inside the start and goal clusters are not counted.
+		stringstream times;
+		times << "HPA* " << routeExpanded << " vs A* " << searchExpanded << " nodes, "
+			<< (int)(routeTime * 1000) << " vs " << (int)(searchTime * 1000) << " ms";
+		newEntry(TestData(times.str(), routeExpanded < searchExpanded));
+
+		// Close an opening in one long wall and open another, only the
+		// clusters around them change
+		int rebuilt = hierarchy->getRebuiltClusterCount();
+		for (int y = 0; y < 3; y++)
+			map->getTile(TilePosition(22, 40 + y))->setWalkAble(false);
+		map->getTile(TilePosition(45, 10))->setWalkAble(true);
+
+		HPAStar fresh(SIZE, SIZE, tiles, 10);
+		bool updated = true;
+		for (int i = 0; i < QUERIES / 4; i++)
+		{
+			Tile* start = freeTiles[rand() % freeTiles.size()];
+			Tile* goal = freeTiles[rand() % freeTiles.size()];
+			if (!start->isFree() || !goal->isFree())
+				continue;
+			vector<Tile*> route, freshRoute;
+			bool routed = hierarchy->findRoute(start, goal, &route);
+			if (routed != fresh.findRoute(start, goal, &freshRoute) || (routed &&
+				routeLength(route, &search, &valid) != routeLength(freshRoute, &search, &valid)))
+			{
+				updated = false;
+			}
+		}
+		newEntry(TestData("Updated like a new graph", updated &&
+			hierarchy->getNodeCount() == fresh.getNodeCount()));
+		newEntry(TestData("Few clusters rebuilt", hierarchy->getRebuiltClusterCount() - rebuilt <= 10));
+
+		delete map;
+	}
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef TESTHAZARDLAYER_H
+#define TESTHAZARDLAYER_H
+
+#include "Test.h"
+#include <Bomb.h>
+#include <Tilemap.h>
+
+// Checks that hazards on a HazardLayer run out on time, that overlapping
+// ones keep the longest and that a bomb sets its tiles burning in rings
+// going outwards, which end when the bomb is reset.
+class Test_HazardLayer: public Test
+{
+private:
+	static const int SIZE = 7;
+public:
+	Test_HazardLayer(): Test("HAZARDLAYER")
+	{
+	}
+	void setup()
+	{
+		HazardLayer layer(4, 4);
+		layer.ignite(TilePosition(1, 2), 1.0f);
+		layer.ignite(TilePosition(1, 2), 0.5f);
+		layer.ignite(TilePosition(3, 3), 0.5f);
+		newEntry(TestData("Burning", layer.isBurning(TilePosition(1, 2)) &&
+			!layer.isBurning(TilePosition(2, 1))));
+		layer.update(0.75f);
+		newEntry(TestData("Longest kept", layer.isBurning(TilePosition(1, 2)) &&
+			!layer.isBurning(TilePosition(3, 3))));
+		layer.update(0.5f);
+		newEntry(TestData("Expired", !layer.isBurning(TilePosition(1, 2))));
+		layer.ignite(TilePosition(0, 0), 1.0f);
+		layer.extinguish(TilePosition(0, 0));
+		newEntry(TestData("Extinguished", !layer.isBurning(TilePosition(0, 0))));
+
+		// A bomb in the middle of a corridor along one row
+		Tile** tiles = new Tile*[SIZE * SIZE];
+		for (int i = 0; i < SIZE * SIZE; i++)
+			tiles[i] = new Tile(i / SIZE == 3, TilePosition(i % SIZE, i / SIZE), 10, 10, NULL);
+		Tilemap map(SIZE, SIZE, tiles);
+		HazardLayer* hazards = map.getHazards();
+
+		SpriteInfo sprites[SIZE * 2];
+		vector<SpriteInfo*> flames;
+		for (int i = 0; i < SIZE * 2 - 1; i++)
+			flames.push_back(&sprites[i]);
+		SoundInfo tick, blast;
+		Bomb bomb(&sprites[SIZE * 2 - 1], flames, &map, &tick, &blast);
+		bomb.spawn(tiles[3 * SIZE + 3]);
+
+		// The fuse burns for a second, then the blast grows a ring every
+		// 0.1 seconds
+		float step = 1.0f / 60.0f;
+		float time = 0;
+		bool ordered = true;
+		int lit = 0;
+		while (time < 1.6f)
+		{
+			hazards->update(step);
+			bomb.update(step, InputInfo());
+			time += step;
+			int burning = 0;
+			for (int x = 0; x < SIZE; x++)
+			{
+				if (hazards->isBurning(TilePosition(x, 3)))
+					burning++;
+			}
+			for (int d = 1; d <= 3; d++)
+			{
+				// No tile burns before the ones closer to the bomb
+				if ((hazards->isBurning(TilePosition(3 + d, 3)) &&
+					!hazards->isBurning(TilePosition(3 + d - 1, 3))) ||
+					(hazards->isBurning(TilePosition(3 - d, 3)) &&
+					!hazards->isBurning(TilePosition(3 - d + 1, 3))))
+				{
+					ordered = false;
+				}
+			}
+			lit = max(lit, burning);
+			if (time < 1.0f && burning > 0)
+				ordered = false;
+		}
+		newEntry(TestData("Whole row lit", lit == SIZE));
+		newEntry(TestData("Rings outwards", ordered));
+		newEntry(TestData("Other rows safe", !hazards->isBurning(TilePosition(3, 2))));
+
+		bomb.reset();
+		bool out = true;
+		for (int x = 0; x < SIZE; x++)
+			out = out && !hazards->isBurning(TilePosition(x, 3));
+		newEntry(TestData("Reset puts out flames", out));
+	}
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef TESTJUMPPOINTSEARCH_H
+#define TESTJUMPPOINTSEARCH_H
+
+#include "Test.h"
+#include "Test_AStar.h"
+#include <JumpPointSearch.h>
+
+// Compares JumpPointSearch with AStar. Paths must be found for the same
+// queries, be as long and only step between neighbouring free tiles. Every
+// map in the game's map folder gets an entry with the nodes expanded and
+// the time taken by both searches for the same random queries, jump point
+// search first.
+class Test_JumpPointSearch: public Test
+{
+private:
+	static const int QUERIES = 200;
+	static const int GRIDS = 200;
+
+	// Runs both searches from p_start to p_goal, false if they disagree
+	bool compare(AStar* p_astar, JumpPointSearch* p_jumpPoints, Tile* p_start, Tile* p_goal)
+	{
+		vector<Tile*> path, jumpPath;
+		bool found = p_astar->findPath(p_start, p_goal, &path);
+		if (found != p_jumpPoints->findPath(p_start, p_goal, &jumpPath))
+			return false;
+		return !found || (jumpPath.size() == path.size() &&
+			Test_AStar::isValidPath(jumpPath, p_start, p_goal));
+	}
+public:
+	Test_JumpPointSearch(): Test("JUMPPOINTSEARCH")
+	{
+	}
+	void setup()
+	{
+		Tile* tiles[9];
+		for (int i = 0; i < 9; i++)
+			tiles[i] = new Tile(i != 1 && i != 4, TilePosition(i % 3, i / 3), 10, 10, NULL);
+		JumpPointSearch small(3, 3, tiles);
+		vector<Tile*> path;
+		newEntry(TestData("Around wall", small.findPath(tiles[0], tiles[2], &path) &&
+			path.size() == 7 && Test_AStar::isValidPath(path, tiles[0], tiles[2])));
+		newEntry(TestData("Same tile", small.findPath(tiles[3], tiles[3], &path) &&
+			path.size() == 1 && path[0] == tiles[3]));
+		tiles[7]->setWalkAble(false);
+		path.clear();
+		newEntry(TestData("No path", !small.findPath(tiles[0], tiles[2], &path) &&
+			path.empty()));
+		for (int i = 0; i < 9; i++)
+			delete tiles[i];
+
+		// Small random grids have many forced turns next to scattered walls
+		srand(3);
+		bool same = true;
+		for (int i = 0; i < GRIDS; i++)
+		{
+			int width = 5 + rand() % 20;
+			int height = 5 + rand() % 20;
+			int walls = 10 + rand() % 40;
+			vector<Tile*> grid(width * height);
+			for (int j = 0; j < width * height; j++)
+			{
+				grid[j] = new Tile(rand() % 100 >= walls, TilePosition(j % width, j / width),
+					10, 10, NULL);
+			}
+			AStar astar(width, height, &grid[0]);
+			JumpPointSearch jumpPoints(width, height, &grid[0]);
+			for (int j = 0; j < 20; j++)
+			{
+				Tile* start = grid[rand() % grid.size()];
+				Tile* goal = grid[rand() % grid.size()];
+				if (start->isFree() && !compare(&astar, &jumpPoints, start, goal))
+					same = false;
+			}
+			for (int j = 0; j < width * height; j++)
+				delete grid[j];
+		}
+		newEntry(TestData("Random grids", same));
+
+		string folder = "../../WinEntry/Maps/";
+		vector<string> files;
+		WIN32_FIND_DATAA found;
+		HANDLE search = FindFirstFileA((folder + "*.txt").c_str(), &found);
+		if (search != INVALID_HANDLE_VALUE)
+		{
+			do
+				files.push_back(found.cFileName);
+			while (FindNextFileA(search, &found));
+			FindClose(search);
+		}
+
+		newSection("Shipped maps");
+		GOFactory factory(NULL);
+		int expanded = 0, jumpExpanded = 0;
+		double time = 0, jumpTime = 0;
+		same = true;
+		srand(1);
+		for (unsigned int i = 0; i < files.size(); i++)
+		{
+			Tilemap* map = Test_AStar::loadMap(folder + files[i], &factory);
+			if (!map)
+				continue;
+
+			int width = map->getWidth();
+			vector<Tile*> grid, freeTiles;
+			for (int j = 0; j < width * map->getHeight(); j++)
+			{
+				grid.push_back(map->getTile(TilePosition(j % width, j / width)));
+				if (grid.back()->isFree())
+					freeTiles.push_back(grid.back());
+			}
+			AStar astar(width, map->getHeight(), &grid[0]);
+			JumpPointSearch jumpPoints(width, map->getHeight(), &grid[0]);
+
+			int mapExpanded = 0, mapJumpExpanded = 0;
+			double mapTime = 0, mapJumpTime = 0;
+			for (int j = 0; j < QUERIES && !freeTiles.empty(); j++)
+			{
+				Tile* start = freeTiles[rand() % freeTiles.size()];
+				Tile* goal = freeTiles[rand() % freeTiles.size()];
+				vector<Tile*> path, jumpPath;
+
+				double begin = getTime();
+				bool pathFound = astar.findPath(start, goal, &path);
+				double middle = getTime();
+				bool jumpFound = jumpPoints.findPath(start, goal, &jumpPath);
+				double end = getTime();
+				mapTime += middle - begin;
+				mapJumpTime += end - middle;
+				mapExpanded += astar.getExpandedCount();
+				mapJumpExpanded += jumpPoints.getExpandedCount();
+
+				if (pathFound != jumpFound || (pathFound && (jumpPath.size() != path.size() ||
+					!Test_AStar::isValidPath(jumpPath, start, goal))))
+				{
+					same = false;
+				}
+			}
+			expanded += mapExpanded;
+			jumpExpanded += mapJumpExpanded;
+			time += mapTime;
+			jumpTime += mapJumpTime;
+
+			stringstream entry;
+			entry << files[i] << ": " << mapJumpExpanded << " vs " << mapExpanded
+				<< " nodes, " << (int)(mapJumpTime * 1000000) << " vs "
+				<< (int)(mapTime * 1000000) << " us";
+			newEntry(TestData(entry.str(), mapJumpExpanded < mapExpanded));
+			delete map;
+		}
+		newEntry(TestData("Maps loaded", !files.empty()));
+		newEntry(TestData("Same path lengths as A*", same));
+
+		stringstream times;
+		times << "JPS " << (int)(jumpTime * 1000) << " ms vs A* " << (int)(time * 1000)
+			<< " ms, " << jumpExpanded << " vs " << expanded << " nodes";
+		newEntry(TestData(times.str(), jumpExpanded < expanded));
+	}
+};
+
+#endif
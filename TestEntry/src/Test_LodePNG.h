@@ -0,0 +1,81 @@
+#ifndef TESTLODEPNG_H
+#define TESTLODEPNG_H
+
+#include "Test.h"
+#include <LodePNG.h>
+
+// Decodes every PNG in the game's texture folder with and without the
+// fast decode path. The results must match, the times are printed.
+class Test_LodePNG: public Test
+{
+private:
+	static const int ROUNDS = 3;
+
+	unsigned decode(const vector<unsigned char>& p_file, bool p_fast,
+		vector<unsigned char>* out_image, double* out_time)
+	{
+		unsigned error = 0;
+		double start = getTime();
+		for (int i = 0; i < ROUNDS; i++)
+		{
+			lodepng::State state;
+			state.decoder.fast_decode = p_fast ? 1 : 0;
+			unsigned width = 0, height = 0;
+			out_image->clear();
+			error = lodepng::decode(*out_image, width, height, state, p_file);
+		}
+		*out_time += (getTime() - start) / ROUNDS;
+		return error;
+	}
+public:
+	Test_LodePNG(): Test("LODEPNG")
+	{
+	}
+	void setup()
+	{
+		string folder = "../../WinEntry/Textures/";
+		vector<string> files;
+		WIN32_FIND_DATAA found;
+		HANDLE search = FindFirstFileA((folder + "*.png").c_str(), &found);
+		if (search != INVALID_HANDLE_VALUE)
+		{
+			do
+				files.push_back(folder + found.cFileName);
+			while (FindNextFileA(search, &found));
+			FindClose(search);
+		}
+		newEntry(TestData("Textures found", !files.empty()));
+
+		bool same = true;
+		double referenceTime = 0, fastTime = 0;
+		for (unsigned int i = 0; i < files.size(); i++)
+		{
+			vector<unsigned char> file, reference, fast;
+			lodepng::load_file(file, files[i]);
+			unsigned referenceError = decode(file, false, &reference, &referenceTime);
+			unsigned fastError = decode(file, true, &fast, &fastTime);
+			if (referenceError != fastError || reference != fast)
+				same = false;
+		}
+		newEntry(TestData("Fast decode matches", same));
+
+		// Other color types take the regular path, a damaged file falls back
+		vector<unsigned char> file;
+		lodepng::load_file(file, folder + "logo.png");
+		if (file.size() > 1000)
+			file[file.size() / 2] ^= 0x10;
+		vector<unsigned char> reference, fast;
+		double unused = 0;
+		unsigned referenceError = decode(file, false, &reference, &unused);
+		unsigned fastError = decode(file, true, &fast, &unused);
+		newEntry(TestData("Damaged file", referenceError != 0 &&
+			referenceError == fastError));
+
+		stringstream times;
+		times << "Fast " << (int)(fastTime * 1000) << " ms vs "
+			<< (int)(referenceTime * 1000) << " ms";
+		newEntry(TestData(times.str(), true));
+	}
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef TESTPATHCACHE_H
+#define TESTPATHCACHE_H
+
+#include "Test.h"
+#include <Tilemap.h>
+
+class Test_PathCache: public Test
+{
+private:
+	Tilemap* createMap(Tile*** out_tiles)
+	{
+		Tile** tiles = new Tile*[12];
+		for (int i = 0; i < 12; i++)
+			tiles[i] = new Tile(true, TilePosition(i % 4, i / 4), 10, 10, NULL);
+		*out_tiles = tiles;
+		return new Tilemap(4, 3, tiles);
+	}
+public:
+	Test_PathCache(): Test("PATHCACHE")
+	{
+	}
+	void setup()
+	{
+		Tile** tiles;
+		Tilemap* map = createMap(&tiles);
+		PathCache* cache = map->getPathCache();
+		vector<Tile*> path;
+
+		map->findPath(tiles[0], tiles[11], &path);
+		newEntry(TestData("First search misses", cache->getMisses() == 1 &&
+			cache->getHits() == 0));
+		map->findPath(tiles[0], tiles[11], &path);
+		newEntry(TestData("Same search hits", cache->getHits() == 1 &&
+			path.size() == 6 && path.front() == tiles[11] && path.back() == tiles[0]));
+		map->findPath(tiles[11], tiles[0], &path);
+		newEntry(TestData("Reversed search hits", cache->getHits() == 2 &&
+			path.size() == 6 && path.front() == tiles[0] && path.back() == tiles[11]));
+
+		// Blocking a tile changes the topology and drops the cached path
+		unsigned int version = map->getTopologyVersion();
+		tiles[11]->setWalkAble(true);
+		newEntry(TestData("Same walkability kept", map->getTopologyVersion() == version));
+		int rebuilds = map->getFlowField()->getRebuildCount();
+		map->getFlowField()->setTarget(tiles[0]);
+		map->getFlowField()->getDistance(tiles[5]);
+		tiles[7]->setWalkAble(false);
+		newEntry(TestData("Topology changed", map->getTopologyVersion() == version + 1));
+
+		bool found = map->findPath(tiles[0], tiles[11], &path);
+		newEntry(TestData("Stale path dropped", found && cache->getMisses() == 2 &&
+			cache->getSize() == 1 && path.size() == 6 && path[1] == tiles[10]));
+		map->getFlowField()->getDistance(tiles[5]);
+		newEntry(TestData("Flow field rebuilt", map->getFlowField()->getRebuildCount() == rebuilds + 2));
+
+		// The goal is walled in, its region tells without a search
+		tiles[10]->setWalkAble(false);
+		found = map->findPath(tiles[0], tiles[11], &path);
+		newEntry(TestData("Unreachable region", !found && path.size() == 6 &&
+			map->getUnreachableCount() == 1 && cache->getMisses() == 2));
+		delete map;
+
+		// The least recently used path is dropped when full
+		PathCache small(2);
+		bool hit;
+		vector<Tile*> empty;
+		small.store(0, 1, 0, false, empty);
+		small.store(0, 2, 0, false, empty);
+		small.find(0, 1, 0, &hit, &path);
+		small.store(0, 3, 0, false, empty);
+		newEntry(TestData("Oldest dropped", small.getSize() == 2 &&
+			small.find(0, 1, 0, &hit, &path) && !small.find(0, 2, 0, &hit, &path) &&
+			small.find(0, 3, 0, &hit, &path)));
+		newEntry(TestData("New version clears", !small.find(0, 1, 1, &hit, &path) &&
+			small.getSize() == 0));
+	}
+};
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef TESTPILLFIELD_H
+#define TESTPILLFIELD_H
+
+#include "Test.h"
+#include <PillField.h>
+#include <Pill.h>
+#include <PillEatenState.h>
+#include <SpritePool.h>
+
+// Checks that the pill field counts and eats pills through the tiles and
+// the game stats, floats them like the pill objects and draws them all as
+// instances of one sprite. The time to load a 100x100 map full of pills is
+// reported both ways.
+class Test_PillField: public Test
+{
+private:
+	static const int SIZE = 100;
+
+	SpriteInfo* createSprite(SpritePool* p_pool, int p_x, int p_y)
+	{
+		SpriteInfo* sprite = p_pool->add();
+		sprite->transformInfo.translation[TransformInfo::X] = p_x * 32.0f + 16;
+		sprite->transformInfo.translation[TransformInfo::Y] = p_y * 32.0f + 16;
+		sprite->transformInfo.translation[TransformInfo::Z] = 0.1f;
+		sprite->transformInfo.scale[TransformInfo::X] = 22.4f;
+		sprite->transformInfo.scale[TransformInfo::Y] = 22.4f;
+		return sprite;
+	}
+	bool closeTo(float p_a, float p_b)
+	{
+		return fabs(p_a - p_b) < 0.01f;
+	}
+public:
+	Test_PillField(): Test("PILLFIELD")
+	{
+	}
+	void setup()
+	{
+		SpritePool pool;
+		GameStats stats(NULL, 20);
+		SoundInfo* sound = new SoundInfo();
+		SpriteInfo* sprite = createSprite(&pool, 0, 0);
+		PillField* field = new PillField(SIZE, SIZE, 32, 32, sprite, sound, &stats);
+
+		vector<Tile*> tiles;
+		for (int i = 0; i < 3; i++)
+		{
+			tiles.push_back(new Tile(true, TilePosition(i + 3, 4), 32, 32, NULL));
+			field->add(tiles.back());
+		}
+		field->add(tiles.back());
+		newEntry(TestData("Added", field->getRemaining() == 3 &&
+			stats.getNumPills() == 3 && field->hasPill(TilePosition(4, 4)) &&
+			!field->hasPill(TilePosition(4, 5))));
+		newEntry(TestData("Hidden before update", !sprite->visible));
+
+		// A pill object on the same tile floats the same way
+		Pill own(createSprite(&pool, 3, 4), NULL, NULL, NULL);
+		InputInfo input;
+		for (int i = 0; i < 30; i++)
+		{
+			own.update(0.016f, input);
+			field->update(0.016f);
+		}
+		const TransformInfo& floating = field->getInstance(0);
+		TransformInfo& expected = own.getSpriteInfo()->transformInfo;
+		newEntry(TestData("Same floating",
+			closeTo(floating.translation[TransformInfo::X], expected.translation[TransformInfo::X]) &&
+			closeTo(floating.translation[TransformInfo::Y], expected.translation[TransformInfo::Y]) &&
+			closeTo(floating.scale[TransformInfo::X], expected.scale[TransformInfo::X]) &&
+			floating.translation[TransformInfo::Z] == 0.1f));
+		newEntry(TestData("One sprite", sprite->visible &&
+			sprite->instanceCount == 3 && sprite->instances == &field->getInstance(0)));
+
+		bool eaten = tiles[1]->removePill();
+		newEntry(TestData("Eaten", eaten && !tiles[1]->removePill() &&
+			field->getRemaining() == 2 && stats.getNumPills() == 2 &&
+			stats.getScore() > 0 && sound->play));
+
+		field->update(0.25f);
+		newEntry(TestData("Eaten animates", field->getInstanceCount() == 3 &&
+			field->getInstance(2).scale[TransformInfo::X] > 22.4f * 1.25f));
+		field->update(1.0f);
+		newEntry(TestData("Eaten gone", field->getInstanceCount() == 2));
+
+		tiles[0]->removePill();
+		tiles[2]->removePill();
+		field->update(1.0f);
+		field->update(0.016f);
+		newEntry(TestData("All eaten", field->getRemaining() == 0 &&
+			stats.getNumPills() == 0 && !sprite->visible && sprite->instanceCount == 0));
+
+		delete field;
+		newEntry(TestData("Deleted", sprite->instances == NULL && sound->deleted));
+		delete sound;
+		for (unsigned int i = 0; i < tiles.size(); i++)
+			delete tiles[i];
+		tiles.clear();
+
+		// Every tile on the map has a pill, once as objects and once in a field
+		for (int y = 0; y < SIZE; y++)
+			for (int x = 0; x < SIZE; x++)
+				tiles.push_back(new Tile(true, TilePosition(x, y), 32, 32, NULL));
+
+		GameStats objectStats(NULL, 20);
+		vector<Pill*> pills;
+		vector<SoundInfo*> sounds;
+		double begin = getTime();
+		for (unsigned int i = 0; i < tiles.size(); i++)
+		{
+			TilePosition position = tiles[i]->getTilePosition();
+			sounds.push_back(new SoundInfo());
+			pills.push_back(new Pill(createSprite(&pool, position.x, position.y),
+				sounds.back(), tiles[i], &objectStats));
+		}
+		double middle = getTime();
+		GameStats fieldStats(NULL, 20);
+		sound = new SoundInfo();
+		field = new PillField(SIZE, SIZE, 32, 32, createSprite(&pool, 0, 0), sound, &fieldStats);
+		for (unsigned int i = 0; i < tiles.size(); i++)
+			field->add(tiles[i]);
+		double end = getTime();
+
+		newEntry(TestData("Full map", field->getRemaining() == SIZE * SIZE &&
+			fieldStats.getNumPills() == objectStats.getNumPills()));
+
+		stringstream times;
+		times << "Load: field " << (int)((end - middle) * 1000) << " ms vs objects "
+			<< (int)((middle - begin) * 1000) << " ms";
+		newEntry(TestData(times.str(), true));
+
+		// What each pill object holds on its own, against one bit per tile
+		int objectBytes = SIZE * SIZE * (sizeof(Pill) + sizeof(PillEatenState) +
+			sizeof(SpriteInfo) + sizeof(SoundInfo));
+		int fieldBytes = sizeof(PillField) + sizeof(SpriteInfo) + sizeof(SoundInfo) +
+			(SIZE * SIZE + 31) / 32 * 4;
+		stringstream bytes;
+		bytes << "Memory: field " << fieldBytes / 1024 << " kB vs objects "
+			<< objectBytes / 1024 << " kB";
+		newEntry(TestData(bytes.str(), fieldBytes * 10 < objectBytes));
+
+		field->update(0.016f);
+		newEntry(TestData("One batch", field->getInstanceCount() == SIZE * SIZE));
+
+		delete field;
+		delete sound;
+		for (unsigned int i = 0; i < pills.size(); i++)
+		{
+			delete pills[i];
+			delete sounds[i];
+		}
+		for (unsigned int i = 0; i < tiles.size(); i++)
+			delete tiles[i];
+	}
+};
+
+#endif
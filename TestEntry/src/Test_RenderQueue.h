@@ -0,0 +1,85 @@
+#ifndef TESTRENDERQUEUE_H
+#define TESTRENDERQUEUE_H
+
+#include "Test.h"
+#include <RenderQueue.h>
+#include <cstdlib>
+
+class Test_RenderQueue: public Test
+{
+private:
+	SpriteInfo* createSprite(float p_depth)
+	{
+		SpriteInfo* sprite = new SpriteInfo();
+		sprite->transformInfo.translation[TransformInfo::Z] = p_depth;
+		return sprite;
+	}
+public:
+	Test_RenderQueue(): Test("RENDERQUEUE")
+	{
+	}
+	void setup()
+	{
+		newEntry(TestData("Depth order", 
+			RenderQueue::makeKey(-1.0f, 9, 9) < RenderQueue::makeKey(0.0f, 0, 0) &&
+			RenderQueue::makeKey(0.1f, 9, 9) < RenderQueue::makeKey(0.5f, 0, 0)));
+		newEntry(TestData("Texture before sequence", 
+			RenderQueue::makeKey(0.5f, 1, 9) < RenderQueue::makeKey(0.5f, 2, 0)));
+
+		// Back to front, grouped per texture, ties in insertion order
+		RenderQueue queue;
+		SpriteInfo* sprites[6];
+		sprites[0] = createSprite(0.9f);
+		sprites[1] = createSprite(0.1f);
+		sprites[2] = createSprite(0.5f);
+		sprites[3] = createSprite(0.1f);
+		sprites[4] = createSprite(0.1f);
+		sprites[5] = createSprite(0.0f);
+		sprites[5]->visible = false;
+		int textures[] = {0, 2, 0, 1, 2, 0};
+		for (int i = 0; i < 6; i++)
+			queue.add(sprites[i], textures[i]);
+		queue.sort();
+
+		int expected[] = {3, 1, 4, 2, 0};
+		bool order = queue.getCount() == 5;
+		for (int i = 0; order && i < 5; i++)
+			order = queue.getSpriteInfo(i) == sprites[expected[i]];
+		newEntry(TestData("Sorted order", order));
+
+		const RenderQueueStats& stats = queue.getStats();
+		newEntry(TestData("Stats", stats.queued == 5 && stats.culled == 1 &&
+			stats.depthLayers == 3 && stats.textureRuns == 3));
+
+		for (int i = 0; i < 6; i++)
+			delete sprites[i];
+
+		// Many sprites spread over depths and textures
+		queue.clear();
+		vector<SpriteInfo*> many;
+		srand(1);
+		for (int i = 0; i < 2000; i++)
+		{
+			many.push_back(createSprite((rand() % 100) / 50.0f - 1.0f));
+			queue.add(many.back(), rand() % 8);
+		}
+		queue.sort();
+		bool sorted = queue.getCount() == 2000;
+		for (int i = 1; sorted && i < queue.getCount(); i++)
+			sorted = queue.getKey(i - 1) < queue.getKey(i);
+		bool depthSorted = true;
+		for (int i = 1; i < queue.getCount(); i++)
+		{
+			if (queue.getSpriteInfo(i - 1)->transformInfo.translation[TransformInfo::Z] >
+				queue.getSpriteInfo(i)->transformInfo.translation[TransformInfo::Z])
+			{
+				depthSorted = false;
+			}
+		}
+		newEntry(TestData("Large queue", sorted && depthSorted));
+		for (unsigned int i = 0; i < many.size(); i++)
+			delete many[i];
+	}	
+};	
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef TESTSKYLINEPACKER_H
+#define TESTSKYLINEPACKER_H
+
+#include "Test.h"
+#include <SkylinePacker.h>
+#include <Rect.h>
+
+class Test_SkylinePacker: public Test
+{
+private:
+	bool overlaps(const Rect& p_a, const Rect& p_b)
+	{
+		return p_a.x < p_b.x + p_b.width && p_b.x < p_a.x + p_a.width &&
+			p_a.y < p_b.y + p_b.height && p_b.y < p_a.y + p_a.height;
+	}
+public:
+	Test_SkylinePacker(): Test("SKYLINEPACKER")
+	{
+	}
+	void setup()
+	{
+		SkylinePacker packer(128, 128);
+		int x = -1, y = -1;
+		newEntry(TestData("First at origin", 
+			packer.insert(64, 32, &x, &y) == GAME_OK && x == 0 && y == 0));
+
+		// Mixed sizes until the page is full
+		vector<Rect> placed;
+		placed.push_back(Rect(0, 0, 64, 32));
+		int sizes[] = {16, 48, 32, 8, 40, 24};
+		bool inside = true;
+		for (int i = 0; i < 30; i++)
+		{
+			int w = sizes[i % 6];
+			int h = sizes[(i + 2) % 6];
+			if (packer.insert(w, h, &x, &y) != GAME_OK)
+				continue;
+			Rect r(x, y, w, h);
+			if (x < 0 || y < 0 || x + w > 128 || y + h > 128)
+				inside = false;
+			placed.push_back(r);
+		}
+		bool noOverlap = true;
+		for (unsigned int i = 0; i < placed.size(); i++)
+			for (unsigned int j = i + 1; j < placed.size(); j++)
+				if (overlaps(placed[i], placed[j]))
+					noOverlap = false;
+
+		newEntry(TestData("Inside page", inside));
+		newEntry(TestData("No overlap", noOverlap));
+
+		int area = 0;
+		for (unsigned int i = 0; i < placed.size(); i++)
+			area += placed[i].width * placed[i].height;
+		newEntry(TestData("Used area", packer.getUsedArea() == area));
+
+		newEntry(TestData("Too large", 
+			packer.insert(129, 8, &x, &y) == GAME_FAIL));
+
+		SkylinePacker exact(64, 64);
+		exact.insert(32, 64, &x, &y);
+		exact.insert(32, 64, &x, &y);
+		newEntry(TestData("Full page", exact.getOccupancy() == 1.0f &&
+			exact.insert(1, 1, &x, &y) == GAME_FAIL));
+	}	
+};	
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef TESTSPATIALGRID_H
+#define TESTSPATIALGRID_H
+
+#include "Test.h"
+#include <SpatialGrid.h>
+#include <cstdlib>
+#include <cmath>
+
+// Fills a SpatialGrid with random points, some of them outside the map,
+// and checks that queries return every point within reach and nothing
+// more than once. Refilling after clear must forget the old points.
+class Test_SpatialGrid: public Test
+{
+private:
+	static const int WIDTH = 30;
+	static const int HEIGHT = 20;
+	static const int POINTS = 200;
+
+	float randomCoordinate(int p_cells)
+	{
+		// A bit outside the map on both sides
+		return (rand() % ((p_cells + 4) * 100)) / 10.0f - 20.0f;
+	}
+	bool queryMatches(SpatialGrid* p_grid, const vector<fVector2>& p_points, int* out_returned)
+	{
+		for (int i = 0; i < 50; i++)
+		{
+			fVector2 position(randomCoordinate(WIDTH), randomCoordinate(HEIGHT));
+			float reach = (rand() % 300) / 10.0f;
+			vector<int> ids;
+			p_grid->query(position, reach, &ids);
+			*out_returned += ids.size();
+
+			vector<int> counts(p_points.size(), 0);
+			for (unsigned int j = 0; j < ids.size(); j++)
+				counts[ids[j]]++;
+			for (unsigned int j = 0; j < p_points.size(); j++)
+			{
+				bool near = fabs(p_points[j].x - position.x) <= reach &&
+					fabs(p_points[j].y - position.y) <= reach;
+				if (counts[j] > 1 || (near && counts[j] == 0))
+					return false;
+			}
+		}
+		return true;
+	}
+public:
+	Test_SpatialGrid(): Test("SPATIALGRID")
+	{
+	}
+	void setup()
+	{
+		srand(13);
+		SpatialGrid grid(WIDTH, HEIGHT, 10, 10);
+		vector<fVector2> points;
+		for (int i = 0; i < POINTS; i++)
+		{
+			points.push_back(fVector2(randomCoordinate(WIDTH), randomCoordinate(HEIGHT)));
+			grid.add(points.back(), i);
+		}
+		newEntry(TestData("Size", grid.getSize() == POINTS));
+
+		int returned = 0;
+		newEntry(TestData("Finds points within reach", queryMatches(&grid, points, &returned)));
+		newEntry(TestData("Fewer than all points", returned < 50 * POINTS / 2));
+
+		grid.clear();
+		vector<int> ids;
+		grid.query(fVector2(150, 100), 1000, &ids);
+		newEntry(TestData("Empty after clear", grid.getSize() == 0 && ids.empty()));
+
+		points.clear();
+		for (int i = 0; i < POINTS; i++)
+		{
+			points.push_back(fVector2(randomCoordinate(WIDTH), randomCoordinate(HEIGHT)));
+			grid.add(points.back(), i);
+		}
+		returned = 0;
+		newEntry(TestData("Refilled", queryMatches(&grid, points, &returned)));
+	}
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef TESTSPRITEPOOL_H
+#define TESTSPRITEPOOL_H
+
+#include "Test.h"
+#include <SpritePool.h>
+
+class Test_SpritePool: public Test
+{
+public:
+	Test_SpritePool(): Test("SPRITEPOOL")
+	{
+	}
+	void setup()
+	{
+		SpritePool pool;
+		SpriteInfo* first = pool.add();
+		SpriteInfo* second = pool.add();
+		SpriteHandle firstHandle = first->id;
+		SpriteHandle secondHandle = second->id;
+		newEntry(TestData("Add", pool.getCount() == 2 && 
+			pool.get(firstHandle) == first && pool.get(secondHandle) == second));
+
+		first->visible = false;
+		newEntry(TestData("Remove", pool.remove(firstHandle) == GAME_OK &&
+			pool.getCount() == 1 && pool.getSpriteInfo(0) == second));
+		newEntry(TestData("Stale handle", pool.get(firstHandle) == NULL &&
+			!pool.isValid(firstHandle) && pool.remove(firstHandle) == GAME_FAIL));
+
+		// The freed slot is reused with a new generation and fresh data
+		SpriteInfo* third = pool.add();
+		newEntry(TestData("Reuse slot", third == first && third->visible &&
+			third->id != firstHandle && pool.get(firstHandle) == NULL &&
+			pool.get(third->id) == third));
+
+		SpritePool otherPool(1);
+		otherPool.add();
+		newEntry(TestData("Other pool", otherPool.get(secondHandle) == NULL));
+
+		// Pointers stay valid when the pool grows
+		vector<SpriteInfo*> sprites;
+		for (int i = 0; i < 1000; i++)
+			sprites.push_back(pool.add());
+		bool stable = pool.get(secondHandle) == second;
+		for (unsigned int i = 0; i < sprites.size(); i++)
+			if (pool.get(sprites[i]->id) != sprites[i])
+				stable = false;
+		newEntry(TestData("Stable pointers", stable && pool.getCount() == 1002));
+
+		int capacity = pool.getCapacity();
+		pool.clear();
+		newEntry(TestData("Clear", pool.getCount() == 0 && 
+			pool.get(secondHandle) == NULL && pool.getCapacity() == capacity));
+
+		newEntry(TestData("Texture paths", SpriteInfo("../a.png").texturePathId ==
+			TexturePaths::intern("../a.png") && TexturePaths::intern("") == 0 &&
+			TexturePaths::getPath(TexturePaths::intern("../b.png")) == "../b.png"));
+	}	
+};	
+
+#endif
@@ -3,10 +3,34 @@
 
 #include "Test.h"
 #include <Tilemap.h>
+#include <cstdlib>
 
 class Test_Tilemap: public Test
 {
 private:
+	// Walks tile by tile the way the line queries used to
+	bool walkLine(Tilemap* p_map, TilePosition p_from, TilePosition p_to)
+	{
+		TilePosition diff = p_to - p_from;
+		if (diff.x != 0 && diff.y != 0)
+			return false;
+		diff.x /= max(1, abs(diff.x));
+		diff.y /= max(1, abs(diff.y));
+		for (TilePosition p = p_from; !(p == p_to); p = p + diff)
+		{
+			if (!p_map->getTile(p)->isFree())
+				return false;
+		}
+		return true;
+	}
+	Tile* walkFarthest(Tilemap* p_map, TilePosition p_from, TilePosition p_direction)
+	{
+		if (!p_map->getTile(p_from)->isFree())
+			return p_map->getTile(p_from);
+		while (p_map->isFree(p_from + p_direction))
+			p_from = p_from + p_direction;
+		return p_map->getTile(p_from);
+	}
 	void test1()
 	{
 	}
@@ -40,6 +64,58 @@ public:
 		newEntry(TestData("Invalid Position -X", !map.isValidPosition(TilePosition(-1, 1))));
 		newEntry(TestData("Invalid Position +Y", !map.isValidPosition(TilePosition(0, 3))));
 		newEntry(TestData("Invalid Position -Y", !map.isValidPosition(TilePosition(0, -1))));
+
+		newSection("Walkable Bits");
+		newEntry(TestData("Free Tile", map.isFree(TilePosition(1, 1))));
+		newEntry(TestData("Blocked Tile", !map.isFree(TilePosition(1, 2))));
+		newEntry(TestData("Outside Map", !map.isFree(TilePosition(2, 0)) && !map.isFree(-1, 0)));
+		tiles[1]->setWalkAble(false);
+		tiles[5]->setWalkAble(true);
+		newEntry(TestData("Follows Tiles", !map.isFree(1, 0) && map.isFree(1, 2)));
+
+		// Rows cross the 32 bit words the bits are stored in
+		Tile** wide = new Tile*[40 * 3];
+		for (int i = 0; i < 40 * 3; i++)
+			wide[i] = new Tile(i % 3 != 0, TilePosition(i % 40, i / 40), 10, 10, NULL);
+		Tilemap wideMap(40, 3, wide);
+		bool same = true;
+		for (int i = 0; i < 40 * 3; i += 7)
+			wide[i]->setWalkAble(!wide[i]->isFree());
+		for (int i = 0; i < 40 * 3; i++)
+			same = same && wideMap.isFree(i % 40, i / 40) == wide[i]->isFree();
+		newEntry(TestData("Wide Map", same));
+
+		// Line queries after walls open and close, the runs along rows and
+		// columns must follow
+		newSection("Line Queries");
+		srand(11);
+		bool lines = true, farthest = true;
+		for (int i = 0; i < 50; i++)
+		{
+			int tile = rand() % (40 * 3);
+			wide[tile]->setWalkAble(!wide[tile]->isFree());
+			for (int j = 0; j < 20; j++)
+			{
+				Tile* from = wide[rand() % (40 * 3)];
+				TilePosition p = from->getTilePosition();
+				TilePosition row(rand() % 40, p.y);
+				TilePosition column(p.x, rand() % 3);
+				lines = lines && wideMap.isLineFree(from, wideMap.getTile(row)) ==
+					walkLine(&wideMap, p, row);
+				lines = lines && wideMap.isLineFree(from, wideMap.getTile(column)) ==
+					walkLine(&wideMap, p, column);
+				TilePosition directions[] = {TilePosition(1, 0), TilePosition(-1, 0),
+					TilePosition(0, 1), TilePosition(0, -1)};
+				for (int k = 0; k < 4; k++)
+				{
+					farthest = farthest && wideMap.farthestFreeTile(from, directions[k]) ==
+						walkFarthest(&wideMap, p, directions[k]);
+				}
+			}
+		}
+		newEntry(TestData("Line Of Sight", lines));
+		newEntry(TestData("Farthest Free Tile", farthest));
+		newEntry(TestData("Not In Line", !wideMap.isLineFree(wide[0], wide[41])));
 	}	
 };	
 
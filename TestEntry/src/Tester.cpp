@@ -23,6 +23,22 @@
 #include "Test_MenuItem.h"
 #include "Test_Bomb.h"
 #include "Test_BombPill.h"
+#include "Test_SkylinePacker.h"
+#include "Test_RenderQueue.h"
+#include "Test_SpritePool.h"
+#include "Test_LodePNG.h"
+#include "Test_AStar.h"
+#include "Test_FlowField.h"
+#include "Test_PathCache.h"
+#include "Test_HPAStar.h"
+#include "Test_JumpPointSearch.h"
+#include "Test_FreeTileIndex.h"
+#include "Test_SpatialGrid.h"
+#include "Test_HazardLayer.h"
+#include "Test_EntityStore.h"
+#include "Test_ActivityList.h"
+#include "Test_PillField.h"
+#include "Test_AnimationPlayer.h"
 
 void Tester::run()
 {
@@ -50,6 +66,22 @@ void Tester::run()
 	tests.push_back(new Test_MenuItem());
 	tests.push_back(new Test_Bomb());
 	tests.push_back(new Test_BombPill());
+	tests.push_back(new Test_SkylinePacker());
+	tests.push_back(new Test_RenderQueue());
+	tests.push_back(new Test_SpritePool());
+	tests.push_back(new Test_LodePNG());
+	tests.push_back(new Test_AStar());
+	tests.push_back(new Test_FlowField());
+	tests.push_back(new Test_PathCache());
+	tests.push_back(new Test_HPAStar());
+	tests.push_back(new Test_JumpPointSearch());
+	tests.push_back(new Test_FreeTileIndex());
+	tests.push_back(new Test_SpatialGrid());
+	tests.push_back(new Test_HazardLayer());
+	tests.push_back(new Test_EntityStore());
+	tests.push_back(new Test_ActivityList());
+	tests.push_back(new Test_PillField());
+	tests.push_back(new Test_AnimationPlayer());
 
 	int totalAmountOfFailures=0;
 	int totalAmountOfTestfuncs=0;
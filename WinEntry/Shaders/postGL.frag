@@ -0,0 +1,19 @@
+#version 140
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D SceneSampler;
+uniform float BlackAndWhite;
+uniform float FadeToBlack;
+
+void main()
+{
+	FragColor = texture2D( SceneSampler, TexCoord );
+
+	float value = (FragColor.x + FragColor.y + FragColor.z) / 3; 
+	vec4 bw = vec4(value, value, value, 1.0f);
+
+	FragColor = BlackAndWhite * bw + (1 - BlackAndWhite) * FragColor;
+	FragColor *= (1 - FadeToBlack);
+	FragColor.a = 1.0f;
+}
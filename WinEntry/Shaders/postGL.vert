@@ -0,0 +1,9 @@
+#version 140
+in vec2 Position;
+
+out vec2 TexCoord;
+void main()
+{
+    gl_Position = vec4(Position, 0.0f, 1.0f);
+    TexCoord = Position * 0.5f + 0.5f;
+}
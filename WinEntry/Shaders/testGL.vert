@@ -1,12 +1,18 @@
 #version 140
 uniform vec2 ScreenSize;
-uniform vec2 HalfScale;
-uniform vec4 CenterPosition;
-uniform vec4 TextureRect;
 in vec3 MCVertex;
 in vec2 MCTexCoord;
+
+// Per-instance attributes. The per-sprite path sets them as constant
+// vertex attributes, the batched path streams them from an instance buffer.
+in vec4 CenterPosition;
+in vec2 HalfScale;
+in vec4 TextureRect;
+in vec4 ColorOverlay;
+
 out vec3 Pos;
 out vec2 TexCoord;
+out vec4 Overlay;
 void main()
 {
 	vec3 outvec;
@@ -23,4 +29,5 @@ void main()
 		);
     Pos = vec3(gl_Position.x, gl_Position.y, gl_Position.z);
     TexCoord = TextureRect.xy + TextureRect.zw * MCTexCoord;
-}
\ No newline at end of file
+    Overlay = ColorOverlay;
+}
@@ -8,7 +8,7 @@ outFile = Game
 cFlags = -c -g
 
 # Linker flags used when linking binary
-lFlags = $(shell pkg-config --libs --cflags libglfw2)
+lFlags = $(shell pkg-config --libs --cflags libglfw2) -lpthread
 
 # Link when compiling is done. This should not be done for "libraries". "link" 
 # should be set to 'true' or 'false'. Everything other than 'true' results in 
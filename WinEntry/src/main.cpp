@@ -90,14 +90,73 @@ int WINAPI WinMain(HINSTANCE hInstance,
 
 // OpenGl Linux
 #include <GlContext.h>
+#include <NullContext.h>
 #include <LinTimer.h>
+#include <FixedStepTimer.h>
+#include <Tilemap.h>
+#include <cstdlib>
 
 int main(int argc, char** argv)
 {
 	cout<<"Running Linux Build...";
 	GameSettings settings;
 	settings.readSettingsFile("../settings.cfg");
-	IOContext* context = new GlContext( settings.m_scrResX, settings.m_scrResY, settings.m_windowed );
+
+	// --headless runs the game without a window, as fast as possible, with
+	// a fixed 1/60 s time step.
+	//   --frames <n> stops after n frames (default 600, 0 = until quit).
+	//   --press <frame>:<key> presses a key, e.g. --press 60:ENTER.
+	// --no-batching draws every sprite with its own draw call.
+	// --dump-atlas prints the texture atlas occupancy on exit.
+	// --jump-points makes monsters search paths with jump point search.
+	bool headless = false;
+	bool batched = true;
+	bool dumpAtlas = false;
+	int frameLimit = 600;
+	vector<string> keyPresses;
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "--headless")
+			headless = true;
+		else if (arg == "--frames" && i + 1 < argc)
+			frameLimit = atoi(argv[++i]);
+		else if (arg == "--press" && i + 1 < argc)
+			keyPresses.push_back(argv[++i]);
+		else if (arg == "--no-batching")
+			batched = false;
+		else if (arg == "--dump-atlas")
+			dumpAtlas = true;
+		else if (arg == "--jump-points")
+			Tilemap::setDefaultSearchMethod(SEARCH_JUMP_POINTS);
+	}
+
+	IOContext* context = NULL;
+	GlContext* glContext = NULL;
+	NullContext* nullContext = NULL;
+	if (headless)
+	{
+		nullContext = new NullContext( settings.m_scrResX, settings.m_scrResY );
+		nullContext->setFrameLimit(frameLimit);
+		for (unsigned int i = 0; i < keyPresses.size(); i++)
+		{
+			size_t separator = keyPresses[i].find(':');
+			int key = -1;
+			if (separator != string::npos)
+				key = NullContext::keyFromName(keyPresses[i].substr(separator + 1));
+			if (key < 0)
+				cout<<"Ignoring key press "<<keyPresses[i]<<endl;
+			else
+				nullContext->addKeyPress(atoi(keyPresses[i].c_str()), key);
+		}
+		context = nullContext;
+	}
+	else
+	{
+		glContext = new GlContext( settings.m_scrResX, settings.m_scrResY, settings.m_windowed );
+		glContext->setBatchedRendering(batched);
+		context = glContext;
+	}
 
 	context->setWindowPosition( settings.m_scrStartX, settings.m_scrStartY );
 
@@ -107,12 +166,38 @@ int main(int argc, char** argv)
 		return 1;
 	}
 
-	Timer* timer = new LinTimer();
+	Timer* timer = NULL;
+	if (headless)
+		timer = new FixedStepTimer(1.0 / 60.0);
+	else
+		timer = new LinTimer();
 
 	Game* game = new Game(timer, context);
 
+	timespec runStart, runEnd;
+	clock_gettime(CLOCK_MONOTONIC, &runStart);
+
 	game->run();
 
+	clock_gettime(CLOCK_MONOTONIC, &runEnd);
+	double runTime = (runEnd.tv_sec - runStart.tv_sec) + 
+		(runEnd.tv_nsec - runStart.tv_nsec) / 1000000000.0;
+
+	if (glContext && dumpAtlas)
+	{
+		glContext->waitForPendingTextures();
+		glContext->dumpAtlasOccupancy(cout);
+	}
+
+	if (nullContext)
+	{
+		int frames = max(nullContext->getFrameCount(), 1);
+		cout<<endl<<"Headless run: "<<nullContext->getFrameCount()<<" frames ("
+			<<nullContext->getTotalTime()<<" s game time) in "<<runTime<<" s, "
+			<<1000.0 * runTime / frames<<" ms/frame, "
+			<<nullContext->getTotalDrawCalls() / frames<<" draw submissions/frame, "
+			<<nullContext->getSpritesAdded()<<" sprites added"<<endl;
+	}
 
 	delete timer;
 	delete context;
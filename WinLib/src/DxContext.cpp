@@ -441,6 +441,8 @@ int DxContext::update(float p_dt)
 
 int DxContext::beginDraw()
 {
+	m_drawCalls = 0;
+	m_textureBinds = 0;
 	if (!m_resizing)
 	{
 		m_deviceContext->ClearRenderTargetView(m_backBuffer, 
@@ -463,10 +465,14 @@ int DxContext::drawSprite( SpriteInfo* p_spriteInfo )
 			ID3D11ShaderResourceView* texture = NULL;
 			m_textureManager->getTexture(p_spriteInfo->textureIndex, &texture);
 			if(texture != NULL)
+			{
 				m_spriteRenderer->setTexture(texture);
+				m_textureBinds++;
+			}
 		}
 
 		m_spriteRenderer->draw();	// Careful...
+		m_drawCalls++;
 	}
 	return GAME_OK;
 }
@@ -477,7 +483,7 @@ int DxContext::spriteSetUnindexedTexture(SpriteInfo* p_spriteInfo)
 	ID3D11ShaderResourceView* texture = NULL;
 
 	int textureIndex = p_spriteInfo->textureIndex = m_textureManager->getTexture(
-		p_spriteInfo->textureFilePath, &texture);
+		p_spriteInfo->getTexturePath(), &texture);
 
 	if(texture == NULL)
 		return GAME_FAIL;
@@ -579,11 +585,11 @@ LRESULT DxContext::handleWindowMessages(UINT p_message,
 int DxContext::addSprite( SpriteInfo* p_spriteInfo )
 {
 	int textureReadSuccess = GAME_FAIL;
-	bool named = p_spriteInfo->textureFilePath != "";
+	bool named = p_spriteInfo->getTexturePath() != "";
 
 	if( named )
 	{
-		m_textureManager->getTexture(p_spriteInfo->textureFilePath);
+		m_textureManager->getTexture(p_spriteInfo->getTexturePath());
 		spriteSetUnindexedTexture( p_spriteInfo );
 		textureReadSuccess = GAME_OK;
 	}